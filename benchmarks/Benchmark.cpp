@@ -0,0 +1,357 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+// ============================================================================
+// Contador global de reservas de memoria
+// ============================================================================
+// Se reemplaza operator new en todo el ejecutable de benchmarks. Cuenta las
+// reservas de todos los hilos: los benchmarks con hilos de fondo deben
+// evitar reservar memoria en ellos.
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_allocatedBytes{0};
+
+void *countedAlloc(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+// noinline: evita que GCC empareje new con free() (-Wmismatched-new-delete)
+__attribute__((noinline)) void rawFree(void *ptr) { std::free(ptr); }
+} // namespace
+
+void *operator new(std::size_t size) {
+  void *ptr = countedAlloc(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void *operator new[](std::size_t size) {
+  void *ptr = countedAlloc(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return countedAlloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return countedAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept { rawFree(ptr); }
+void operator delete[](void *ptr) noexcept { rawFree(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { rawFree(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { rawFree(ptr); }
+
+namespace OSBot {
+namespace Bench {
+
+// ============================================================================
+// State
+// ============================================================================
+
+State::State(uint64_t maxIterations, std::vector<int64_t> args)
+    : maxIterations_(maxIterations), remaining_(maxIterations),
+      args_(std::move(args)) {}
+
+bool State::keepRunning() {
+  if (!started_) {
+    started_ = true;
+    startTimer();
+  }
+  if (remaining_ > 0) {
+    --remaining_;
+    return true;
+  }
+  stopTimer();
+  return false;
+}
+
+void State::pauseTiming() { stopTimer(); }
+
+void State::resumeTiming() { startTimer(); }
+
+void State::startTimer() {
+  allocStart_ = g_allocations.load(std::memory_order_relaxed);
+  allocBytesStart_ = g_allocatedBytes.load(std::memory_order_relaxed);
+  start_ = std::chrono::steady_clock::now();
+}
+
+void State::stopTimer() {
+  auto end = std::chrono::steady_clock::now();
+  elapsedNs_ += static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_)
+          .count());
+  allocations_ += g_allocations.load(std::memory_order_relaxed) - allocStart_;
+  allocatedBytes_ +=
+      g_allocatedBytes.load(std::memory_order_relaxed) - allocBytesStart_;
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+Benchmark::Benchmark(std::string name, BenchmarkFunction function)
+    : name_(std::move(name)), function_(function) {}
+
+Benchmark *Benchmark::args(const std::vector<int64_t> &values) {
+  instances_.push_back(values);
+  return this;
+}
+
+Benchmark *
+Benchmark::argsProduct(const std::vector<std::vector<int64_t>> &lists) {
+  std::vector<std::vector<int64_t>> product = {{}};
+  for (const auto &list : lists) {
+    std::vector<std::vector<int64_t>> next;
+    for (const auto &prefix : product) {
+      for (int64_t value : list) {
+        next.push_back(prefix);
+        next.back().push_back(value);
+      }
+    }
+    product = std::move(next);
+  }
+  instances_.insert(instances_.end(), product.begin(), product.end());
+  return this;
+}
+
+Benchmark *Benchmark::argNames(const std::vector<std::string> &names) {
+  argNames_ = names;
+  return this;
+}
+
+std::string Benchmark::instanceName(const std::vector<int64_t> &values) const {
+  std::string result = name_;
+  for (size_t i = 0; i < values.size(); ++i) {
+    result += "/";
+    if (i < argNames_.size())
+      result += argNames_[i] + ":";
+    result += std::to_string(values[i]);
+  }
+  return result;
+}
+
+namespace {
+
+std::vector<std::unique_ptr<Benchmark>> &registry() {
+  static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+  return benchmarks;
+}
+
+struct Result {
+  std::string name;
+  uint64_t iterations;
+  double nsPerOp;
+  double allocsPerOp;
+  double bytesAllocatedPerOp;
+  double itemsPerSecond;
+  double bytesPerSecond;
+  std::string label;
+};
+
+/**
+ * @brief streambuf que descarta todo (silencia los logs de los subsistemas)
+ */
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override { return c; }
+  std::streamsize xsputn(const char *, std::streamsize n) override {
+    return n;
+  }
+};
+
+State runOnce(const Benchmark &benchmark, const std::vector<int64_t> &args,
+              uint64_t iterations) {
+  static NullBuffer nullBuffer;
+  State state(iterations, args);
+
+  std::streambuf *previous = std::cout.rdbuf(&nullBuffer);
+  benchmark.function()(state);
+  std::cout.rdbuf(previous);
+  return state;
+}
+
+Result runInstance(const Benchmark &benchmark,
+                   const std::vector<int64_t> &args, double minTime) {
+  constexpr uint64_t MAX_ITERATIONS = 1000000000;
+
+  // Calibración: crecer el número de iteraciones hasta superar minTime
+  uint64_t iterations = 1;
+  State state = runOnce(benchmark, args, iterations);
+  while (state.elapsedSeconds() < minTime && iterations < MAX_ITERATIONS) {
+    double elapsed = std::max(state.elapsedSeconds(), 1e-9);
+    double multiplier = minTime * 1.4 / elapsed;
+    // Con mediciones muy cortas la estimación no es fiable: limitar a 10x
+    if (elapsed / minTime <= 0.1)
+      multiplier = std::min(multiplier, 10.0);
+    uint64_t next = static_cast<uint64_t>(iterations * multiplier);
+    iterations = std::min(std::max(next, iterations + 1), MAX_ITERATIONS);
+    state = runOnce(benchmark, args, iterations);
+  }
+
+  Result result;
+  result.name = benchmark.instanceName(args);
+  result.iterations = iterations;
+  double seconds = state.elapsedSeconds();
+  double ops = static_cast<double>(iterations);
+  result.nsPerOp = seconds * 1e9 / ops;
+  result.allocsPerOp = state.allocations() / ops;
+  result.bytesAllocatedPerOp = state.allocatedBytes() / ops;
+  result.itemsPerSecond =
+      seconds > 0 ? state.itemsProcessed() / seconds : 0.0;
+  result.bytesPerSecond =
+      seconds > 0 ? state.bytesProcessed() / seconds : 0.0;
+  result.label = state.label();
+  return result;
+}
+
+std::string humanRate(double perSecond, const char *unit) {
+  const char *prefixes[] = {"", "k", "M", "G"};
+  int index = 0;
+  while (perSecond >= 1000.0 && index < 3) {
+    perSecond /= 1000.0;
+    index++;
+  }
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(1) << perSecond << " "
+      << prefixes[index] << unit << "/s";
+  return oss.str();
+}
+
+void printHeader() {
+  std::cout << std::left << std::setw(56) << "Benchmark" << std::right
+            << std::setw(14) << "ns/op" << std::setw(12) << "iters"
+            << std::setw(12) << "allocs/op" << std::setw(16) << "throughput"
+            << "  label\n";
+  std::cout << std::string(116, '-') << "\n";
+}
+
+void printResult(const Result &r) {
+  std::string throughput;
+  if (r.bytesPerSecond > 0)
+    throughput = humanRate(r.bytesPerSecond, "B");
+  else if (r.itemsPerSecond > 0)
+    throughput = humanRate(r.itemsPerSecond, "items");
+
+  std::cout << std::left << std::setw(56) << r.name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(14) << r.nsPerOp
+            << std::setw(12) << r.iterations << std::setprecision(2)
+            << std::setw(12) << r.allocsPerOp << std::setw(16) << throughput
+            << "  " << r.label << std::defaultfloat << std::endl;
+}
+
+bool writeJSON(const std::string &filename, const std::vector<Result> &results,
+               double minTime) {
+  std::ofstream ofs(filename);
+  if (!ofs.is_open()) {
+    std::cerr << "[Bench] Error: No se pudo crear el archivo: " << filename
+              << std::endl;
+    return false;
+  }
+
+  ofs << "{\"context\":{\"min_time_s\":" << minTime
+      << ",\"hardware_threads\":" << std::thread::hardware_concurrency()
+      << "},\"benchmarks\":[";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    if (i > 0)
+      ofs << ",";
+    ofs << "{\"name\":\"" << r.name << "\"";
+    ofs << ",\"iterations\":" << r.iterations;
+    ofs << ",\"ns_per_op\":" << r.nsPerOp;
+    ofs << ",\"allocs_per_op\":" << r.allocsPerOp;
+    ofs << ",\"bytes_allocated_per_op\":" << r.bytesAllocatedPerOp;
+    ofs << ",\"items_per_second\":" << r.itemsPerSecond;
+    ofs << ",\"bytes_per_second\":" << r.bytesPerSecond;
+    ofs << ",\"label\":\"" << r.label << "\"}";
+  }
+  ofs << "]}\n";
+  return true;
+}
+
+} // namespace
+
+Benchmark *registerBenchmark(const char *name, BenchmarkFunction function) {
+  registry().push_back(std::make_unique<Benchmark>(name, function));
+  return registry().back().get();
+}
+
+int runAll(int argc, char **argv) {
+  std::string filter;
+  std::string jsonFile;
+  double minTime = 0.2;
+  bool listOnly = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg.rfind("--filter=", 0) == 0) {
+      filter = arg.substr(9);
+    } else if (arg.rfind("--min-time=", 0) == 0) {
+      minTime = std::atof(arg.c_str() + 11);
+    } else if (arg.rfind("--json=", 0) == 0) {
+      jsonFile = arg.substr(7);
+    } else if (arg == "--list") {
+      listOnly = true;
+    } else {
+      std::cerr << "Uso: " << argv[0]
+                << " [--filter=<regex>] [--min-time=<s>] [--json=<archivo>]"
+                   " [--list]"
+                << std::endl;
+      return 1;
+    }
+  }
+
+  std::regex pattern;
+  try {
+    pattern = std::regex(filter.empty() ? ".*" : filter);
+  } catch (const std::regex_error &) {
+    std::cerr << "[Bench] Error: filtro inválido: " << filter << std::endl;
+    return 1;
+  }
+
+  std::vector<Result> results;
+  if (!listOnly)
+    printHeader();
+
+  for (const auto &benchmark : registry()) {
+    auto instances = benchmark->instances();
+    if (instances.empty())
+      instances.push_back({});
+
+    for (const auto &args : instances) {
+      std::string name = benchmark->instanceName(args);
+      if (!std::regex_search(name, pattern))
+        continue;
+      if (listOnly) {
+        std::cout << name << "\n";
+        continue;
+      }
+      results.push_back(runInstance(*benchmark, args, minTime));
+      printResult(results.back());
+    }
+  }
+
+  if (!jsonFile.empty() && !writeJSON(jsonFile, results, minTime))
+    return 1;
+  return 0;
+}
+
+} // namespace Bench
+} // namespace OSBot
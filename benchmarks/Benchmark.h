@@ -0,0 +1,162 @@
+#ifndef RIDEBOT_BENCHMARK_H
+#define RIDEBOT_BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OSBot {
+namespace Bench {
+
+/**
+ * @class State
+ * @brief Estado de una ejecución de benchmark (estilo Google Benchmark)
+ *
+ * Uso:
+ *   void BM_Algo(Bench::State &state) {
+ *     // preparación (no se mide)
+ *     while (state.keepRunning()) {
+ *       // código medido
+ *     }
+ *     state.setItemsProcessed(state.iterations());
+ *   }
+ *
+ * Solo se mide el bucle: el reloj y el contador de reservas de memoria
+ * arrancan en la primera llamada a keepRunning() y paran en la última.
+ */
+class State {
+public:
+  State(uint64_t maxIterations, std::vector<int64_t> args);
+
+  /**
+   * @brief Condición del bucle medido
+   * @return false cuando se completaron las iteraciones pedidas
+   */
+  bool keepRunning();
+
+  /**
+   * @brief Parámetro i-ésimo de la instancia (p. ej. tamaño del mapa)
+   */
+  int64_t range(size_t index) const { return args_.at(index); }
+
+  uint64_t iterations() const { return maxIterations_; }
+
+  /**
+   * @brief Excluye de la medición un tramo dentro del bucle
+   * NOTA: Cada pausa cuesta dos lecturas del reloj: usar con moderación
+   */
+  void pauseTiming();
+  void resumeTiming();
+
+  void setItemsProcessed(int64_t items) { itemsProcessed_ = items; }
+  void setBytesProcessed(int64_t bytes) { bytesProcessed_ = bytes; }
+  void setLabel(const std::string &label) { label_ = label; }
+
+  // Resultados (los lee el runner)
+  double elapsedSeconds() const { return elapsedNs_ / 1e9; }
+  uint64_t allocations() const { return allocations_; }
+  uint64_t allocatedBytes() const { return allocatedBytes_; }
+  int64_t itemsProcessed() const { return itemsProcessed_; }
+  int64_t bytesProcessed() const { return bytesProcessed_; }
+  const std::string &label() const { return label_; }
+
+private:
+  uint64_t maxIterations_;
+  uint64_t remaining_;
+  std::vector<int64_t> args_;
+  bool started_ = false;
+
+  std::chrono::steady_clock::time_point start_;
+  uint64_t elapsedNs_ = 0;
+  uint64_t allocStart_ = 0;
+  uint64_t allocBytesStart_ = 0;
+  uint64_t allocations_ = 0;
+  uint64_t allocatedBytes_ = 0;
+
+  int64_t itemsProcessed_ = 0;
+  int64_t bytesProcessed_ = 0;
+  std::string label_;
+
+  void startTimer();
+  void stopTimer();
+};
+
+using BenchmarkFunction = void (*)(State &);
+
+/**
+ * @class Benchmark
+ * @brief Benchmark registrado con sus combinaciones de parámetros
+ */
+class Benchmark {
+public:
+  Benchmark(std::string name, BenchmarkFunction function);
+
+  /**
+   * @brief Añade una combinación de parámetros
+   */
+  Benchmark *args(const std::vector<int64_t> &values);
+
+  /**
+   * @brief Añade el producto cartesiano de las listas de valores
+   */
+  Benchmark *argsProduct(const std::vector<std::vector<int64_t>> &lists);
+
+  /**
+   * @brief Nombres de los parámetros para el informe (size, density...)
+   */
+  Benchmark *argNames(const std::vector<std::string> &names);
+
+  /**
+   * @brief Nombre completo de una instancia: nombre/param:valor/...
+   */
+  std::string instanceName(const std::vector<int64_t> &values) const;
+
+  const std::string &name() const { return name_; }
+  BenchmarkFunction function() const { return function_; }
+  const std::vector<std::vector<int64_t>> &instances() const {
+    return instances_;
+  }
+
+private:
+  std::string name_;
+  BenchmarkFunction function_;
+  std::vector<std::vector<int64_t>> instances_;
+  std::vector<std::string> argNames_;
+};
+
+/**
+ * @brief Registra un benchmark (lo usa la macro OSBOT_BENCHMARK)
+ */
+Benchmark *registerBenchmark(const char *name, BenchmarkFunction function);
+
+/**
+ * @brief Ejecuta los benchmarks registrados
+ * Opciones: --filter=<regex> --min-time=<s> --json=<archivo> --list
+ * @return Código de salida del proceso
+ */
+int runAll(int argc, char **argv);
+
+/**
+ * @brief Impide que el compilador elimine un cálculo cuyo resultado no se usa
+ */
+template <typename T> inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace Bench
+} // namespace OSBot
+
+#define OSBOT_BENCH_CONCAT_(a, b) a##b
+#define OSBOT_BENCH_CONCAT(a, b) OSBOT_BENCH_CONCAT_(a, b)
+
+/**
+ * @brief Registra una función como benchmark durante la inicialización
+ * estática. Admite encadenar ->args(...), ->argsProduct(...), ->argNames(...)
+ */
+#define OSBOT_BENCHMARK(function)                                              \
+  static ::OSBot::Bench::Benchmark *OSBOT_BENCH_CONCAT(osbot_bench_,           \
+                                                       __LINE__) =             \
+      ::OSBot::Bench::registerBenchmark(#function, function)
+
+#endif // RIDEBOT_BENCHMARK_H
@@ -0,0 +1,737 @@
+/**
+ * @file bench_main.cpp
+ * @brief Microbenchmarks de los caminos calientes de OS-Bot
+ *
+ * Ejecutar: ./os-bot-bench [--filter=<regex>] [--min-time=<s>] [--json=<f>]
+ * Los logs de los subsistemas se silencian durante cada benchmark y las
+ * métricas internas (Metrics/Tracer) se desactivan para no medirlas.
+ */
+
+#include "Benchmark.h"
+#include "application/AStar.h"
+#include "application/AssignmentSolver.h"
+#include "application/DistanceFieldCache.h"
+#include "application/Kernel.h"
+#include "application/RouteOptimizer.h"
+#include "application/TaskScheduler.h"
+#include "application/WorldSnapshot.h"
+#include "domain/Environment.h"
+#include "domain/Random.h"
+#include "domain/Robot.h"
+#include "infrastructure/Gzip.h"
+#include "infrastructure/LIDARSensor.h"
+#include "infrastructure/Metrics.h"
+#include "infrastructure/Storage.h"
+#include "infrastructure/Tracer.h"
+#include "infrastructure/WebServer.h"
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OSBot {
+
+namespace {
+
+constexpr uint64_t BENCH_SEED = 42;
+
+/**
+ * @brief Celda libre más cercana (Manhattan) a la posición pedida
+ */
+Point nearestFree(const Environment &env, Point target) {
+  Point best = target;
+  int bestDistance = -1;
+  for (int y = 1; y < env.getHeight() - 1; ++y) {
+    for (int x = 1; x < env.getWidth() - 1; ++x) {
+      Point candidate(x, y);
+      if (!env.isPositionFree(candidate))
+        continue;
+      int distance = std::abs(x - target.x) + std::abs(y - target.y);
+      if (bestDistance < 0 || distance < bestDistance) {
+        best = candidate;
+        bestDistance = distance;
+      }
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Entorno cuadrado con un porcentaje de obstáculos (determinista)
+ */
+std::unique_ptr<Environment> makeEnvironment(int size, int density) {
+  Random::setMasterSeed(BENCH_SEED);
+  auto env = std::make_unique<Environment>(size, size);
+  env->generateRandomObstacles(density);
+  return env;
+}
+
+std::string tempFile(const char *name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+// ============================================================================
+// AStar::find_path - tamaño del mapa x densidad de obstáculos x distancia
+// ============================================================================
+
+void BM_AStarFindPath(Bench::State &state) {
+  int size = static_cast<int>(state.range(0));
+  int density = static_cast<int>(state.range(1));
+  int distancePct = static_cast<int>(state.range(2));
+
+  auto env = makeEnvironment(size, density);
+
+  // Inicio en la esquina; destino a lo largo de la diagonal
+  Point start = nearestFree(*env, Point(1, 1));
+  int reach = 1 + (size - 3) * distancePct / 100;
+  Point end = nearestFree(*env, Point(reach, reach));
+
+  size_t pathLength = 0;
+  while (state.keepRunning()) {
+    Route route = AStar::find_path(start, end, *env);
+    pathLength = route.size();
+    Bench::doNotOptimize(route);
+  }
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.setLabel(pathLength > 0 ? "path=" + std::to_string(pathLength)
+                                : "sin ruta");
+}
+OSBOT_BENCHMARK(BM_AStarFindPath)
+    ->argNames({"size", "density", "dist"})
+    ->argsProduct({{32, 64, 128}, {0, 10, 25}, {25, 100}});
+
+// ============================================================================
+// DistanceField - un BFS desde un destino sobre todo el mapa
+// (costear N robots contra una tarea = 1 campo + N lecturas)
+// ============================================================================
+
+void BM_DistanceFieldBuild(Bench::State &state) {
+  int size = static_cast<int>(state.range(0));
+  auto env = makeEnvironment(size, static_cast<int>(state.range(1)));
+  Point target = nearestFree(*env, Point(size / 2, size / 2));
+  Point corner = nearestFree(*env, Point(1, 1));
+
+  std::vector<uint8_t> mask;
+  uint64_t version = env->copyObstacleMask(mask);
+
+  int32_t distance = 0;
+  while (state.keepRunning()) {
+    DistanceField field(target, version, size, size, mask);
+    distance = field.distanceFrom(corner);
+    Bench::doNotOptimize(field);
+  }
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * size *
+                          size);
+  state.setLabel("corner=" + std::to_string(distance));
+}
+OSBOT_BENCHMARK(BM_DistanceFieldBuild)
+    ->argNames({"size", "density"})
+    ->argsProduct({{64, 128, 500}, {0, 25}});
+
+// ============================================================================
+// RouteOptimizer - reordenar N paradas, BFS incluidos (<= 12 es Held-Karp,
+// por encima vecino más cercano + 2-opt/Or-opt)
+// ============================================================================
+
+void BM_RouteOptimize(Bench::State &state) {
+  auto env = makeEnvironment(64, 10);
+  RouteOptimizer optimizer(*env);
+
+  Xoshiro256 rng(BENCH_SEED);
+  std::vector<Point> stops;
+  for (int64_t i = 0; i < state.range(0); ++i)
+    stops.push_back(
+        nearestFree(*env, Point(rng.uniformInt(1, 62), rng.uniformInt(1, 62))));
+
+  RouteOptions options;
+  options.timeBudgetMs = 0.0; // Sin tope de reloj: la búsqueda completa
+  RouteResult result;
+  while (state.keepRunning()) {
+    result = optimizer.optimize(stops, options);
+    Bench::doNotOptimize(result);
+  }
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.setLabel("cells=" + std::to_string(result.originalCells) + "->" +
+                 std::to_string(result.optimizedCells));
+}
+OSBOT_BENCHMARK(BM_RouteOptimize)
+    ->argNames({"stops"})
+    ->args({10})
+    ->args({40});
+
+// ============================================================================
+// LIDARSensor::scan - 360 raycasts por operación
+// ============================================================================
+
+void BM_LidarScan(Bench::State &state) {
+  int size = static_cast<int>(state.range(0));
+  int density = static_cast<int>(state.range(1));
+
+  auto env = makeEnvironment(size, density);
+  LIDARSensor lidar(*env);
+  Point center = nearestFree(*env, Point(size / 2, size / 2));
+
+  while (state.keepRunning()) {
+    LidarData data = lidar.scan(center);
+    Bench::doNotOptimize(data);
+  }
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * 360);
+}
+OSBOT_BENCHMARK(BM_LidarScan)
+    ->argNames({"size", "density"})
+    ->argsProduct({{32, 128}, {0, 25}});
+
+// ============================================================================
+// Environment::isPositionFree - lectores concurrentes sobre mapMutex_
+// ============================================================================
+
+void BM_IsPositionFreeContended(Bench::State &state) {
+  int threads = static_cast<int>(state.range(0));
+  constexpr int SIZE = 64;
+
+  auto env = makeEnvironment(SIZE, 10);
+
+  // threads-1 hilos de fondo compiten por el lock mientras se mide el hilo
+  // principal (sin reservas de memoria en los hilos de fondo)
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> background;
+  for (int t = 1; t < threads; ++t) {
+    background.emplace_back([&env, &stop, t]() {
+      int i = t * 7919;
+      while (!stop.load(std::memory_order_relaxed)) {
+        Point p(1 + i % (SIZE - 2), 1 + (i / SIZE) % (SIZE - 2));
+        Bench::doNotOptimize(env->isPositionFree(p));
+        ++i;
+      }
+    });
+  }
+
+  int i = 0;
+  while (state.keepRunning()) {
+    Point p(1 + i % (SIZE - 2), 1 + (i / SIZE) % (SIZE - 2));
+    Bench::doNotOptimize(env->isPositionFree(p));
+    ++i;
+  }
+
+  stop = true;
+  for (auto &thread : background)
+    thread.join();
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+OSBOT_BENCHMARK(BM_IsPositionFreeContended)
+    ->argNames({"threads"})
+    ->args({1})
+    ->args({2})
+    ->args({4})
+    ->args({8});
+
+// ============================================================================
+// /api/state - tamaño del grid x número de robots
+// ============================================================================
+
+// Coste por tick: capturar la foto y serializarla una vez
+
+void BM_GetStateJSON(Bench::State &state) {
+  SimulationConfig config;
+  config.headless = true;
+  config.seed = BENCH_SEED;
+  config.gridWidth = static_cast<int>(state.range(0));
+  config.gridHeight = static_cast<int>(state.range(0));
+  config.profiling = false;
+
+  Kernel kernel(config);
+  kernel.initialize();
+  kernel.spawnRobots(static_cast<int>(state.range(1)));
+
+  size_t bytes = 0;
+  while (state.keepRunning()) {
+    auto snapshot = kernel.publishSnapshot();
+    bytes = snapshot->stateJSON().size();
+    Bench::doNotOptimize(snapshot);
+  }
+
+  state.setBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+  state.setLabel("bytes=" + std::to_string(bytes));
+}
+OSBOT_BENCHMARK(BM_GetStateJSON)
+    ->argNames({"grid", "robots"})
+    ->argsProduct({{30, 100, 500}, {1, 50, 1000}});
+
+// Peticiones dentro del mismo tick: foto vigente + JSON ya memoizado
+void BM_CachedStateJSON(Bench::State &state) {
+  SimulationConfig config;
+  config.headless = true;
+  config.seed = BENCH_SEED;
+  config.gridWidth = static_cast<int>(state.range(0));
+  config.gridHeight = static_cast<int>(state.range(0));
+  config.profiling = false;
+
+  Kernel kernel(config);
+  kernel.initialize();
+  kernel.spawnRobots(static_cast<int>(state.range(1)));
+  kernel.publishSnapshot()->stateJSON();
+
+  size_t bytes = 0;
+  while (state.keepRunning()) {
+    auto snapshot = kernel.getSnapshot();
+    bytes = snapshot->stateJSON().size();
+    Bench::doNotOptimize(snapshot);
+  }
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.setLabel("bytes=" + std::to_string(bytes));
+}
+OSBOT_BENCHMARK(BM_CachedStateJSON)
+    ->argNames({"grid", "robots"})
+    ->args({500, 1000});
+
+// Camino del servidor: buffer reutilizado entre peticiones (sin reservas)
+void BM_WriteStateJSON(Bench::State &state) {
+  SimulationConfig config;
+  config.headless = true;
+  config.seed = BENCH_SEED;
+  config.gridWidth = static_cast<int>(state.range(0));
+  config.gridHeight = static_cast<int>(state.range(0));
+  config.profiling = false;
+
+  Kernel kernel(config);
+  kernel.initialize();
+  kernel.spawnRobots(static_cast<int>(state.range(1)));
+  WebServer server(kernel);
+
+  std::string buffer;
+  server.writeStateJSON(buffer); // Calentar el buffer y la máscara
+  while (state.keepRunning()) {
+    server.writeStateJSON(buffer);
+    Bench::doNotOptimize(buffer);
+  }
+
+  state.setBytesProcessed(
+      static_cast<int64_t>(state.iterations() * buffer.size()));
+  state.setLabel("bytes=" + std::to_string(buffer.size()));
+}
+OSBOT_BENCHMARK(BM_WriteStateJSON)
+    ->argNames({"grid", "robots"})
+    ->args({500, 1000});
+
+// Compresión de /api/state (una vez por versión del mundo) según el nivel
+void BM_GzipStateJSON(Bench::State &state) {
+  SimulationConfig config;
+  config.headless = true;
+  config.seed = BENCH_SEED;
+  config.gridWidth = 500;
+  config.gridHeight = 500;
+  config.profiling = false;
+
+  Kernel kernel(config);
+  kernel.initialize();
+  kernel.spawnRobots(1000);
+  const std::string &json = kernel.getSnapshot()->stateJSON();
+
+  std::string compressed;
+  while (state.keepRunning()) {
+    Gzip::compress(json, compressed, static_cast<int>(state.range(0)));
+    Bench::doNotOptimize(compressed);
+  }
+
+  state.setBytesProcessed(
+      static_cast<int64_t>(state.iterations() * json.size()));
+  state.setLabel(Gzip::isAvailable()
+                     ? "bytes=" + std::to_string(json.size()) + "->" +
+                           std::to_string(compressed.size())
+                     : std::string("sin zlib"));
+}
+OSBOT_BENCHMARK(BM_GzipStateJSON)
+    ->argNames({"level"})
+    ->args({1})
+    ->args({6})
+    ->args({9});
+
+// /api/state.bin: frame binario (arg since: 0 = grid completo, 1 = delta)
+void BM_WriteStateFrame(Bench::State &state) {
+  SimulationConfig config;
+  config.headless = true;
+  config.seed = BENCH_SEED;
+  config.gridWidth = static_cast<int>(state.range(0));
+  config.gridHeight = static_cast<int>(state.range(0));
+  config.profiling = false;
+
+  Kernel kernel(config);
+  kernel.initialize();
+  kernel.spawnRobots(static_cast<int>(state.range(1)));
+  WebServer server(kernel);
+
+  uint64_t since =
+      state.range(2) ? kernel.getEnvironment().getMapVersion() : 0;
+  std::string buffer;
+  uint64_t epoch = WorldSnapshot::bootEpoch();
+  server.writeStateFrame(buffer, epoch, since); // Publica el bitmap de la versión
+  while (state.keepRunning()) {
+    server.writeStateFrame(buffer, epoch, since);
+    Bench::doNotOptimize(buffer);
+  }
+
+  state.setBytesProcessed(
+      static_cast<int64_t>(state.iterations() * buffer.size()));
+  state.setLabel("bytes=" + std::to_string(buffer.size()));
+}
+OSBOT_BENCHMARK(BM_WriteStateFrame)
+    ->argNames({"grid", "robots", "delta"})
+    ->argsProduct({{100, 500}, {50, 1000}, {0, 1}});
+
+// ============================================================================
+// AssignmentSolver - robots x tareas (costos Manhattan en un grid 500x500)
+// ============================================================================
+
+void BM_AssignmentSolve(Bench::State &state) {
+  auto robots = static_cast<size_t>(state.range(0));
+  auto tasks = static_cast<size_t>(state.range(1));
+  bool auction = state.range(2) != 0;
+
+  Xoshiro256 rng(BENCH_SEED);
+  std::vector<Point> from(robots), to(tasks);
+  for (Point &p : from)
+    p = Point(rng.uniformInt(1, 498), rng.uniformInt(1, 498));
+  for (Point &p : to)
+    p = Point(rng.uniformInt(1, 498), rng.uniformInt(1, 498));
+
+  std::vector<double> cost(robots * tasks);
+  for (size_t r = 0; r < robots; ++r) {
+    for (size_t t = 0; t < tasks; ++t)
+      cost[r * tasks + t] = std::abs(from[r].x - to[t].x) +
+                            std::abs(from[r].y - to[t].y);
+  }
+
+  double total = 0.0;
+  while (state.keepRunning()) {
+    AssignmentResult result =
+        auction ? AssignmentSolver::solveAuction(cost, robots, tasks)
+                : AssignmentSolver::solveHungarian(cost, robots, tasks);
+    total = result.totalCost;
+    Bench::doNotOptimize(result);
+  }
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.setLabel("cost=" + std::to_string(static_cast<long>(total)));
+}
+OSBOT_BENCHMARK(BM_AssignmentSolve)
+    ->argNames({"robots", "tasks", "auction"})
+    ->argsProduct({{32, 512}, {32, 300, 512}, {0, 1}});
+
+// ============================================================================
+// TaskManager::scheduleNextTasks - asignar una tarea con N robots libres
+// ============================================================================
+
+void BM_ScheduleOneTask(Bench::State &state) {
+  SimulationConfig config;
+  config.headless = true;
+  config.seed = BENCH_SEED;
+  config.gridWidth = 200;
+  config.gridHeight = 200;
+  config.profiling = false;
+
+  Kernel kernel(config);
+  kernel.initialize();
+  kernel.spawnRobots(static_cast<int>(state.range(0)));
+  kernel.start();
+  TaskManager &tasks = kernel.getTaskManager();
+  std::vector<Point> waypoints = {Point(100, 100), Point(150, 150)};
+
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    int taskId = tasks.createTask(waypoints);
+    state.resumeTiming();
+
+    tasks.scheduleNextTasks();
+
+    // Cancelar devuelve el robot a la flota libre para la siguiente vuelta
+    state.pauseTiming();
+    tasks.cancelTask(taskId);
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+  kernel.shutdown();
+}
+OSBOT_BENCHMARK(BM_ScheduleOneTask)
+    ->argNames({"robots"})
+    ->args({100})
+    ->args({1000})
+    ->args({10000});
+
+// ============================================================================
+// TaskManager::cancelTask / setTaskPriority - cola de N tareas pendientes
+// ============================================================================
+
+void BM_PendingQueueUpdate(Bench::State &state) {
+  SimulationConfig config;
+  config.headless = true;
+  config.seed = BENCH_SEED;
+  config.profiling = false;
+
+  Kernel kernel(config);
+  kernel.initialize();
+  TaskManager &tasks = kernel.getTaskManager();
+  std::vector<Point> waypoints = {Point(10, 10), Point(20, 20)};
+
+  // Sin robots: todas las tareas quedan pendientes
+  std::vector<int> ids;
+  for (int64_t i = 0; i < state.range(0); ++i)
+    ids.push_back(tasks.createTask(waypoints, TaskPriority::NORMAL));
+
+  Xoshiro256 rng(BENCH_SEED);
+  while (state.keepRunning()) {
+    size_t slot = static_cast<size_t>(
+        rng.uniformInt(0, static_cast<int>(ids.size()) - 1));
+    tasks.setTaskPriority(ids[slot], TaskPriority::URGENT);
+    tasks.cancelTask(ids[slot]);
+
+    state.pauseTiming();
+    ids[slot] = tasks.createTask(waypoints, TaskPriority::NORMAL);
+    state.resumeTiming();
+  }
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+  kernel.shutdown();
+}
+OSBOT_BENCHMARK(BM_PendingQueueUpdate)
+    ->argNames({"pending"})
+    ->args({1000})
+    ->args({100000});
+
+// ============================================================================
+// TaskManager - consultas de estadísticas con N tareas en el historial
+// ============================================================================
+
+void BM_TaskStatsQuery(Bench::State &state) {
+  SimulationConfig config;
+  config.headless = true;
+  config.seed = BENCH_SEED;
+  config.profiling = false;
+
+  Kernel kernel(config);
+  kernel.initialize();
+  TaskManager &tasks = kernel.getTaskManager();
+  std::vector<Point> waypoints = {Point(10, 10)};
+  for (int64_t i = 0; i < state.range(0); ++i)
+    tasks.cancelTask(tasks.createTask(waypoints));
+
+  while (state.keepRunning()) {
+    Bench::doNotOptimize(tasks.getActiveTaskCount());
+    Bench::doNotOptimize(tasks.getCompletedTaskCount());
+    Bench::doNotOptimize(tasks.getAverageCompletionTime());
+    Bench::doNotOptimize(tasks.getSuccessRate());
+  }
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+  kernel.shutdown();
+}
+OSBOT_BENCHMARK(BM_TaskStatsQuery)
+    ->argNames({"tasks"})
+    ->args({1000})
+    ->args({100000});
+
+// ============================================================================
+// TaskManager::update - 100 tareas en curso, N pendientes y N terminadas
+// ============================================================================
+
+void BM_TaskManagerUpdate(Bench::State &state) {
+  SimulationConfig config;
+  config.headless = true;
+  config.seed = BENCH_SEED;
+  config.profiling = false;
+
+  Kernel kernel(config);
+  kernel.initialize();
+  kernel.spawnRobots(100);
+  kernel.start();
+  TaskManager &tasks = kernel.getTaskManager();
+  std::vector<Point> waypoints = {Point(10, 10)};
+
+  for (int64_t i = 0; i < state.range(0); ++i)
+    tasks.cancelTask(tasks.createTask(waypoints));
+  for (int i = 0; i < 100; ++i)
+    tasks.createTask(waypoints);
+  tasks.scheduleNextTasks();
+  // Flota ocupada: el resto queda en cola
+  for (int64_t i = 0; i < state.range(0); ++i)
+    tasks.createTask(waypoints);
+
+  // Sin step(): los robots no se mueven y las tareas siguen en curso
+  while (state.keepRunning())
+    tasks.update();
+
+  state.setLabel("active=" + std::to_string(tasks.getActiveTaskCount()));
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+  kernel.shutdown();
+}
+OSBOT_BENCHMARK(BM_TaskManagerUpdate)
+    ->argNames({"tasks"})
+    ->args({0})
+    ->args({100000});
+
+// ============================================================================
+// Kernel::step - un tick headless con y sin profiler de fases
+// (profiling:1 - profiling:0 = costo de ScopedTimer/PhaseTimer por tick;
+// BM_TickProfiler lo aísla del ruido)
+// ============================================================================
+
+void BM_KernelStep(Bench::State &state) {
+  SimulationConfig config;
+  config.headless = true;
+  config.seed = BENCH_SEED;
+  config.profiling = state.range(1) != 0;
+
+  Kernel kernel(config);
+  kernel.initialize();
+  kernel.spawnRobots(static_cast<int>(state.range(0)));
+  kernel.start();
+
+  while (state.keepRunning())
+    kernel.step();
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+  kernel.shutdown();
+  Metrics::setEnabled(false); // El Kernel lo activó según 'profiling'
+}
+OSBOT_BENCHMARK(BM_KernelStep)
+    ->argNames({"robots", "profiling"})
+    ->argsProduct({{20, 100}, {0, 1}});
+
+// Costo fijo del profiler por tick, aislado del ruido del tick: 4 fases con
+// PhaseTimer muestreado y los 3 timedLock (muestreados) sin contención de
+// RobotManager::update y TaskManager (every:0 = profiler apagado, solo los
+// locks; every:1 = medir todos los ticks)
+void BM_TickProfiler(Bench::State &state) {
+  LatencyHistogram &phase = Metrics::instance().histogram("bench.tick_phase");
+  LatencyHistogram &lockWait = Metrics::instance().histogram("bench.lock_wait");
+  std::mutex mutex;
+  auto every = static_cast<uint64_t>(state.range(0));
+  Metrics::setEnabled(every != 0);
+
+  uint64_t tick = 0;
+  while (state.keepRunning()) {
+    // every es potencia de 2, como PROFILE_EVERY_TICKS: máscara, no división
+    PhaseTimer phases(every != 0 && (tick++ & (every - 1)) == 0);
+    for (int i = 0; i < 3; ++i) {
+      auto lock = timedLock(mutex, lockWait);
+      phases.lap(phase);
+    }
+    phases.lap(phase);
+    phases.finish(phase);
+  }
+
+  state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+  Metrics::setEnabled(false);
+}
+OSBOT_BENCHMARK(BM_TickProfiler)
+    ->argNames({"every"})
+    ->args({0})
+    ->args({1})
+    ->args({static_cast<int64_t>(Kernel::PROFILE_EVERY_TICKS)});
+
+// ============================================================================
+// Storage::save_state / load_state - robots x tareas
+// ============================================================================
+
+namespace {
+
+struct StorageFixture {
+  std::unique_ptr<Environment> env;
+  std::vector<std::unique_ptr<Robot>> robots;
+  TaskScheduler scheduler;
+
+  StorageFixture(int robotCount, int taskCount)
+      : env(makeEnvironment(64, 10)) {
+    for (int i = 0; i < robotCount; ++i) {
+      auto robot = std::make_unique<Robot>(*env);
+      robot->setId(i + 1);
+      robot->setPosition(env->randomFreePosition());
+      robots.push_back(std::move(robot));
+    }
+    for (int i = 0; i < taskCount; ++i) {
+      std::vector<Point> waypoints = {env->randomFreePosition(),
+                                      env->randomFreePosition()};
+      scheduler.add_task(Task(i + 1, waypoints));
+    }
+  }
+
+  std::vector<const Robot *> constRobots() const {
+    std::vector<const Robot *> result;
+    for (const auto &robot : robots)
+      result.push_back(robot.get());
+    return result;
+  }
+};
+
+} // namespace
+
+void BM_StorageSave(Bench::State &state) {
+  StorageFixture fixture(static_cast<int>(state.range(0)),
+                         static_cast<int>(state.range(1)));
+  auto robots = fixture.constRobots();
+  std::string filename = tempFile("osbot_bench_save.osbot");
+
+  while (state.keepRunning()) {
+    Bench::doNotOptimize(
+        Storage::save_state(filename, *fixture.env, robots, fixture.scheduler));
+  }
+
+  auto bytes = static_cast<int64_t>(std::filesystem::file_size(filename));
+  state.setBytesProcessed(static_cast<int64_t>(state.iterations()) * bytes);
+  std::remove(filename.c_str());
+}
+OSBOT_BENCHMARK(BM_StorageSave)
+    ->argNames({"robots", "tasks"})
+    ->argsProduct({{1, 50}, {0, 100}});
+
+void BM_StorageLoad(Bench::State &state) {
+  StorageFixture fixture(static_cast<int>(state.range(0)),
+                         static_cast<int>(state.range(1)));
+  std::string filename = tempFile("osbot_bench_load.osbot");
+  Storage::save_state(filename, *fixture.env, fixture.constRobots(),
+                      fixture.scheduler);
+
+  Environment target(64, 64);
+  TaskScheduler scheduler;
+  std::vector<Robot *> loaded;
+
+  while (state.keepRunning()) {
+    Bench::doNotOptimize(
+        Storage::load_state(filename, target, loaded, scheduler));
+
+    // Liberar lo cargado fuera de la medición
+    state.pauseTiming();
+    for (auto *robot : loaded)
+      delete robot;
+    loaded.clear();
+    scheduler.clear();
+    state.resumeTiming();
+  }
+
+  auto bytes = static_cast<int64_t>(std::filesystem::file_size(filename));
+  state.setBytesProcessed(static_cast<int64_t>(state.iterations()) * bytes);
+  std::remove(filename.c_str());
+}
+OSBOT_BENCHMARK(BM_StorageLoad)
+    ->argNames({"robots", "tasks"})
+    ->argsProduct({{1, 50}, {0, 100}});
+
+} // namespace OSBot
+
+int main(int argc, char **argv) {
+  OSBot::Metrics::setEnabled(false);
+  OSBot::Tracer::setEnabled(false);
+  OSBot::Robot::setLoggingEnabled(false);
+  return OSBot::Bench::runAll(argc, argv);
+}
@@ -0,0 +1,355 @@
+/**
+ * @file http_loadgen.cpp
+ * @brief Generador de carga HTTP local para el WebServer de OS-Bot
+ *
+ * Simula dashboards y clientes de la API contra 127.0.0.1 con N conexiones
+ * concurrentes (keep-alive opcional) y reporta req/s y percentiles de
+ * latencia por endpoint.
+ *
+ * Ejecutar con el servidor levantado (./os-bot):
+ *   ./os-bot-loadgen --connections 16 --duration 10
+ *   ./os-bot-loadgen --mix state=1 --no-keep-alive
+ */
+
+#include "domain/Random.h"
+#include "infrastructure/Metrics.h"
+#include "infrastructure/httplib.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using OSBot::HistogramSummary;
+using OSBot::LatencyHistogram;
+
+enum Endpoint { STATE = 0, STATS, OBSTACLE, ROBOT_GOAL, ENDPOINT_COUNT };
+
+constexpr std::array<const char *, ENDPOINT_COUNT> ENDPOINT_NAMES = {
+    "GET  /api/state", "GET  /api/stats", "POST /api/obstacle",
+    "POST /api/robot/goal"};
+
+struct Options {
+  std::string host = "127.0.0.1";
+  int port = 8080;
+  int connections = 8;
+  double durationSeconds = 10.0;
+  double warmupSeconds = 1.0;
+  bool keepAlive = true;
+  // Pesos relativos de cada endpoint (dashboards sondeando el estado)
+  std::array<int, ENDPOINT_COUNT> weights = {70, 20, 5, 5};
+};
+
+/**
+ * @brief Datos del mundo necesarios para generar peticiones válidas
+ */
+struct WorldInfo {
+  int width = 60;
+  int height = 60;
+  std::vector<int> robotIds;
+};
+
+/**
+ * @brief Estadísticas por endpoint, compartidas entre conexiones
+ */
+struct EndpointStats {
+  LatencyHistogram latency;
+  std::atomic<uint64_t> errors{0};
+};
+
+void printUsage(const char *program) {
+  std::cout
+      << "Uso: " << program << " [opciones]\n\n"
+      << "  --host H            Servidor (default 127.0.0.1)\n"
+      << "  --port N            Puerto (default 8080)\n"
+      << "  --connections N     Conexiones concurrentes (default 8)\n"
+      << "  --duration S        Segundos de medición (default 10)\n"
+      << "  --warmup S          Segundos de calentamiento (default 1)\n"
+      << "  --no-keep-alive     Una conexión TCP nueva por petición\n"
+      << "  --mix LISTA         Pesos, p. ej. state=70,stats=20,obstacle=5,goal=5\n";
+}
+
+bool parseMix(const std::string &mix, std::array<int, ENDPOINT_COUNT> &weights) {
+  weights.fill(0);
+  std::istringstream iss(mix);
+  std::string item;
+  while (std::getline(iss, item, ',')) {
+    size_t eq = item.find('=');
+    if (eq == std::string::npos)
+      return false;
+    std::string name = item.substr(0, eq);
+    int weight = std::atoi(item.c_str() + eq + 1);
+    if (weight < 0)
+      return false;
+
+    if (name == "state")
+      weights[STATE] = weight;
+    else if (name == "stats")
+      weights[STATS] = weight;
+    else if (name == "obstacle")
+      weights[OBSTACLE] = weight;
+    else if (name == "goal")
+      weights[ROBOT_GOAL] = weight;
+    else
+      return false;
+  }
+
+  int total = 0;
+  for (int w : weights)
+    total += w;
+  return total > 0;
+}
+
+bool parseArguments(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+
+    if (arg == "--host" && hasValue) {
+      options.host = argv[++i];
+    } else if (arg == "--port" && hasValue) {
+      options.port = std::atoi(argv[++i]);
+    } else if (arg == "--connections" && hasValue) {
+      options.connections = std::atoi(argv[++i]);
+    } else if (arg == "--duration" && hasValue) {
+      options.durationSeconds = std::atof(argv[++i]);
+    } else if (arg == "--warmup" && hasValue) {
+      options.warmupSeconds = std::atof(argv[++i]);
+    } else if (arg == "--no-keep-alive") {
+      options.keepAlive = false;
+    } else if (arg == "--mix" && hasValue) {
+      if (!parseMix(argv[++i], options.weights)) {
+        std::cerr << "Mezcla inválida: " << argv[i] << "\n";
+        return false;
+      }
+    } else {
+      printUsage(argv[0]);
+      return false;
+    }
+  }
+
+  if (options.connections <= 0 || options.durationSeconds <= 0.0 ||
+      options.warmupSeconds < 0.0) {
+    std::cerr << "Argumentos fuera de rango\n";
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Extrae el entero que sigue a "key": a partir de pos
+ */
+bool findInt(const std::string &json, const std::string &key, size_t &pos,
+             int &value) {
+  size_t found = json.find("\"" + key + "\":", pos);
+  if (found == std::string::npos)
+    return false;
+  pos = found + key.size() + 3;
+  value = std::atoi(json.c_str() + pos);
+  return true;
+}
+
+/**
+ * @brief Lee el tamaño del grid y los IDs de robots de /api/state
+ */
+bool fetchWorldInfo(const Options &options, WorldInfo &world) {
+  httplib::Client client(options.host, options.port);
+  auto res = client.Get("/api/state");
+  if (!res || res->status != 200) {
+    std::cerr << "[LoadGen] Error: No se pudo leer /api/state de "
+              << options.host << ":" << options.port << std::endl;
+    return false;
+  }
+
+  const std::string &json = res->body;
+  size_t pos = 0;
+  findInt(json, "width", pos, world.width);
+  findInt(json, "height", pos, world.height);
+
+  size_t robotsPos = json.find("\"robots\":");
+  if (robotsPos != std::string::npos) {
+    pos = robotsPos;
+    int id = 0;
+    while (findInt(json, "id", pos, id))
+      world.robotIds.push_back(id);
+  }
+  return true;
+}
+
+/**
+ * @brief Bucle de una conexión: peticiones hasta que se acabe el tiempo
+ */
+void connectionLoop(int index, const Options &options, const WorldInfo &world,
+                    std::array<std::unique_ptr<EndpointStats>, ENDPOINT_COUNT> &stats,
+                    const std::atomic<bool> &measuring,
+                    const std::atomic<bool> &stop) {
+  httplib::Client client(options.host, options.port);
+  client.set_keep_alive(options.keepAlive);
+  client.set_tcp_nodelay(true);
+
+  OSBot::Xoshiro256 rng(0x10AD0000 + index);
+  int totalWeight = 0;
+  for (int w : options.weights)
+    totalWeight += w;
+
+  // Cada obstáculo agregado se quita en la siguiente edición: el mapa
+  // vuelve a su estado original en lugar de llenarse
+  bool hasPendingToggle = false;
+  int pendingX = 0, pendingY = 0;
+
+  while (!stop.load(std::memory_order_relaxed)) {
+    int pick = rng.uniformInt(0, totalWeight - 1);
+    int endpoint = 0;
+    while (pick >= options.weights[endpoint]) {
+      pick -= options.weights[endpoint];
+      endpoint++;
+    }
+    if (endpoint == ROBOT_GOAL && world.robotIds.empty())
+      endpoint = STATE;
+
+    auto start = std::chrono::steady_clock::now();
+    httplib::Result res;
+    switch (endpoint) {
+    case STATE:
+      res = client.Get("/api/state");
+      break;
+    case STATS:
+      res = client.Get("/api/stats");
+      break;
+    case OBSTACLE: {
+      if (!hasPendingToggle) {
+        pendingX = rng.uniformInt(1, world.width - 2);
+        pendingY = rng.uniformInt(1, world.height - 2);
+      }
+      hasPendingToggle = !hasPendingToggle;
+      std::string body = "{\"x\":" + std::to_string(pendingX) +
+                         ",\"y\":" + std::to_string(pendingY) + "}";
+      res = client.Post("/api/obstacle", body, "application/json");
+      break;
+    }
+    case ROBOT_GOAL: {
+      int id = world.robotIds[rng.uniformInt(
+          0, static_cast<int>(world.robotIds.size()) - 1)];
+      std::string body = "{\"id\":" + std::to_string(id) +
+                         ",\"x\":" + std::to_string(rng.uniformInt(1, world.width - 2)) +
+                         ",\"y\":" + std::to_string(rng.uniformInt(1, world.height - 2)) +
+                         "}";
+      res = client.Post("/api/robot/goal", body, "application/json");
+      break;
+    }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    if (!measuring.load(std::memory_order_relaxed))
+      continue; // Calentamiento
+
+    EndpointStats &s = *stats[endpoint];
+    if (!res || res->status != 200) {
+      s.errors.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    s.latency.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count()));
+  }
+}
+
+void printRow(const std::string &name, const LatencyHistogram &h,
+              uint64_t errors, double seconds) {
+  auto ms = [](uint64_t ns) { return ns / 1e6; };
+  HistogramSummary s = h.summary();
+  std::cout << std::left << std::setw(24) << name << std::right
+            << std::setw(10) << s.count << std::setw(8) << errors
+            << std::fixed << std::setprecision(1) << std::setw(11)
+            << s.count / seconds << std::setprecision(3) << std::setw(10)
+            << ms(s.p50) << std::setw(10) << ms(h.percentile(90.0))
+            << std::setw(10) << ms(s.p99) << std::setw(10)
+            << ms(h.percentile(99.9)) << std::setw(10) << ms(s.max)
+            << std::defaultfloat << "\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parseArguments(argc, argv, options))
+    return 1;
+
+  WorldInfo world;
+  if (!fetchWorldInfo(options, world))
+    return 1;
+
+  std::cout << "[LoadGen] " << options.host << ":" << options.port << " - "
+            << options.connections << " conexiones, "
+            << (options.keepAlive ? "keep-alive" : "sin keep-alive") << ", "
+            << options.durationSeconds << " s (+" << options.warmupSeconds
+            << " s calentamiento), grid " << world.width << "x"
+            << world.height << ", " << world.robotIds.size() << " robots"
+            << std::endl;
+
+  std::array<std::unique_ptr<EndpointStats>, ENDPOINT_COUNT> stats;
+  for (auto &s : stats)
+    s = std::make_unique<EndpointStats>();
+
+  std::atomic<bool> measuring{false};
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> connections;
+  for (int i = 0; i < options.connections; ++i) {
+    connections.emplace_back(connectionLoop, i, std::cref(options),
+                             std::cref(world), std::ref(stats),
+                             std::cref(measuring), std::cref(stop));
+  }
+
+  std::this_thread::sleep_for(
+      std::chrono::duration<double>(options.warmupSeconds));
+  measuring = true;
+  auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(
+      std::chrono::duration<double>(options.durationSeconds));
+  measuring = false;
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  stop = true;
+  for (auto &thread : connections)
+    thread.join();
+
+  // Informe: latencias en ms
+  std::cout << "\n"
+            << std::left << std::setw(24) << "Endpoint" << std::right
+            << std::setw(10) << "reqs" << std::setw(8) << "errors"
+            << std::setw(11) << "req/s" << std::setw(10) << "p50(ms)"
+            << std::setw(10) << "p90(ms)" << std::setw(10) << "p99(ms)"
+            << std::setw(10) << "p99.9(ms)" << std::setw(10) << "max(ms)"
+            << "\n"
+            << std::string(103, '-') << "\n";
+
+  uint64_t totalErrors = 0;
+  for (int e = 0; e < ENDPOINT_COUNT; ++e) {
+    if (options.weights[e] == 0)
+      continue;
+    printRow(ENDPOINT_NAMES[e], stats[e]->latency, stats[e]->errors.load(),
+             seconds);
+    totalErrors += stats[e]->errors.load();
+  }
+
+  uint64_t totalCount = 0;
+  for (const auto &s : stats)
+    totalCount += s->latency.count();
+  std::cout << std::string(103, '-') << "\n"
+            << std::left << std::setw(24) << "TOTAL" << std::right
+            << std::setw(10) << totalCount << std::setw(8) << totalErrors
+            << std::fixed << std::setprecision(1) << std::setw(11)
+            << totalCount / seconds << std::defaultfloat << "\n";
+
+  // Código de salida != 0 si hubo errores (útil en CI)
+  return totalErrors > 0 ? 1 : 0;
+}
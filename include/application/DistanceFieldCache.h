@@ -0,0 +1,102 @@
+#ifndef RIDEBOT_DISTANCEFIELDCACHE_H
+#define RIDEBOT_DISTANCEFIELDCACHE_H
+
+#include "domain/Global.h"
+#include "infrastructure/ProfiledMutex.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace OSBot {
+
+class Environment;
+
+/**
+ * @brief Distancias de grid (4-conectado, en celdas) de todas las celdas a
+ * un destino, calculadas con un BFS desde el destino
+ */
+class DistanceField {
+public:
+  static constexpr int32_t UNREACHABLE = -1;
+
+  DistanceField(Point target, uint64_t mapVersion, int width, int height,
+                const std::vector<uint8_t> &obstacleMask);
+
+  /**
+   * @brief Distancia en celdas desde 'from' hasta el destino
+   * @return UNREACHABLE si 'from' está fuera del mapa, es obstáculo o no
+   * tiene camino
+   */
+  int32_t distanceFrom(const Point &from) const {
+    if (from.x < 0 || from.x >= width_ || from.y < 0 || from.y >= height_)
+      return UNREACHABLE;
+    return distance_[static_cast<size_t>(from.y) * width_ + from.x];
+  }
+
+  Point getTarget() const { return target_; }
+  uint64_t getMapVersion() const { return mapVersion_; }
+
+private:
+  Point target_;
+  uint64_t mapVersion_;
+  int width_;
+  int height_;
+  std::vector<int32_t> distance_;
+};
+
+/**
+ * @class DistanceFieldCache
+ * @brief Campos de distancia por destino, compartidos mientras el mapa no
+ * cambie
+ *
+ * Costear N robots contra M tareas cuesta M BFS (uno por primer waypoint,
+ * O(celdas) cada uno) y N*M lecturas O(1), en lugar de N*M búsquedas A*.
+ * Los campos se indexan por celda destino y se invalidan todos juntos
+ * cuando cambia la versión del mapa; se descartan los menos usados
+ * recientemente cuando se supera el presupuesto de memoria.
+ *
+ * Thread-safe. get() devuelve un shared_ptr: el campo sigue vivo aunque
+ * se invalide mientras el llamador lo usa.
+ */
+class DistanceFieldCache {
+public:
+  // Presupuesto por defecto: 32 MB (~32 campos de 500x500)
+  static constexpr size_t DEFAULT_MAX_BYTES = 32u << 20;
+
+  explicit DistanceFieldCache(const Environment &environment,
+                              size_t maxBytes = DEFAULT_MAX_BYTES);
+
+  /**
+   * @brief Campo de distancias hacia 'target' para la versión actual del
+   * mapa (lo calcula si no está en caché)
+   */
+  std::shared_ptr<const DistanceField> get(const Point &target);
+
+  void clear();
+  size_t size() const;
+
+private:
+  using FieldList = std::list<std::shared_ptr<const DistanceField>>;
+
+  const Environment &environment_;
+  size_t maxBytes_;
+
+  mutable KernelMutex mutex_{"DistanceFieldCache::mutex_"};
+  uint64_t mapVersion_ = 0;           // Versión de la máscara y los campos
+  std::vector<uint8_t> obstacleMask_; // Copia compartida por los BFS
+  bool hasMask_ = false;
+  FieldList fields_; // Uso más reciente al frente
+  std::unordered_map<uint64_t, FieldList::iterator> index_;
+
+  size_t capacity() const;
+  static uint64_t keyOf(const Point &target) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(target.y)) << 32) |
+           static_cast<uint32_t>(target.x);
+  }
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_DISTANCEFIELDCACHE_H
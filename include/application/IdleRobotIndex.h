@@ -0,0 +1,125 @@
+#ifndef RIDEBOT_IDLEROBOTINDEX_H
+#define RIDEBOT_IDLEROBOTINDEX_H
+
+#include "domain/Global.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace OSBot {
+
+/**
+ * @brief Robot libre para asignación: ID y posición leídos juntos
+ */
+struct AvailableRobot {
+  int id;
+  Point position;
+};
+
+/**
+ * @class IdleRobotIndex
+ * @brief Índice espacial de robots libres en cubetas de un grid uniforme
+ *
+ * Cada cubeta cubre BUCKET_SIZE x BUCKET_SIZE celdas. Insertar, mover y
+ * quitar un robot es O(1) (borrado por intercambio con el último), así que
+ * el índice se mantiene de forma incremental a medida que los robots se
+ * mueven o cambian de estado.
+ *
+ * Las consultas recorren anillos de cubetas alrededor del punto: el anillo
+ * r (r >= 1) está a distancia Manhattan >= (r - 1) * BUCKET_SIZE + 1, lo
+ * que permite cortar en cuanto ningún robot pendiente puede mejorar el
+ * resultado. El costo depende de la densidad local, no del tamaño de la
+ * flota.
+ *
+ * NOTA: No es thread-safe; lo protege robotsMutex_ del RobotManager.
+ */
+class IdleRobotIndex {
+public:
+  static constexpr int BUCKET_SIZE = 8;
+
+  IdleRobotIndex(int width = 0, int height = 0);
+
+  /**
+   * @brief Inserta, mueve o quita el robot según 'available'
+   */
+  void update(int robotId, const Point &position, bool available);
+  void remove(int robotId) { update(robotId, Point(), false); }
+  void clear();
+
+  size_t size() const { return count_; }
+
+  /**
+   * @brief Los k robots más cercanos (Manhattan), por distancia y luego ID
+   */
+  void nearest(const Point &target, size_t k,
+               std::vector<AvailableRobot> &out) const;
+
+  /**
+   * @brief Robots a distancia Manhattan <= radius, por distancia y luego ID
+   */
+  void withinRadius(const Point &target, int radius,
+                    std::vector<AvailableRobot> &out) const;
+
+  /**
+   * @brief Recorre los robots por anillos de cubetas alrededor de 'target'
+   * @param stop stop(minDistance): se consulta antes de cada anillo con la
+   *             cota inferior de distancia Manhattan de sus robots;
+   *             devolver true termina el recorrido
+   * @param visit visit(const AvailableRobot&)
+   */
+  template <typename Stop, typename Visit>
+  void visitByRing(const Point &target, Stop &&stop, Visit &&visit) const {
+    if (count_ == 0)
+      return;
+    int cx = bucketX(target.x);
+    int cy = bucketY(target.y);
+    int maxRing = std::max(std::max(cx, bucketsWide_ - 1 - cx),
+                           std::max(cy, bucketsHigh_ - 1 - cy));
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+      if (stop(ring == 0 ? 0 : (ring - 1) * BUCKET_SIZE + 1))
+        return;
+      for (int by = cy - ring; by <= cy + ring; ++by) {
+        if (by < 0 || by >= bucketsHigh_)
+          continue;
+        // Filas superior e inferior completas; en medio solo los extremos
+        bool edgeRow = by == cy - ring || by == cy + ring;
+        int step = edgeRow ? 1 : std::max(1, 2 * ring);
+        for (int bx = cx - ring; bx <= cx + ring; bx += step) {
+          if (bx < 0 || bx >= bucketsWide_)
+            continue;
+          for (const AvailableRobot &robot : buckets_[by * bucketsWide_ + bx])
+            visit(robot);
+        }
+      }
+    }
+  }
+
+  static int distance(const Point &a, const Point &b) {
+    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+  }
+
+private:
+  struct Slot {
+    int bucket = -1; // -1: el robot no está en el índice
+    uint32_t index = 0;
+  };
+
+  int bucketsWide_;
+  int bucketsHigh_;
+  size_t count_ = 0;
+  std::vector<std::vector<AvailableRobot>> buckets_;
+  std::vector<Slot> slots_; // Por ID de robot
+
+  int bucketX(int x) const {
+    return std::clamp(x / BUCKET_SIZE, 0, bucketsWide_ - 1);
+  }
+  int bucketY(int y) const {
+    return std::clamp(y / BUCKET_SIZE, 0, bucketsHigh_ - 1);
+  }
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_IDLEROBOTINDEX_H
@@ -3,10 +3,13 @@
 
 #include "RobotManager.h"
 #include "TaskManager.h"
+#include "WorldSnapshot.h"
 #include "domain/Environment.h"
 #include "domain/Global.h"
+#include "infrastructure/GridCodec.h"
 #include "infrastructure/Storage.h"
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <thread>
 
@@ -17,6 +20,27 @@ class WebServer;
 
 namespace OSBot {
 
+/**
+ * @brief Configuración de arranque de la simulación
+ */
+struct SimulationConfig {
+  bool headless = false;     // Sin web, sin render, sin hilos ni sleeps
+  uint64_t seed = 0;         // Semilla maestra (0 = no determinista)
+  int tickMs = Constants::SIMULATION_SPEED_MS; // Paso del reloj virtual
+  uint64_t maxTicks = 0;     // Ticks a simular en headless (0 = usar duración)
+  int gridWidth = Constants::GRID_WIDTH;
+  int gridHeight = Constants::GRID_HEIGHT;
+  bool profiling = true;     // Histogramas de latencia por fase del tick
+  bool tracing = false;      // Spans en buffers por hilo (Chrome trace)
+  // Compresión de /api/state (0 = desactivada). Se comprime una vez por
+  // tick: en 500x500 el nivel 1 tarda ~4 ms (x7.5), el 6 ~30 ms (x11)
+  int gzipLevel = 1;
+  AssignmentMode assignment = AssignmentMode::GREEDY; // Ver TaskManager.h
+  SchedulingPolicy scheduling = SchedulingPolicy::PRIORITY;
+  bool optimizeRoutes = false; // Reordenar waypoints al crear tareas
+  bool routeFixLast = false;   // El último waypoint no se mueve al reordenar
+};
+
 /**
  * @class Kernel
  * @brief Núcleo monolítico del sistema operativo multi-robot
@@ -29,10 +53,15 @@ namespace OSBot {
  */
 class Kernel {
 public:
+  // Con profiling, 1 de cada N ticks mide sus fases (tick.*): medir todos
+  // costaría un ~30% de un tick sin planificación
+  static constexpr uint64_t PROFILE_EVERY_TICKS = 64;
+
   /**
    * @brief Constructor
+   * @param config Configuración de la simulación (modo, semilla, tamaño)
    */
-  Kernel();
+  explicit Kernel(const SimulationConfig &config = SimulationConfig());
 
   /**
    * @brief Destructor - Asegura el apagado limpio de todos los hilos
@@ -61,6 +90,47 @@ public:
    */
   void shutdown();
 
+  /**
+   * @brief Ejecuta un tick completo de la simulación de forma síncrona
+   * Avanza el reloj virtual, mueve cada robot un paso (orden por ID) y
+   * actualiza tareas. Solo tiene sentido en modo headless.
+   */
+  void step();
+
+  /**
+   * @brief Crea robots en posiciones libres aleatorias (semilla del entorno)
+   * @return Número de robots creados
+   */
+  int spawnRobots(int count);
+
+  /**
+   * @brief Huella FNV-1a del estado observable (robots, tareas, objetivo)
+   * Dos ejecuciones headless con la misma semilla producen la misma huella
+   */
+  uint64_t computeStateDigest() const;
+
+  const SimulationConfig &getConfig() const { return config_; }
+  uint64_t getTickCount() const { return tickCount_; }
+
+  /**
+   * @brief Captura y publica una nueva foto del mundo
+   * La llama el hilo de actualización al final de cada tick y el servidor
+   * tras cada modificación, para que el cambio se vea sin esperar al tick.
+   * En headless no se publica nada salvo que alguien lo pida.
+   */
+  std::shared_ptr<const WorldSnapshot> publishSnapshot();
+
+  /**
+   * @brief Foto vigente (std::atomic_load: sin locks del mapa ni de robots)
+   * Si todavía no se publicó ninguna, la captura en el momento.
+   */
+  std::shared_ptr<const WorldSnapshot> getSnapshot();
+
+  /**
+   * @brief Bitmaps de las últimas versiones del mapa (deltas de state.bin)
+   */
+  const GridHistory &getGridHistory() const { return gridHistory_; }
+
   // Acceso a subsistemas (para control externo si es necesario)
   Environment &getEnvironment() { return *environment_; }
   RobotManager &getRobotManager() { return *robotManager_; }
@@ -73,6 +143,15 @@ public:
   int getSimulationSpeed() const { return simulationSpeed_; }
 
 private:
+  SimulationConfig config_;
+  std::atomic<uint64_t> tickCount_;
+
+  // Foto publicada: solo se accede con std::atomic_load/atomic_store
+  std::shared_ptr<const WorldSnapshot> snapshot_;
+  // Serializa a los publicadores; los lectores nunca lo toman
+  KernelMutex publishMutex_{"Kernel::publishMutex_"};
+  GridHistory gridHistory_;
+
   // Subsistemas principales
   std::unique_ptr<Environment> environment_;
   std::unique_ptr<RobotManager> robotManager_;
@@ -91,10 +170,20 @@ private:
    */
   void updateLoop();
 
+  /**
+   * @brief Bucle fast-forward: ejecuta N ticks sin esperas e imprime resumen
+   */
+  void runHeadless(uint64_t ticks);
+
   /**
    * @brief Imprime información del sistema al iniciar
    */
   void printSystemInfo();
+
+  /**
+   * @brief Atiende solicitudes de volcado de traza (SIGUSR1)
+   */
+  void serviceTraceDump();
 };
 
 } // namespace OSBot
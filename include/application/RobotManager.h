@@ -5,10 +5,15 @@
 #include "domain/Robot.h"
 #include "domain/Task.h"
 #include "domain/Environment.h"
+#include "domain/Random.h"
+#include "domain/SimulationClock.h"
+#include "IdleRobotIndex.h"
+#include "infrastructure/ProfiledMutex.h"
 #include <memory>
 #include <vector>
 #include <mutex>
 #include <map>
+#include <limits>
 
 namespace OSBot {
 
@@ -44,13 +49,23 @@ struct RobotInfo {
         , totalDistanceTraveled(0.0)
         , cellsTraveled(0)
         , obstaclesAvoided(0)
-        , lastUpdateTime(std::chrono::system_clock::now())
+        , lastUpdateTime(SimulationClock::now())
         , isActive(true)
         , currentGoal(home)
         , hasPersonalGoal(false)
     {}
 };
 
+/**
+ * @brief Posición y estado de un robot leídos juntos
+ */
+struct RobotProgress {
+    Point position;
+    State state;
+    int cellsTraveled;
+    bool found; // false si el robot ya no existe
+};
+
 /**
  * @brief Gestor de múltiples robots
  * Coordina la operación de múltiples robots en el entorno
@@ -66,6 +81,10 @@ public:
     void startAllRobots();
     void stopAllRobots();
     
+    // Modo headless: robots sin hilo propio, avanzados por el Kernel
+    void startAllRobotsStepped();
+    void stepAllRobots();
+    
     // Asignación de tareas
     bool assignTask(int robotId, std::shared_ptr<Task> task);
     void unassignTask(int robotId);
@@ -82,6 +101,19 @@ public:
     RobotInfo* getRobotInfo(int robotId);
     const RobotInfo* getRobotInfo(int robotId) const;
     std::vector<const RobotInfo*> getAllRobots() const;
+    const Environment& getEnvironment() const { return environment_; }
+    
+    /**
+     * @brief Recorre todos los robots (por ID ascendente) con el lock tomado
+     * NOTA: Sin copia intermedia; el visitor no debe llamar al RobotManager
+     */
+    template <typename Visitor>
+    void forEachRobot(Visitor&& visitor) const {
+        std::lock_guard<KernelMutex> lock(robotsMutex_);
+        for (const auto& [id, info] : robots_) {
+            visitor(*info);
+        }
+    }
     
     // Actualización
     void update();
@@ -90,6 +122,66 @@ public:
     bool isRobotAvailable(int robotId) const;
     int findAvailableRobot() const;
     
+    /**
+     * @brief Robots disponibles (mismo criterio que isRobotAvailable) con su
+     * posición, en una sola lectura consistente con un único lock
+     * NOTA: Reemplaza el contenido de 'out' y reutiliza su capacidad
+     */
+    void getAvailableRobots(std::vector<AvailableRobot>& out) const;
+    
+    /**
+     * @brief Posición y estado de cada robot de 'robotIds' (en el mismo
+     * orden), con un único lock
+     * NOTA: Reemplaza el contenido de 'out' y reutiliza su capacidad
+     */
+    void getRobotProgress(const std::vector<int>& robotIds,
+                          std::vector<RobotProgress>& out) const;
+    
+    /**
+     * @brief Los k robots disponibles más cercanos a 'target' (Manhattan),
+     * usando el índice espacial; costo proporcional a la densidad local
+     */
+    void findNearestAvailable(const Point& target, size_t k,
+                              std::vector<AvailableRobot>& out) const;
+    
+    /**
+     * @brief Robots disponibles a distancia Manhattan <= radius de 'target'
+     */
+    void findAvailableWithin(const Point& target, int radius,
+                             std::vector<AvailableRobot>& out) const;
+    
+    /**
+     * @brief Robot disponible de menor costo, buscando por anillos del
+     * índice espacial alrededor de 'target'
+     * @param cost cost(posición) -> double; debe ser >= distancia Manhattan
+     *             hasta 'target' (la distancia de grid lo es) para poder
+     *             cortar la búsqueda sin perder el óptimo
+     * @return ID del robot (a igual costo, el de menor ID) o -1
+     * NOTA: 'cost' se evalúa con el lock tomado; no debe llamar al RobotManager
+     */
+    template <typename CostFn>
+    int findBestAvailable(const Point& target, CostFn&& cost,
+                          double* bestCostOut = nullptr) const {
+        std::lock_guard<KernelMutex> lock(robotsMutex_);
+        
+        int bestId = -1;
+        double bestCost = std::numeric_limits<double>::max();
+        idleIndex_.visitByRing(
+            target,
+            [&](int minDistance) { return bestId != -1 && minDistance > bestCost; },
+            [&](const AvailableRobot& robot) {
+                double c = cost(robot.position);
+                if (c < bestCost || (c == bestCost && robot.id < bestId)) {
+                    bestCost = c;
+                    bestId = robot.id;
+                }
+            });
+        if (bestCostOut) {
+            *bestCostOut = bestCost;
+        }
+        return bestId;
+    }
+    
     // Reset
     void resetRobotPosition();
     
@@ -97,9 +189,12 @@ private:
     Environment& environment_;
     std::map<int, std::unique_ptr<RobotInfo>> robots_;
     int nextRobotId_;
-    mutable std::mutex robotsMutex_;
+    mutable KernelMutex robotsMutex_{"RobotManager::robotsMutex_"};
+    Xoshiro256 rng_; // Flujo aleatorio para reposicionamiento
+    IdleRobotIndex idleIndex_; // Robots disponibles por posición (bajo robotsMutex_)
     
     void updateRobotStats(RobotInfo& info);
+    void refreshIndex(const RobotInfo& info); // Requiere robotsMutex_ tomado
 };
 
 } // namespace OSBot
@@ -0,0 +1,95 @@
+#ifndef RIDEBOT_ROUTEOPTIMIZER_H
+#define RIDEBOT_ROUTEOPTIMIZER_H
+
+#include "domain/Global.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OSBot {
+
+class Environment;
+
+/**
+ * @brief Restricciones y presupuesto de una optimización de ruta
+ *
+ * maxStops y maxPasses acotan el trabajo de forma determinista: el mismo
+ * mapa y los mismos waypoints dan el mismo orden en cualquier máquina.
+ * timeBudgetMs es un tope adicional de reloj de pared para el modo
+ * interactivo; en headless y escenarios debe ser 0 para no romper la
+ * reproducibilidad.
+ */
+struct RouteOptions {
+  bool fixFirst = true;       // El primer waypoint sigue siendo el primero
+  bool fixLast = false;       // El último waypoint sigue siendo el último
+  size_t maxStops = 64;       // Con más paradas se deja el orden enviado
+  int maxPasses = 50;         // Pasadas de 2-opt + Or-opt (heurística)
+  double timeBudgetMs = 10.0; // Reloj de pared, BFS incluidos; 0 = sin tope
+};
+
+/**
+ * @brief Orden propuesto para los waypoints de una tarea
+ */
+struct RouteResult {
+  enum class Method { UNCHANGED, EXACT, HEURISTIC };
+
+  std::vector<int> order;     // Índices de los waypoints originales
+  int64_t originalCells = -1; // Recorrido en el orden enviado (-1: sin camino)
+  int64_t optimizedCells = -1; // Recorrido en 'order' (-1: sin camino)
+  Method method = Method::UNCHANGED;
+  bool timedOut = false; // Se agotó el presupuesto antes de terminar
+};
+
+/**
+ * @class RouteOptimizer
+ * @brief Reordena los waypoints de una tarea para acortar el recorrido
+ *
+ * Es un TSP de camino abierto (el robot no vuelve al inicio) sobre
+ * distancias reales de grid. Cada optimización copia la máscara de
+ * obstáculos una vez y lanza un BFS por parada que se detiene al alcanzar
+ * las demás; no usa la DistanceFieldCache del planificador, así que no
+ * compite por su lock ni desaloja sus campos. Hasta EXACT_MAX_STOPS
+ * paradas se resuelve de forma exacta con programación dinámica de
+ * Held-Karp, O(2^n * n^2). Por encima se parte del mejor entre el orden
+ * enviado y el del vecino más cercano, y se mejora con 2-opt y Or-opt
+ * (mover tramos de 1 a 3 paradas) hasta un óptimo local, maxPasses pasadas
+ * o el tope de tiempo. El resultado nunca es peor que el orden enviado.
+ *
+ * Las distancias se simetrizan (máximo de ida y vuelta) para que invertir
+ * un tramo no cambie su costo; los tramos sin camino cuestan
+ * UNREACHABLE_LEG y el optimizador los evita si puede.
+ *
+ * Thread-safe: optimize() solo lee el entorno (bajo su lock, al copiar la
+ * máscara) y usa buffers propios de cada hilo.
+ */
+class RouteOptimizer {
+public:
+  static constexpr size_t EXACT_MAX_STOPS = 12;
+  static constexpr int64_t UNREACHABLE_LEG = 1000000;
+
+  explicit RouteOptimizer(const Environment &environment)
+      : environment_(environment) {}
+
+  /**
+   * @brief Optimiza el orden de 'waypoints'
+   * Con más de maxStops paradas, o si el tope de tiempo se agota antes de
+   * tener todas las distancias, devuelve el orden original
+   * (method == UNCHANGED; timedOut indica lo segundo).
+   */
+  RouteResult optimize(const std::vector<Point> &waypoints,
+                       const RouteOptions &options) const;
+
+  /**
+   * @brief Núcleo sobre una matriz de distancias n x n (fila = origen,
+   * columna = destino; negativo = sin camino)
+   */
+  static RouteResult solve(const std::vector<int64_t> &distance, size_t n,
+                           const RouteOptions &options);
+
+private:
+  const Environment &environment_;
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_ROUTEOPTIMIZER_H
@@ -0,0 +1,140 @@
+#ifndef RIDEBOT_SCENARIORUNNER_H
+#define RIDEBOT_SCENARIORUNNER_H
+
+#include "application/Kernel.h"
+#include "domain/Random.h"
+#include "domain/Task.h"
+#include "infrastructure/Metrics.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace OSBot {
+
+/**
+ * @brief Evento de un flujo de carga grabado
+ *
+ * Formato de texto (una línea por evento, '#' inicia un comentario):
+ *   <tick> task <x>,<y> [<x>,<y> ...] [p=<0-3>] [d=<ms>]
+ *   <tick> obstacle <x>,<y>
+ * "d" es el plazo de la tarea en ms virtuales desde su inyección.
+ * "obstacle" alterna la celda (agrega o quita el obstáculo).
+ */
+struct ScenarioEvent {
+  enum class Type { TASK, OBSTACLE };
+
+  uint64_t tick = 0;
+  Type type = Type::TASK;
+  std::vector<Point> points; // Waypoints (TASK) o celda editada (OBSTACLE)
+  TaskPriority priority = TaskPriority::NORMAL;
+  int deadlineMs = 0; // 0 = sin plazo
+};
+
+/**
+ * @brief Configuración de una ejecución de escenario
+ */
+struct ScenarioConfig {
+  SimulationConfig simulation; // Siempre se ejecuta en headless
+  int robots = 10;             // Flota total (incluye los robots del mapa)
+  std::string mapFile;         // Mapa .osbot (opcional)
+  std::string eventsFile;      // Flujo grabado (opcional)
+  double replaySpeed = 1.0;    // >1 comprime el flujo grabado en menos ticks
+  double taskRate = 0.0;       // Tareas sintéticas por tick
+  double obstacleRate = 0.0;   // Ediciones de obstáculos sintéticas por tick
+
+  /**
+   * @brief true si se pidió alguna fuente de carga o mapa
+   */
+  bool isEnabled() const {
+    return !mapFile.empty() || !eventsFile.empty() || taskRate > 0.0 ||
+           obstacleRate > 0.0;
+  }
+};
+
+/**
+ * @brief Resultado de una ejecución de escenario
+ */
+struct ScenarioReport {
+  uint64_t ticks = 0;
+  size_t robots = 0;
+  double wallSeconds = 0.0;
+  double virtualSeconds = 0.0;
+
+  size_t tasksInjected = 0;
+  size_t tasksCompleted = 0;
+  size_t tasksFailed = 0;
+  size_t tasksPending = 0;
+  size_t obstacleEdits = 0;
+
+  double robotStepsPerSecond = 0.0; // robots x ticks / segundo real
+  double tasksPerSecond = 0.0;      // tareas completadas / segundo real
+  size_t cellsTraveled = 0;         // Recorrido total de la flota
+  uint64_t approachCells = 0;       // Distancia robot -> inicio de tarea
+
+  HistogramSummary tick;    // tick.total
+  HistogramSummary planner; // planner.find_path
+  HistogramSummary assignment; // schedule.assignment_solve (modo batch)
+  HistogramSummary wait[4];     // task.wait_ms.<clase>, de LOW a URGENT
+  int64_t oldestPendingMs[4] = {0, 0, 0, 0}; // Siguen en cola al terminar
+  uint64_t deadlinesMissed = 0; // Tareas asignadas después de su plazo
+  uint64_t routeEstimatedCells = 0; // Rutas optimizadas: estimado al crear
+  uint64_t routeActualCells = 0;    // y recorrido real, mismas tareas
+  uint64_t routeSavedCells = 0;     // Frente al orden enviado
+  uint64_t digest = 0;
+};
+
+/**
+ * @class ScenarioRunner
+ * @brief Reproduce carga de producción sobre el Kernel en fast-forward
+ *
+ * Carga un mapa .osbot, crea la flota, inyecta un flujo grabado de tareas
+ * y ediciones de obstáculos (más carga sintética opcional) y mide el
+ * rendimiento de extremo a extremo sin interfaz web.
+ */
+class ScenarioRunner {
+public:
+  explicit ScenarioRunner(const ScenarioConfig &config);
+
+  /**
+   * @brief Ejecuta el escenario completo
+   * @return false si no se pudo cargar el mapa o el flujo de eventos
+   */
+  bool run(ScenarioReport &report);
+
+  /**
+   * @brief Interpreta un flujo de eventos en formato de texto
+   * @param error Mensaje con el número de línea si falla
+   */
+  static bool parseEvents(std::istream &in, std::vector<ScenarioEvent> &events,
+                          std::string &error);
+
+  static void printReport(const ScenarioReport &report, std::ostream &os);
+
+private:
+  ScenarioConfig config_;
+  std::vector<ScenarioEvent> events_;
+  size_t nextEvent_;
+  Xoshiro256 rng_; // Carga sintética (flujo RandomStream::SCENARIO)
+
+  bool loadEvents();
+  bool loadMap(Kernel &kernel, ScenarioReport &report);
+
+  /**
+   * @brief Inyecta los eventos grabados y sintéticos de un tick
+   */
+  void injectTick(Kernel &kernel, uint64_t tick, ScenarioReport &report);
+  void applyEvent(Kernel &kernel, const ScenarioEvent &event,
+                  ScenarioReport &report);
+
+  /**
+   * @brief Número de eventos de un proceso con tasa media 'rate' por tick
+   */
+  int sampleCount(double rate);
+
+  Point randomFreeCell(const Environment &env);
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_SCENARIORUNNER_H
@@ -0,0 +1,88 @@
+#ifndef RIDEBOT_TASKHISTORY_H
+#define RIDEBOT_TASKHISTORY_H
+
+#include "domain/Task.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace OSBot {
+
+/**
+ * @brief Resumen compacto de una tarea terminada (sin waypoints)
+ * Los instantes son ms del reloj de la simulación; startMs es 0 si la
+ * tarea nunca llegó a arrancar.
+ */
+struct TaskRecord {
+  int id = 0;
+  TaskStatus status = TaskStatus::COMPLETED;
+  TaskPriority priority = TaskPriority::NORMAL;
+  int robotId = -1;
+  int waypointsVisited = 0;
+  int waypointCount = 0;
+  int64_t createdMs = 0;
+  int64_t startMs = 0;
+  int64_t finishedMs = 0;
+};
+
+/**
+ * @class TaskHistory
+ * @brief Anillo de capacidad fija con las últimas tareas terminadas
+ *
+ * Las tareas completadas, fallidas o canceladas salen del conjunto vivo
+ * del TaskManager y quedan aquí resumidas; al llenarse se descarta la más
+ * antigua. La memoria no crece con el tiempo de ejecución, y los totales
+ * históricos siguen disponibles en los contadores de TaskStats.
+ *
+ * NOTA: No es thread-safe; lo protege tasksMutex_ del TaskManager.
+ */
+class TaskHistory {
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+  explicit TaskHistory(size_t capacity = DEFAULT_CAPACITY);
+
+  /**
+   * @brief Archiva el resumen de 'task' (descarta el más antiguo si está
+   * lleno)
+   */
+  void record(const Task &task);
+
+  /**
+   * @brief Busca una tarea archivada por ID
+   * @return false si nunca se archivó o ya se descartó
+   */
+  bool find(int taskId, TaskRecord &out) const;
+
+  /**
+   * @brief Las 'limit' tareas archivadas más recientes, de la más nueva a
+   * la más antigua
+   */
+  void recent(size_t limit, std::vector<TaskRecord> &out) const;
+
+  /**
+   * @brief Recorre las tareas archivadas de la más antigua a la más nueva
+   */
+  template <typename Visit> void forEach(Visit &&visit) const {
+    size_t first = (head_ + ring_.size() - size_) % ring_.size();
+    for (size_t i = 0; i < size_; ++i)
+      visit(ring_[(first + i) % ring_.size()]);
+  }
+
+  void clear();
+  size_t size() const { return size_; }
+  size_t capacity() const { return ring_.size(); }
+  uint64_t totalRecorded() const { return totalRecorded_; }
+
+private:
+  std::vector<TaskRecord> ring_;
+  size_t head_ = 0; // Próxima posición de escritura
+  size_t size_ = 0;
+  uint64_t totalRecorded_ = 0;
+  std::unordered_map<int, size_t> slots_; // ID -> posición en el anillo
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_TASKHISTORY_H
@@ -3,9 +3,14 @@
 
 #include "domain/Task.h"
 #include "RobotManager.h"
+#include "DistanceFieldCache.h"
+#include "RouteOptimizer.h"
+#include "TaskHistory.h"
+#include "infrastructure/IndexedDaryHeap.h"
+#include "infrastructure/Metrics.h"
+#include "infrastructure/ProfiledMutex.h"
 #include <memory>
 #include <vector>
-#include <queue>
 #include <mutex>
 #include <map>
 #include <functional>
@@ -13,57 +18,168 @@
 namespace OSBot {
 
 /**
- * @brief Comparador para la cola de prioridad de tareas
+ * @brief Orden de salida de las tareas pendientes
+ *
+ * PRIORITY: mayor prioridad primero; a igual prioridad, la más antigua.
+ * DEADLINE: plazo más próximo primero (EDF); las tareas sin plazo van
+ * detrás de todas las que lo tienen, por prioridad.
+ * AGING: la prioridad efectiva sube un nivel por cada AGING_STEP_MS de
+ * espera, así que una tarea LOW acaba adelantando a las HIGH que llegan
+ * después. Como todas envejecen al mismo ritmo, el orden relativo no
+ * cambia con el tiempo y basta una clave fija: creación - prioridad * paso.
+ * FAIR: weighted fair queuing entre las cuatro clases de prioridad (pesos
+ * 1/2/4/8): cada clase recibe una fracción de las asignaciones
+ * proporcional a su peso mientras tenga tareas en cola, y dentro de una
+ * clase se sirve en orden de llegada.
+ *
+ * Las cuatro se reducen a un rango fijo calculado al encolar, de modo que
+ * cada decisión sigue siendo O(log n) sobre la misma cola indexada.
  */
-struct TaskPriorityCompare {
-    bool operator()(const std::shared_ptr<Task>& a, const std::shared_ptr<Task>& b) const {
-        return static_cast<int>(a->getPriority()) < static_cast<int>(b->getPriority());
+enum class SchedulingPolicy { PRIORITY, DEADLINE, AGING, FAIR };
+
+/**
+ * @brief Entrada de la cola de tareas pendientes
+ */
+struct PendingTask {
+    double rank;           // Según la política; menor sale antes
+    TaskPriority priority; // Copia: se cambia con setTaskPriority
+    std::shared_ptr<Task> task;
+};
+
+/**
+ * @brief Orden de salida de la cola: menor rango y, a igualdad, mayor
+ * prioridad y la tarea más antigua (los IDs son crecientes)
+ */
+struct PendingTaskBefore {
+    bool operator()(const PendingTask& a, const PendingTask& b) const {
+        if (a.rank != b.rank) {
+            return a.rank < b.rank;
+        }
+        if (a.priority != b.priority) {
+            return static_cast<int>(a.priority) > static_cast<int>(b.priority);
+        }
+        return a.task->getId() < b.task->getId();
     }
 };
 
+/**
+ * @brief Estrategia de asignación de tareas pendientes a robots libres
+ *
+ * GREEDY: cada tarea (por prioridad) va al robot libre más cercano.
+ * BATCH: en cada ronda se toman tantas tareas como robots libres (por
+ * prioridad) y se resuelve la asignación de costo total mínimo
+ * (AssignmentSolver). La prioridad decide qué tareas entran en la ronda,
+ * no qué robot recibe cada una.
+ */
+enum class AssignmentMode { GREEDY, BATCH };
+
 /**
  * @brief Gestor de tareas y planificación
  * Implementa algoritmos de planificación de tareas para múltiples robots
  */
 class TaskManager {
 public:
-    explicit TaskManager(RobotManager& robotManager);
+    explicit TaskManager(RobotManager& robotManager,
+                         size_t historyCapacity = TaskHistory::DEFAULT_CAPACITY);
     ~TaskManager();
     
     // Gestión de tareas
-    int createTask(const std::vector<Point>& waypoints, TaskPriority priority = TaskPriority::NORMAL);
+    /**
+     * @param deadlineMs Plazo relativo a la creación (0 = sin plazo)
+     */
+    int createTask(const std::vector<Point>& waypoints, TaskPriority priority = TaskPriority::NORMAL,
+                   int deadlineMs = 0);
     bool cancelTask(int taskId);
+    bool setTaskPriority(int taskId, TaskPriority priority);
+    // Solo tareas vivas (pendientes o en curso); las terminadas se consultan
+    // en el historial con getTaskRecord
     std::shared_ptr<Task> getTask(int taskId) const;
     
     // Planificación
     void scheduleNextTasks();
     void update();
+    void setAssignmentMode(AssignmentMode mode);
+    AssignmentMode getAssignmentMode() const;
+    void setSchedulingPolicy(SchedulingPolicy policy);
+    SchedulingPolicy getSchedulingPolicy() const;
+    
+    /**
+     * @brief Reordenar los waypoints de las tareas nuevas (ver
+     * RouteOptimizer); las ya creadas no cambian
+     */
+    void setRouteOptimization(bool enabled, const RouteOptions& options = RouteOptions());
+    
+    // Espera que suma un nivel de prioridad en SchedulingPolicy::AGING
+    static constexpr int64_t AGING_STEP_MS = 10000;
     
     // Consultas
     size_t getPendingTaskCount() const;
+    /**
+     * @brief Espera en ms (reloj de la simulación) de la tarea más antigua
+     * en cola de cada clase, de LOW a URGENT (0 si la clase no tiene)
+     * task.wait_ms solo ve las tareas que salen de la cola; esto muestra
+     * las que siguen esperando. O(n) sobre la cola.
+     */
+    void getOldestPendingWaitMs(int64_t out[4]) const;
+    /**
+     * @brief Histograma task.wait_ms.<clase> de la espera en cola, en ms
+     * (HistogramUnit::MILLISECONDS); usarlo en vez de pedirlo por nombre
+     */
+    static LatencyHistogram& waitHistogram(TaskPriority priority);
     size_t getActiveTaskCount() const;
     size_t getCompletedTaskCount() const;
+    size_t getTaskCount(TaskStatus status) const; // Incluye las archivadas
     std::vector<std::shared_ptr<Task>> getAllTasks() const;
     std::vector<std::shared_ptr<Task>> getTasksByStatus(TaskStatus status) const;
     
+    // Historial de tareas terminadas (acotado, ver TaskHistory)
+    bool getTaskRecord(int taskId, TaskRecord& out) const;
+    std::vector<TaskRecord> getRecentHistory(size_t limit) const;
+    void visitHistory(const std::function<void(const TaskRecord&)>& visit) const;
+    
     // Estadísticas
     double getAverageCompletionTime() const;
     double getSuccessRate() const;
     
 private:
     RobotManager& robotManager_;
+    // Tareas vivas; al terminar se resumen en history_ y salen del mapa
     std::map<int, std::shared_ptr<Task>> allTasks_;
-    std::priority_queue<std::shared_ptr<Task>, 
-                        std::vector<std::shared_ptr<Task>>, 
-                        TaskPriorityCompare> pendingTasks_;
+    TaskHistory history_;
+    // Tareas asignadas o en curso, en orden de arranque: update() recorre
+    // solo esto. Las canceladas se quitan en la siguiente pasada de update()
+    std::vector<std::shared_ptr<Task>> activeTasks_;
+    std::vector<int> activeRobotIds_;          // Buffers de update()
+    std::vector<RobotProgress> activeProgress_;
+    TaskStats stats_; // Por estado, mantenido por Task::setStatus
+    // Solo tareas PENDING, indexadas por ID: cancelar o cambiar la prioridad
+    // es O(log n) y la cola no acumula tareas muertas
+    IndexedDaryHeap<PendingTask, PendingTaskBefore> pendingTasks_;
     
     int nextTaskId_;
-    mutable std::mutex tasksMutex_;
+    AssignmentMode assignmentMode_;
+    SchedulingPolicy schedulingPolicy_;
+    // Weighted fair queuing: tiempo virtual (rango de la última tarea
+    // asignada) y rango de la última tarea encolada por clase
+    double fairVirtualTime_;
+    double fairLastRank_[4];
+    bool optimizeRoutes_;
+    RouteOptions routeOptions_;
+    mutable DistanceFieldCache distanceFields_; // Costos por distancia real
+    RouteOptimizer routeOptimizer_;             // BFS propios, sin la cache
+    std::vector<AvailableRobot> availableRobots_; // Buffer del modo batch
+    mutable KernelMutex tasksMutex_{"TaskManager::tasksMutex_"};
+    
+    std::map<int, std::shared_ptr<Task>>::iterator
+    archiveTask(std::map<int, std::shared_ptr<Task>>::iterator it);
     
     // Algoritmos de planificación
+    PendingTask makePending(const std::shared_ptr<Task>& task);
+    void onTaskStarted(const PendingTask& entry);
     bool assignTaskToRobot(std::shared_ptr<Task> task);
-    int findBestRobotForTask(const Task& task) const;
-    double calculateTaskCost(int robotId, const Task& task) const;
+    void scheduleBatch();
+    int findBestRobotForTask(const Task& task, double* bestCostOut = nullptr) const;
+    static double travelCost(const Point& robotPos, const DistanceField& toTask);
 };
 
 } // namespace OSBot
@@ -0,0 +1,218 @@
+#ifndef RIDEBOT_WORLDSNAPSHOT_H
+#define RIDEBOT_WORLDSNAPSHOT_H
+
+#include "domain/Global.h"
+#include "infrastructure/GridCodec.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OSBot {
+
+class Environment;
+class RobotManager;
+
+/**
+ * @class WorldSnapshot
+ * @brief Foto inmutable del mundo publicada por el Kernel una vez por tick
+ *
+ * Los lectores (hilos del servidor HTTP) obtienen la foto vigente con un
+ * std::atomic_load sobre shared_ptr y no tocan mapMutex_ ni robotsMutex_.
+ * Las formas serializadas (JSON de estado, JSON de estadísticas y frames
+ * binarios) se calculan la primera vez que alguien las pide y se guardan en
+ * la propia foto: N peticiones en el mismo tick cuestan una serialización.
+ *
+ * El bitmap del grid se comparte entre fotos consecutivas mientras la
+ * versión del mapa no cambie, así que publicar no copia el grid en cada tick.
+ *
+ * Versión del mundo: crece solo cuando cambia algo visible en /api/state o
+ * /api/stats (grid, robots, objetivo, pausa, velocidad o agregados); el
+ * tick no cuenta, así que con todos los robots quietos la versión no se
+ * mueve. Dos fotos con la misma versión comparten el JSON de estado (y su
+ * gzip), y el servidor la usa como ETag para responder 304 sin serializar
+ * nada. Los frames binarios llevan el tick en la cabecera: se memoizan por
+ * foto y su ETag añade el tick a la versión.
+ */
+class WorldSnapshot {
+public:
+  /**
+   * @brief Bitmap del grid (formato GridCodec) de una versión del mapa
+   */
+  struct Grid {
+    uint64_t version = 0;
+    int width = 0;
+    int height = 0;
+    std::string packed;
+  };
+
+  /**
+   * @brief Datos de un robot necesarios para /api/state y /api/state.bin
+   */
+  struct Robot {
+    int id;
+    Point position;
+    Point goal;
+    State state;
+    int obstaclesAvoided;
+    bool active;
+    bool hasPersonalGoal;
+  };
+
+  /**
+   * @brief Agregados de /api/stats, calculados al capturar
+   */
+  struct Stats {
+    int totalRobots = 0;
+    int activeRobots = 0;
+    int idleRobots = 0;
+    double totalDistance = 0.0;
+    int completedTasks = 0;
+    int failedTasks = 0;
+    int cellsTraveled = 0;
+    int64_t uptimeSeconds = 0;
+  };
+
+  /**
+   * @brief Captura el estado actual del entorno y los robots
+   * @param previous Foto anterior (puede ser nullptr): si la versión del mapa
+   *        no cambió se reutiliza su grid sin copiar la máscara
+   */
+  static std::shared_ptr<const WorldSnapshot>
+  capture(const Environment &env, const RobotManager &robots, uint64_t tick,
+          bool paused, int speed, const WorldSnapshot *previous);
+
+  /**
+   * @brief true si el mundo es el mismo que en 'other' (ignora el tick y
+   * el uptime)
+   */
+  bool sameWorld(const WorldSnapshot &other) const;
+
+  /**
+   * @brief Identificador de este arranque del proceso (µs de reloj de pared
+   * al pedirlo por primera vez)
+   * Versión del mundo y del mapa reinician en cada arranque: los ETag y los
+   * frames lo llevan para que un cliente no confunda la versión N de otro
+   * arranque con la actual.
+   */
+  static uint64_t bootEpoch();
+
+  uint64_t getVersion() const { return version_; }
+  uint64_t getTick() const { return tick_; }
+  uint64_t getMapVersion() const { return grid_->version; }
+  const std::shared_ptr<const Grid> &getGrid() const { return grid_; }
+  const std::vector<Robot> &getRobots() const { return robots_; }
+  const Stats &getStats() const { return stats_; }
+
+  // ========== Formas serializadas (memoizadas) ==========
+
+  /**
+   * @brief JSON de /api/state (se serializa una sola vez por foto)
+   */
+  const std::string &stateJSON() const;
+
+  /**
+   * @brief JSON de /api/state comprimido con gzip
+   * Se comprime una sola vez por versión del mundo; 'level' solo se usa en
+   * la primera llamada (el servidor siempre pasa el mismo).
+   * @return Cadena vacía si no hay zlib o la compresión no reduce el tamaño
+   */
+  const std::string &stateJSONGzip(int level) const;
+
+  /**
+   * @brief JSON de /api/stats (se serializa una sola vez por foto)
+   */
+  const std::string &statsJSON() const;
+
+  /**
+   * @brief Frame binario con el grid completo (/api/state.bin sin 'since')
+   * Se serializa una sola vez por foto: la cabecera lleva el tick.
+   */
+  const std::string &frame() const;
+
+  /**
+   * @brief Frame binario para un cliente que ya tiene la versión actual del
+   * mapa: el grid es un delta vacío (caso habitual del sondeo)
+   */
+  const std::string &unchangedFrame() const;
+
+  // ========== Serialización sin memoizar ==========
+
+  /**
+   * @brief Escribe el JSON de estado en 'out' (se vacía, conserva capacidad)
+   */
+  void writeStateJSON(std::string &out) const;
+  void writeStatsJSON(std::string &out) const;
+
+  /**
+   * @brief Escribe el frame binario de /api/state.bin
+   * @param sinceEpoch Arranque del frame que tiene el cliente; si no es el
+   *        actual (ver bootEpoch()) se ignora 'sinceVersion'
+   * @param sinceVersion Versión del mapa que ya tiene el cliente (0 = ninguna)
+   * @param history Bitmaps de versiones anteriores para responder con delta
+   *        (nullptr = grid completo salvo que 'sinceVersion' sea la actual)
+   *
+   * Frame little-endian (formato 2):
+   *   Cabecera (64 bytes)
+   *     0  u32 magic "OSBS"        4  u16 formato (2)
+   *     6  u8  codificación grid   7  u8  flags (bit0 = pausado)
+   *     8  u64 tick               16  u64 versión del mapa
+   *    24  u64 versión base del delta (0 si el grid es completo)
+   *    32  u16 ancho              34  u16 alto
+   *    36  i16 goal x             38  i16 goal y
+   *    40  u32 velocidad (ms)     44  u32 número de robots
+   *    48  u32 bytes de grid      52  u32 bytes por robot (16)
+   *    56  u64 arranque (bootEpoch): las versiones solo valen dentro de él
+   *   Grid: GridCodec (bitmap completo o delta)
+   *   Robots (16 bytes c/u)
+   *     0  u32 id      4  i16 x      6  i16 y     8  i16 goal x
+   *    10  i16 goal y 12  u8 estado 13  u8 flags (bit0 activo,
+   *        bit1 objetivo personal)  14  u16 obstáculos esquivados
+   */
+  void writeFrame(std::string &out, uint64_t sinceEpoch,
+                  uint64_t sinceVersion, const GridHistory *history) const;
+
+private:
+  /**
+   * @brief Valor calculado la primera vez que se pide
+   * std::call_once: tras la primera llamada solo es una lectura atómica
+   */
+  struct Memo {
+    std::once_flag once;
+    std::string value;
+  };
+
+  /**
+   * @brief Formas que dependen solo del mundo (compartidas entre fotos de
+   * la misma versión)
+   */
+  struct WorldMemos {
+    Memo stateJSON;
+    Memo stateJSONGzip;
+  };
+
+  uint64_t version_ = 1;
+  uint64_t tick_ = 0;
+  bool paused_ = false;
+  int speed_ = 0;
+  Point goal_;
+  std::shared_ptr<const Grid> grid_;
+  std::vector<Robot> robots_;
+  Stats stats_;
+
+  std::shared_ptr<WorldMemos> worldMemos_ = std::make_shared<WorldMemos>();
+  mutable Memo statsJSON_;
+  mutable Memo frame_;
+  mutable Memo unchangedFrame_;
+
+  template <typename Build>
+  const std::string &memoize(Memo &memo, Build build) const {
+    std::call_once(memo.once, [&]() { build(memo.value); });
+    return memo.value;
+  }
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_WORLDSNAPSHOT_H
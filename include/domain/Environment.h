@@ -2,7 +2,10 @@
 #define ENVIRONMENT_H
 
 #include "Global.h"
+#include "Random.h"
+#include "infrastructure/ProfiledMutex.h"
 #include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -21,6 +24,7 @@ class Environment {
 public:
   /**
    * @brief Constructor - Inicializa el entorno con dimensiones especificadas
+   * NOTA: La aleatoriedad sale del flujo RandomStream::ENVIRONMENT
    */
   Environment(int width, int height);
 
@@ -103,6 +107,20 @@ public:
    */
   std::vector<std::vector<int>> getGridSnapshot() const;
 
+  /**
+   * @brief Copia el grid como máscara plana fila a fila (1=obstáculo)
+   * @param mask Buffer del llamador; se reutiliza su capacidad entre llamadas
+   * @return Versión del mapa correspondiente a la copia
+   * NOTA: Mismo contenido que getGridSnapshot() sin una reserva por fila
+   */
+  uint64_t copyObstacleMask(std::vector<uint8_t> &mask) const;
+
+  /**
+   * @brief Versión del mapa: aumenta cada vez que una celda cambia entre
+   * libre y obstáculo. Permite a los clientes detectar cambios sin copiar.
+   */
+  uint64_t getMapVersion() const;
+
   // ========== Métodos de edición interactiva ==========
   
   /**
@@ -119,20 +137,37 @@ public:
   
   /**
    * @brief Genera obstáculos aleatorios
-   * @param percentage Porcentaje de celdas con obstáculos (0-100)
+   * @param percentage Porcentaje de celdas interiores con obstáculos (0-100)
+   * @return false (sin tocar el mapa) si no caben: las celdas del robot y
+   *         del objetivo nunca se ocupan
    */
-  void generateRandomObstacles(int percentage = 25);
+  bool generateRandomObstacles(int percentage = 25);
+
+  /**
+   * @brief Elige una posición libre aleatoria (evitando bordes)
+   * @return Posición libre, o (5,5) si no se encuentra en 100 intentos
+   * NOTA: Usa el flujo aleatorio del entorno (determinista con semilla)
+   */
+  Point randomFreePosition();
 
 private:
   int width_;
   int height_;
   std::vector<Node> graph_; // Grafo de nodos
+  // Copia compacta de las celdas (1=obstáculo), en el orden de graph_.
+  // Se mantiene sincronizada en setCellType(); copyObstacleMask() la copia
+  // sin recorrer los nodos completos
+  std::vector<uint8_t> obstacleMask_;
+  uint64_t mapVersion_ = 0; // Protegido por mapMutex_
   Point robotPosition_;
   Point goalPosition_;
 
   // *** SINCRONIZACIÓN ***
   // Mutex para proteger el acceso concurrente al mapa compartido
-  mutable std::mutex mapMutex_;
+  mutable KernelMutex mapMutex_{"Environment::mapMutex_"};
+
+  // Flujo aleatorio propio (derivado de la semilla maestra)
+  Xoshiro256 rng_;
 
   // Threading
   std::thread updateThread_;
@@ -152,6 +187,12 @@ private:
    */
   Node *getNode(int x, int y);
 
+  /**
+   * @brief Cambia el tipo de una celda (único punto de escritura del grid)
+   * NOTA: Requiere mapMutex_ tomado
+   */
+  void setCellType(Node *node, CellType type);
+
   /**
    * @brief Bucle de actualización periódica del entorno
    */
@@ -0,0 +1,162 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @file Random.h
+ * @brief Servicio central de números aleatorios reproducibles
+ *
+ * Todos los componentes obtienen su propio flujo (stream) derivado de una
+ * única semilla maestra. Cada flujo es un xoshiro256** de 32 bytes: se
+ * crea una vez (normalmente como miembro) y generar valores no hace
+ * syscalls ni reserva memoria.
+ */
+
+namespace OSBot {
+
+/**
+ * @brief Identificadores de flujo por componente
+ * NOTA: Agregar nuevos valores al final para no alterar los flujos existentes
+ */
+enum class RandomStream : uint64_t {
+  ENVIRONMENT = 1, // Meta inicial y obstáculos
+  ROBOT_MANAGER,   // Reposicionamiento de robots
+  GPS,             // Ruido de los sensores GPS
+  SCENARIO         // Generación de carga sintética
+};
+
+/**
+ * @class Xoshiro256
+ * @brief Generador xoshiro256** (Blackman & Vigna)
+ *
+ * Cumple UniformRandomBitGenerator, pero se recomienda usar los métodos
+ * propios (uniformInt, uniformReal, normal): a diferencia de las
+ * distribuciones de <random>, dan la misma secuencia en toda plataforma.
+ */
+class Xoshiro256 {
+public:
+  using result_type = uint64_t;
+
+  explicit Xoshiro256(uint64_t seed = 0) { reseed(seed); }
+
+  /**
+   * @brief Reinicia el estado expandiendo la semilla con splitmix64
+   */
+  void reseed(uint64_t seed) {
+    for (auto &word : state_) {
+      word = splitmix64(seed);
+    }
+    hasSpare_ = false;
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    const uint64_t result = rotl(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = rotl(state_[3], 45);
+    return result;
+  }
+
+  /**
+   * @brief Entero uniforme en [lo, hi] (método de Lemire, sin sesgo)
+   */
+  int uniformInt(int lo, int hi) {
+    if (hi <= lo)
+      return lo;
+    const uint64_t range =
+        static_cast<uint64_t>(static_cast<int64_t>(hi) - lo) + 1;
+    uint64_t x = (*this)() >> 32;
+    uint64_t m = x * range;
+    uint32_t low = static_cast<uint32_t>(m);
+    if (low < range) {
+      const uint32_t threshold =
+          static_cast<uint32_t>(-static_cast<uint32_t>(range) % range);
+      while (low < threshold) {
+        x = (*this)() >> 32;
+        m = x * range;
+        low = static_cast<uint32_t>(m);
+      }
+    }
+    return static_cast<int>(lo + static_cast<int64_t>(m >> 32));
+  }
+
+  /**
+   * @brief Real uniforme en [0, 1) con 53 bits de precisión
+   */
+  double uniformReal() { return ((*this)() >> 11) * 0x1.0p-53; }
+
+  /**
+   * @brief Muestra gaussiana (método polar de Marsaglia)
+   */
+  double normal(double mean, double stddev) {
+    if (hasSpare_) {
+      hasSpare_ = false;
+      return mean + stddev * spare_;
+    }
+    double u, v, s;
+    do {
+      u = uniformReal() * 2.0 - 1.0;
+      v = uniformReal() * 2.0 - 1.0;
+      s = u * u + v * v;
+    } while (s >= 1.0 || s == 0.0);
+    const double factor = std::sqrt(-2.0 * std::log(s) / s);
+    spare_ = v * factor;
+    hasSpare_ = true;
+    return mean + stddev * u * factor;
+  }
+
+  /**
+   * @brief Paso de splitmix64 (también usado para derivar semillas)
+   */
+  static uint64_t splitmix64(uint64_t &x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+private:
+  uint64_t state_[4];
+  double spare_ = 0.0;
+  bool hasSpare_ = false;
+
+  static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+namespace Random {
+
+/**
+ * @brief Fija la semilla maestra (0 = elegir una con std::random_device)
+ * NOTA: Debe llamarse antes de crear los componentes que piden flujos
+ */
+void setMasterSeed(uint64_t seed);
+
+/**
+ * @brief Semilla maestra efectiva (útil para reproducir una ejecución)
+ */
+uint64_t masterSeed();
+
+/**
+ * @brief Crea un flujo independiente para un componente
+ * @param id Componente solicitante
+ * @param instance Índice de instancia (p. ej. ID del robot o sensor)
+ */
+Xoshiro256 stream(RandomStream id, uint64_t instance = 0);
+
+} // namespace Random
+
+} // namespace OSBot
+
+#endif // RANDOM_H
@@ -41,6 +41,23 @@ public:
    */
   void stop();
 
+  /**
+   * @brief Prepara el robot para ser avanzado manualmente con step()
+   * Usado en modo headless: no se crea hilo propio
+   */
+  void startStepped();
+
+  /**
+   * @brief Ejecuta una iteración del bucle de navegación, sin esperas
+   * En modo headless el Kernel llama a step() de cada robot una vez por tick
+   */
+  void step();
+
+  /**
+   * @brief Activa/desactiva los mensajes de consola de todos los robots
+   */
+  static void setLoggingEnabled(bool enabled) { loggingEnabled_ = enabled; }
+
   /**
    * @brief Establece la posición del robot (usado para inicialización)
    */
@@ -130,6 +147,12 @@ private:
   Point personalGoal_;
   bool hasPersonalGoal_;
 
+  // Último objetivo conocido (para detectar cambios de objetivo)
+  Point lastGoal_;
+
+  // Mensajes de consola (desactivados en modo headless)
+  static std::atomic<bool> loggingEnabled_;
+
   // Control de hilos
   std::unique_ptr<std::thread> robotThread_;
   std::atomic<bool> running_;
@@ -0,0 +1,58 @@
+#ifndef SIMULATION_CLOCK_H
+#define SIMULATION_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace OSBot {
+
+/**
+ * @class SimulationClock
+ * @brief Reloj global de la simulación (tiempo real o virtual)
+ *
+ * En modo normal delega en std::chrono::system_clock. En modo headless
+ * el Kernel avanza el reloj un paso fijo por tick, de modo que todos los
+ * timestamps (tareas, robots) son deterministas e independientes de la
+ * velocidad de la CPU.
+ */
+class SimulationClock {
+public:
+  using TimePoint = std::chrono::system_clock::time_point;
+
+  /**
+   * @brief Obtiene el instante actual (virtual o de pared según el modo)
+   */
+  static TimePoint now();
+
+  /**
+   * @brief Activa/desactiva el tiempo virtual (reinicia el reloj a 0)
+   */
+  static void useVirtualTime(bool enabled);
+
+  /**
+   * @brief Indica si el reloj está en modo virtual
+   */
+  static bool isVirtual() { return virtual_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Avanza el reloj virtual un paso fijo
+   * NOTA: No tiene efecto en modo de tiempo real
+   */
+  static void advance(std::chrono::milliseconds step);
+
+  /**
+   * @brief Milisegundos virtuales transcurridos desde el inicio
+   */
+  static int64_t elapsedMs() {
+    return virtualMs_.load(std::memory_order_relaxed);
+  }
+
+private:
+  static std::atomic<bool> virtual_;
+  static std::atomic<int64_t> virtualMs_;
+};
+
+} // namespace OSBot
+
+#endif // SIMULATION_CLOCK_H
@@ -2,6 +2,8 @@
 #define TASK_H
 
 #include "Global.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -31,6 +33,26 @@ enum class TaskStatus {
     CANCELLED      // Cancelada
 };
 
+class Task;
+
+/**
+ * @brief Contadores agregados de un conjunto de tareas
+ *
+ * Task::setStatus los actualiza en cada transición de las tareas que lo
+ * tienen asociado (attachStats), así las estadísticas se consultan en O(1)
+ * sin recorrer todas las tareas.
+ * NOTA: No es thread-safe; lo protege el mutex del dueño de las tareas.
+ */
+struct TaskStats {
+    static constexpr size_t STATUS_COUNT = 6;
+    
+    size_t byStatus[STATUS_COUNT] = {};
+    int64_t completedSeconds = 0; // Suma de (fin - inicio) de las completadas
+    
+    size_t count(TaskStatus status) const { return byStatus[static_cast<size_t>(status)]; }
+    void onTransition(const Task& task, TaskStatus from, TaskStatus to);
+};
+
 /**
  * @brief Representa una tarea que debe realizar un robot
  */
@@ -50,14 +72,36 @@ public:
     TimePoint getCreatedTime() const { return createdTime_; }
     TimePoint getStartTime() const { return startTime_; }
     TimePoint getCompletionTime() const { return completionTime_; }
+    TimePoint getDeadline() const { return deadline_; }
+    bool hasDeadline() const { return deadline_ != TimePoint{}; }
     double getEstimatedDuration() const { return estimatedDuration_; }
+    int64_t getEstimatedRouteCells() const { return estimatedRouteCells_; }
+    int getRouteStartCells() const { return routeStartCells_; }
     int getCurrentWaypointIndex() const { return currentWaypointIndex_; }
     
     // Setters
     void setStatus(TaskStatus status);
     void setAssignedRobot(int robotId);
+    void setPriority(TaskPriority priority) { priority_ = priority; }
+    void setDeadline(TimePoint deadline) { deadline_ = deadline; }
     void advanceToNextWaypoint();
+    
+    /**
+     * @brief Asocia (o con nullptr, desasocia) los contadores que setStatus
+     * mantiene al día; la tarea se cuenta en su estado actual
+     * NOTA: Las copias de la tarea comparten el puntero; solo el dueño de
+     * los contadores debe cambiar el estado de una tarea asociada
+     */
+    void attachStats(TaskStats* stats);
+    
+    /**
+     * @brief Deja de actualizar los contadores sin descontarse: la tarea
+     * sigue contada en su estado final (p. ej. al archivarla)
+     */
+    void detachStats() { stats_ = nullptr; }
     void setEstimatedDuration(double seconds) { estimatedDuration_ = seconds; }
+    void setEstimatedRouteCells(int64_t cells) { estimatedRouteCells_ = cells; }
+    void setRouteStartCells(int robotCells) { routeStartCells_ = robotCells; }
     
     // Utilidades
     bool isCompleted() const { return status_ == TaskStatus::COMPLETED; }
@@ -79,7 +123,13 @@ private:
     TimePoint createdTime_;
     TimePoint startTime_;
     TimePoint completionTime_;
+    TimePoint deadline_;        // Sin plazo si es TimePoint{}
     double estimatedDuration_;  // En segundos
+    // Recorrido del primer al último waypoint: estimado al crearla (-1 si
+    // no se calculó) y contador de celdas del robot al llegar al primero
+    int64_t estimatedRouteCells_;
+    int routeStartCells_;
+    TaskStats* stats_;          // Puede ser nullptr
 };
 
 } // namespace OSBot
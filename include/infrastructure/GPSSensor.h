@@ -2,6 +2,7 @@
 #define RIDEBOT_GPSSENSOR_H
 
 #include "domain/Global.h"
+#include "domain/Random.h"
 
 namespace OSBot {
 
@@ -18,9 +19,10 @@ public:
    * @param base_lat Latitud base (coordenada de referencia)
    * @param base_lon Longitud base (coordenada de referencia)
    * @param scale_factor Factor de escala para conversión grid→GPS
+   * @param sensor_id Índice del flujo aleatorio de ruido (p. ej. ID del robot)
    */
   GPSSensor(double base_lat = 10.4806, double base_lon = -66.9036,
-            double scale_factor = 0.001);
+            double scale_factor = 0.001, int sensor_id = 0);
 
   /**
    * @brief Obtiene datos de posición GPS basados en la posición del robot
@@ -34,6 +36,7 @@ private:
   double base_longitude_;
   double scale_factor_;
   bool add_noise_;
+  Xoshiro256 rng_; // Flujo de ruido propio (sin syscalls por lectura)
 };
 
 } // namespace OSBot
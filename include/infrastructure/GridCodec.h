@@ -0,0 +1,142 @@
+#ifndef RIDEBOT_GRIDCODEC_H
+#define RIDEBOT_GRIDCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OSBot {
+
+// ============================================================================
+// Enteros little-endian portables (independientes del endianness del host)
+// ============================================================================
+
+inline void storeU16(uint8_t *p, uint16_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void storeU32(uint8_t *p, uint32_t v) {
+  for (int i = 0; i < 4; ++i)
+    p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+inline void storeU64(uint8_t *p, uint64_t v) {
+  for (int i = 0; i < 8; ++i)
+    p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+inline uint16_t loadU16(const uint8_t *p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t loadU32(const uint8_t *p) {
+  uint32_t v = 0;
+  for (int i = 3; i >= 0; --i)
+    v = (v << 8) | p[i];
+  return v;
+}
+
+inline uint64_t loadU64(const uint8_t *p) {
+  uint64_t v = 0;
+  for (int i = 7; i >= 0; --i)
+    v = (v << 8) | p[i];
+  return v;
+}
+
+/**
+ * @brief Codificación de la sección de grid
+ */
+enum class GridEncoding : uint8_t {
+  FULL = 0, // Bitmap completo
+  DELTA = 1 // Lista de celdas que cambiaron respecto a una versión base
+};
+
+/**
+ * @class GridCodec
+ * @brief Codificador del grid compartido por /api/state.bin y .osbot v2
+ *
+ * Bitmap completo: ceil(width*height/8) bytes. La celda (x,y) es el bit
+ * i = y*width + x; bit (i % 8) del byte (i / 8), empezando por el bit menos
+ * significativo. 1 = obstáculo. Los bits de relleno del último byte son 0.
+ *
+ * Delta: u32 N seguido de N índices u32 (i = y*width + x) de las celdas que
+ * cambiaron de estado; aplicar el delta es alternar esas celdas.
+ */
+class GridCodec {
+public:
+  static size_t packedSize(int width, int height);
+
+  /**
+   * @brief Agrega a 'out' el bitmap de una máscara (1 byte por celda)
+   */
+  static void pack(const std::vector<uint8_t> &mask, int width, int height,
+                   std::string &out);
+
+  /**
+   * @brief Reconstruye la máscara desde un bitmap
+   * @return false si 'size' no corresponde a las dimensiones
+   */
+  static bool unpack(const uint8_t *data, size_t size, int width, int height,
+                     std::vector<uint8_t> &mask);
+
+  /**
+   * @brief Agrega a 'out' el delta entre dos bitmaps del mismo tamaño
+   * @return Número de celdas que cambiaron
+   */
+  static uint32_t appendDelta(const std::string &basePacked,
+                              const std::string &packed, std::string &out);
+
+  /**
+   * @brief Aplica un delta (u32 N + N índices) sobre una máscara
+   * @return Bytes consumidos, o 0 si el delta está truncado o fuera de rango
+   */
+  static size_t applyDelta(const uint8_t *data, size_t size,
+                           std::vector<uint8_t> &mask);
+};
+
+/**
+ * @class GridHistory
+ * @brief Últimos bitmaps publicados, indexados por versión del mapa
+ *
+ * Permite responder con un delta a clientes que ya tienen una versión
+ * reciente, y reutilizar el bitmap mientras el mapa no cambie.
+ * Thread-safe: lo comparten los hilos del servidor HTTP.
+ */
+class GridHistory {
+public:
+  explicit GridHistory(size_t capacity = 16) : capacity_(capacity) {}
+
+  /**
+   * @brief Registra el bitmap de una versión (ignora versiones repetidas)
+   */
+  void record(uint64_t version, std::string packed);
+
+  /**
+   * @brief Agrega la sección de grid de 'version' a 'out'
+   * Usa un delta desde 'baseVersion' si está en el historial y ocupa menos
+   * que el bitmap completo.
+   * @return false (sin escribir nada) si 'version' no está en el historial
+   */
+  bool writeSection(uint64_t version, uint64_t baseVersion, std::string &out,
+                    GridEncoding &encoding) const;
+
+private:
+  struct Entry {
+    uint64_t version;
+    std::string packed;
+  };
+
+  size_t capacity_;
+  mutable std::mutex mutex_;
+  std::deque<Entry> entries_; // La más reciente al final
+
+  const Entry *find(uint64_t version) const;
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_GRIDCODEC_H
@@ -0,0 +1,39 @@
+#ifndef RIDEBOT_GZIP_H
+#define RIDEBOT_GZIP_H
+
+#include <string>
+#include <string_view>
+
+namespace OSBot {
+
+/**
+ * @class Gzip
+ * @brief Compresión gzip (RFC 1952) sobre zlib, opcional en compilación
+ *
+ * Sin OSBOT_HAVE_ZLIB (meson -Dzlib=disabled o sin la biblioteca)
+ * isAvailable() devuelve false y compress() no hace nada: el servidor
+ * sirve entonces todo sin comprimir.
+ */
+class Gzip {
+public:
+  static constexpr int DEFAULT_LEVEL = 6;
+
+  static bool isAvailable();
+
+  /**
+   * @brief Comprime 'input' en 'out' (se reemplaza su contenido)
+   * @param level 1 (rápido) a 9 (máxima compresión)
+   * @return false si no hay zlib o falló la compresión
+   */
+  static bool compress(std::string_view input, std::string &out,
+                       int level = DEFAULT_LEVEL);
+
+  /**
+   * @brief true si la cabecera Accept-Encoding admite gzip (q > 0)
+   */
+  static bool isAccepted(std::string_view acceptEncoding);
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_GZIP_H
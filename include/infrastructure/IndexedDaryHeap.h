@@ -0,0 +1,169 @@
+#ifndef RIDEBOT_INDEXEDDARYHEAP_H
+#define RIDEBOT_INDEXEDDARYHEAP_H
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace OSBot {
+
+/**
+ * @class IndexedDaryHeap
+ * @brief Cola de prioridad d-aria indexada por clave entera
+ *
+ * A diferencia de std::priority_queue permite borrar y cambiar la
+ * prioridad de cualquier elemento por su clave en O(log_d n): un mapa
+ * clave -> posición se mantiene al día en cada intercambio.
+ *
+ * 'Before' es un orden estricto: Before(a, b) == true si 'a' debe salir
+ * antes que 'b'. Con aridad 4 el árbol es la mitad de alto que uno binario
+ * y los hijos de un nodo comparten línea de caché.
+ *
+ * La memoria es proporcional a los elementos presentes, no a las claves
+ * usadas alguna vez.
+ */
+template <typename Value, typename Before, size_t Arity = 4>
+class IndexedDaryHeap {
+  static_assert(Arity >= 2, "IndexedDaryHeap requiere aridad >= 2");
+
+public:
+  struct Entry {
+    int key;
+    Value value;
+  };
+
+  explicit IndexedDaryHeap(Before before = Before()) : before_(before) {}
+
+  bool empty() const { return entries_.empty(); }
+  size_t size() const { return entries_.size(); }
+  bool contains(int key) const { return positions_.count(key) != 0; }
+
+  /**
+   * @brief Primer elemento (requiere !empty())
+   */
+  const Entry &top() const { return entries_.front(); }
+
+  /**
+   * @brief Valor asociado a 'key', o nullptr si no está
+   */
+  const Value *find(int key) const {
+    auto it = positions_.find(key);
+    return it != positions_.end() ? &entries_[it->second].value : nullptr;
+  }
+
+  /**
+   * @brief Inserta un elemento nuevo
+   * @return false (sin cambios) si la clave ya estaba
+   */
+  bool push(int key, Value value) {
+    if (!positions_.emplace(key, entries_.size()).second)
+      return false;
+    entries_.push_back({key, std::move(value)});
+    siftUp(entries_.size() - 1);
+    return true;
+  }
+
+  void pop() { removeAt(0); }
+
+  /**
+   * @brief Quita el elemento con clave 'key'
+   * @return false si no estaba
+   */
+  bool erase(int key) {
+    auto it = positions_.find(key);
+    if (it == positions_.end())
+      return false;
+    removeAt(it->second);
+    return true;
+  }
+
+  /**
+   * @brief Reemplaza el valor de 'key' y reubica el elemento (sube o baja)
+   * @return false si no estaba
+   */
+  bool update(int key, Value value) {
+    auto it = positions_.find(key);
+    if (it == positions_.end())
+      return false;
+    size_t index = it->second;
+    entries_[index].value = std::move(value);
+    if (!siftUp(index))
+      siftDown(index);
+    return true;
+  }
+
+  void clear() {
+    entries_.clear();
+    positions_.clear();
+  }
+
+  /**
+   * @brief Elementos en orden de heap (no de salida)
+   */
+  const std::vector<Entry> &entries() const { return entries_; }
+
+private:
+  std::vector<Entry> entries_;
+  std::unordered_map<int, size_t> positions_;
+  Before before_;
+
+  void place(size_t index, Entry entry) {
+    positions_[entry.key] = index;
+    entries_[index] = std::move(entry);
+  }
+
+  void removeAt(size_t index) {
+    positions_.erase(entries_[index].key);
+    size_t last = entries_.size() - 1;
+    if (index != last) {
+      Entry moved = std::move(entries_[last]);
+      entries_.pop_back();
+      place(index, std::move(moved));
+      if (!siftUp(index))
+        siftDown(index);
+    } else {
+      entries_.pop_back();
+    }
+  }
+
+  // Sube con un hueco (un movimiento por nivel en lugar de un swap)
+  bool siftUp(size_t index) {
+    size_t start = index;
+    Entry entry = std::move(entries_[index]);
+    while (index > 0) {
+      size_t parent = (index - 1) / Arity;
+      if (!before_(entry.value, entries_[parent].value))
+        break;
+      place(index, std::move(entries_[parent]));
+      index = parent;
+    }
+    place(index, std::move(entry));
+    return index != start;
+  }
+
+  void siftDown(size_t index) {
+    Entry entry = std::move(entries_[index]);
+    size_t count = entries_.size();
+    while (true) {
+      size_t first = index * Arity + 1;
+      if (first >= count)
+        break;
+      size_t best = first;
+      size_t end = first + Arity < count ? first + Arity : count;
+      for (size_t child = first + 1; child < end; ++child) {
+        if (before_(entries_[child].value, entries_[best].value))
+          best = child;
+      }
+      if (!before_(entries_[best].value, entry.value))
+        break;
+      place(index, std::move(entries_[best]));
+      index = best;
+    }
+    place(index, std::move(entry));
+  }
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_INDEXEDDARYHEAP_H
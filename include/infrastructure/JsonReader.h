@@ -0,0 +1,170 @@
+#ifndef RIDEBOT_JSONREADER_H
+#define RIDEBOT_JSONREADER_H
+
+#include <cstddef>
+#include <string_view>
+
+namespace OSBot {
+
+/**
+ * @class JsonReader
+ * @brief Parser JSON "pull" sin reservas de memoria
+ *
+ * Recorre el texto una sola vez sobre un std::string_view; los números se
+ * convierten con std::from_chars y las cadenas se devuelven como vistas al
+ * texto original (sin decodificar escapes). No lanza excepciones: el primer
+ * error queda registrado (mensaje + posición) y todas las lecturas
+ * siguientes fallan.
+ *
+ * Uso típico en un handler:
+ *   JsonReader json(req.body);
+ *   int x = 0, y = 0;
+ *   bool ok = json.readObject([&](std::string_view key) {
+ *     if (key == "x") return json.readInt(x);
+ *     if (key == "y") return json.readInt(y);
+ *     return json.skipValue(); // Campos desconocidos se ignoran
+ *   }) && json.finish();
+ */
+class JsonReader {
+public:
+  static constexpr int MAX_DEPTH = 32;
+
+  explicit JsonReader(std::string_view input) : input_(input) {}
+
+  // ========== Valores escalares ==========
+
+  bool readInt(int &value);
+  bool readDouble(double &value);
+  bool readBool(bool &value);
+
+  /**
+   * @brief Lee una cadena (vista al contenido entre comillas, sin decodificar)
+   */
+  bool readString(std::string_view &value);
+
+  /**
+   * @brief Consume un valor completo de cualquier tipo
+   */
+  bool skipValue();
+
+  // ========== Contenedores ==========
+
+  /**
+   * @brief Recorre un objeto llamando a onField(clave) por cada miembro
+   * onField debe consumir el valor (readX o skipValue) y devolver true;
+   * devolver false aborta la lectura.
+   */
+  template <typename OnField> bool readObject(OnField &&onField);
+
+  /**
+   * @brief Recorre un array llamando a onElement(índice) por cada elemento
+   */
+  template <typename OnElement> bool readArray(OnElement &&onElement);
+
+  // ========== Estado ==========
+
+  /**
+   * @brief Verifica que solo quede espacio en blanco tras el valor raíz
+   */
+  bool finish();
+
+  /**
+   * @brief Tipo del siguiente valor sin consumirlo ('{', '[', '"', 'n'...)
+   * @return '\0' al final de la entrada
+   */
+  char peek();
+
+  /**
+   * @brief Registra un error de validación del llamador (p. ej. rango)
+   * @return false, para poder usarlo en un return
+   */
+  bool fail(const char *message);
+
+  bool failed() const { return error_ != nullptr; }
+  const char *error() const { return error_ ? error_ : ""; }
+  size_t errorOffset() const { return errorOffset_; }
+
+private:
+  std::string_view input_;
+  size_t pos_ = 0;
+  int depth_ = 0;
+  const char *error_ = nullptr;
+  size_t errorOffset_ = 0;
+
+  void skipWhitespace();
+  bool consume(char expected, const char *message);
+  bool consumeLiteral(std::string_view literal);
+
+  /**
+   * @brief Delimita un número JSON válido a partir de la posición actual
+   */
+  bool scanNumber(std::string_view &number);
+
+  bool enter();
+  void leave() { depth_--; }
+};
+
+// ============================================================================
+// Implementación de las plantillas
+// ============================================================================
+
+template <typename OnField> bool JsonReader::readObject(OnField &&onField) {
+  if (!consume('{', "se esperaba un objeto") || !enter())
+    return false;
+
+  skipWhitespace();
+  if (pos_ < input_.size() && input_[pos_] == '}') {
+    pos_++;
+    leave();
+    return true;
+  }
+
+  while (true) {
+    std::string_view key;
+    if (!readString(key) || !consume(':', "se esperaba ':'"))
+      return false;
+    if (!onField(key))
+      return fail("valor inválido");
+
+    skipWhitespace();
+    if (pos_ < input_.size() && input_[pos_] == ',') {
+      pos_++;
+      continue;
+    }
+    if (!consume('}', "se esperaba ',' o '}'"))
+      return false;
+    leave();
+    return true;
+  }
+}
+
+template <typename OnElement> bool JsonReader::readArray(OnElement &&onElement) {
+  if (!consume('[', "se esperaba un array") || !enter())
+    return false;
+
+  skipWhitespace();
+  if (pos_ < input_.size() && input_[pos_] == ']') {
+    pos_++;
+    leave();
+    return true;
+  }
+
+  for (size_t index = 0;; ++index) {
+    if (!onElement(index))
+      return fail("elemento inválido");
+
+    skipWhitespace();
+    if (pos_ < input_.size() && input_[pos_] == ',') {
+      pos_++;
+      continue;
+    }
+    if (!consume(']', "se esperaba ',' o ']'"))
+      return false;
+    leave();
+    return true;
+  }
+}
+
+} // namespace OSBot
+
+#endif // RIDEBOT_JSONREADER_H
@@ -0,0 +1,270 @@
+#ifndef RIDEBOT_JSONWRITER_H
+#define RIDEBOT_JSONWRITER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace OSBot {
+
+/**
+ * @class JsonWriter
+ * @brief Escritor JSON en streaming sobre un buffer reutilizable
+ *
+ * Escribe directamente en el std::string del llamador (sin ostringstream
+ * ni locale); los números se formatean con std::to_chars. Cada escritura
+ * comprueba el espacio una sola vez y copia con punteros. Si el buffer ya
+ * tiene capacidad suficiente, serializar no reserva memoria.
+ * Las comas entre miembros y elementos se insertan automáticamente.
+ *
+ *   std::string buffer;            // Reutilizable entre respuestas
+ *   JsonWriter json(buffer);
+ *   json.beginObject();
+ *   json.field("x", 10);
+ *   json.field("ratio", 0.5, 2);   // Con 2 decimales fijos
+ *   json.endObject();              // {"x":10,"ratio":0.50}
+ *
+ * NOTA: No valida la estructura; el llamador debe equilibrar begin/end.
+ */
+class JsonWriter {
+public:
+  /**
+   * @brief Escribe a continuación del contenido actual de 'out'
+   * Mientras el escritor vive, 'out' se usa como buffer crudo (ocupa toda
+   * su capacidad); el destructor lo recorta a lo escrito.
+   */
+  explicit JsonWriter(std::string &out) : out_(out), used_(out.size()) {
+    out_.resize(std::max(out_.capacity(), MIN_CAPACITY));
+  }
+
+  ~JsonWriter() { out_.resize(used_); }
+
+  JsonWriter(const JsonWriter &) = delete;
+  JsonWriter &operator=(const JsonWriter &) = delete;
+
+  // ========== Estructura ==========
+
+  void beginObject() { open('{'); }
+  void endObject() { close('}'); }
+  void beginArray() { open('['); }
+  void endArray() { close(']'); }
+
+  /**
+   * @brief Escribe "key": (la clave no se escapa: debe ser un literal)
+   */
+  void key(std::string_view name) {
+    char *p = reserve(name.size() + 4);
+    if (needComma_)
+      *p++ = ',';
+    *p++ = '"';
+    std::memcpy(p, name.data(), name.size());
+    p += name.size();
+    *p++ = '"';
+    *p++ = ':';
+    commit(p);
+    needComma_ = false;
+  }
+
+  // ========== Valores ==========
+
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T> &&
+                                                    !std::is_same_v<T, bool>>>
+  void value(T number) {
+    char *p = reserve(MAX_NUMBER + 1);
+    if (needComma_)
+      *p++ = ',';
+    commit(std::to_chars(p, p + MAX_NUMBER, number).ptr);
+    needComma_ = true;
+  }
+
+  /**
+   * @brief Decimal con 'precision' dígitos fijos (equivale a std::fixed)
+   */
+  void value(double number, int precision) {
+    char *p = reserve(MAX_NUMBER + 1);
+    if (needComma_)
+      *p++ = ',';
+    auto result = std::to_chars(p, p + MAX_NUMBER, number,
+                                std::chars_format::fixed, precision);
+    if (result.ec != std::errc()) {
+      // Magnitud que no cabe en MAX_NUMBER: no es un dato válido aquí
+      std::memcpy(p, "null", 4);
+      result.ptr = p + 4;
+    }
+    commit(result.ptr);
+    needComma_ = true;
+  }
+
+  void value(bool flag) {
+    raw(flag ? std::string_view("true") : std::string_view("false"));
+  }
+
+  /**
+   * @brief Cadena entre comillas, escapando '"', '\' y caracteres de control
+   */
+  void value(std::string_view text) {
+    // Peor caso: cada carácter se convierte en \u00XX
+    char *p = reserve(6 * text.size() + 3);
+    if (needComma_)
+      *p++ = ',';
+    *p++ = '"';
+    for (char c : text) {
+      if (c == '"' || c == '\\') {
+        *p++ = '\\';
+        *p++ = c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        static const char hex[] = "0123456789abcdef";
+        std::memcpy(p, "\\u00", 4);
+        p[4] = hex[(c >> 4) & 0xF];
+        p[5] = hex[c & 0xF];
+        p += 6;
+      } else {
+        *p++ = c;
+      }
+    }
+    *p++ = '"';
+    commit(p);
+    needComma_ = true;
+  }
+
+  void value(const char *text) { value(std::string_view(text)); }
+
+  template <typename T> void field(std::string_view name, const T &v) {
+    key(name);
+    value(v);
+  }
+
+  void field(std::string_view name, double number, int precision) {
+    key(name);
+    value(number, precision);
+  }
+
+  // ========== Acceso de bajo nivel ==========
+
+  /**
+   * @brief Reserva 'size' bytes al final para escribirlos directamente
+   * Cuenta como un valor (antepone la coma si hace falta). Útil para
+   * bloques grandes y regulares como el grid. El puntero es válido hasta
+   * la siguiente escritura.
+   */
+  char *appendRaw(size_t size) {
+    char *p = reserve(size + 1);
+    if (needComma_)
+      *p++ = ',';
+    commit(p + size);
+    needComma_ = true;
+    return p;
+  }
+
+  /**
+   * @brief Bytes escritos hasta ahora
+   */
+  size_t size() const { return used_; }
+
+private:
+  static constexpr size_t MIN_CAPACITY = 256;
+  static constexpr size_t MAX_NUMBER = 48; // Enteros de 64 bits y decimales
+
+  std::string &out_;
+  size_t used_;
+  bool needComma_ = false;
+
+  /**
+   * @brief Garantiza 'size' bytes libres y devuelve el cursor de escritura
+   */
+  char *reserve(size_t size) {
+    if (out_.size() - used_ < size)
+      out_.resize(std::max(out_.size() * 2, used_ + size));
+    return out_.data() + used_;
+  }
+
+  void commit(const char *end) { used_ = end - out_.data(); }
+
+  void raw(std::string_view text) {
+    char *p = reserve(text.size() + 1);
+    if (needComma_)
+      *p++ = ',';
+    std::memcpy(p, text.data(), text.size());
+    commit(p + text.size());
+    needComma_ = true;
+  }
+
+  void open(char bracket) {
+    char *p = reserve(2);
+    if (needComma_)
+      *p++ = ',';
+    *p++ = bracket;
+    commit(p);
+    needComma_ = false;
+  }
+
+  void close(char bracket) {
+    char *p = reserve(1);
+    *p++ = bracket;
+    commit(p);
+    needComma_ = true;
+  }
+};
+
+// ============================================================================
+// Esquemas de campos en tiempo de compilación
+// ============================================================================
+
+/**
+ * @brief Campo de un esquema: clave + función que extrae el valor del registro
+ */
+template <typename Getter> struct JsonField {
+  std::string_view key;
+  Getter get;
+};
+
+template <typename Getter>
+constexpr JsonField<Getter> jsonField(std::string_view key, Getter get) {
+  return {key, get};
+}
+
+/**
+ * @class JsonSchema
+ * @brief Lista fija de campos para serializar registros de un mismo tipo
+ *
+ * Los campos se conocen en compilación, así que write() se expande a una
+ * secuencia de key()/value() sin bucles ni despacho dinámico:
+ *
+ *   constexpr auto POINT_SCHEMA = makeJsonSchema(
+ *       jsonField("x", [](const Point &p) { return p.x; }),
+ *       jsonField("y", [](const Point &p) { return p.y; }));
+ *   POINT_SCHEMA.write(json, point); // {"x":1,"y":2}
+ */
+template <typename... Fields> class JsonSchema {
+public:
+  constexpr explicit JsonSchema(Fields... fields) : fields_(fields...) {}
+
+  template <typename Record>
+  void write(JsonWriter &json, const Record &record) const {
+    json.beginObject();
+    std::apply(
+        [&](const Fields &...field) {
+          (json.field(field.key, field.get(record)), ...);
+        },
+        fields_);
+    json.endObject();
+  }
+
+  static constexpr size_t size() { return sizeof...(Fields); }
+
+private:
+  std::tuple<Fields...> fields_;
+};
+
+template <typename... Fields>
+constexpr JsonSchema<Fields...> makeJsonSchema(Fields... fields) {
+  return JsonSchema<Fields...>(fields...);
+}
+
+} // namespace OSBot
+
+#endif // RIDEBOT_JSONWRITER_H
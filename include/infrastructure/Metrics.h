@@ -0,0 +1,239 @@
+#ifndef RIDEBOT_METRICS_H
+#define RIDEBOT_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace OSBot {
+
+/**
+ * @brief Unidad de las muestras de un histograma
+ * Las latencias van en ns; las esperas largas (reloj de la simulación) en
+ * ms, porque en ns el histograma satura a los ~36 minutos.
+ */
+enum class HistogramUnit { NANOSECONDS, MILLISECONDS };
+
+/**
+ * @brief Resumen de un histograma (valores en la unidad del histograma)
+ */
+struct HistogramSummary {
+  uint64_t count = 0;
+  uint64_t p50 = 0;
+  uint64_t p99 = 0;
+  uint64_t max = 0;
+  double mean = 0.0;
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief Histograma log-lineal estilo HDR para latencias (ns por defecto)
+ *
+ * Cada potencia de 2 se divide en 2^SUB_BUCKET_BITS sub-buckets lineales,
+ * con error relativo máximo de ~3%. record() es lock-free (contadores
+ * atómicos relajados) y puede llamarse desde cualquier hilo.
+ */
+class LatencyHistogram {
+public:
+  static constexpr int SUB_BUCKET_BITS = 5;
+  static constexpr uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+  static constexpr int MAX_MAGNITUDE = 40; // Hasta 2^41 ns (~36 minutos); luego satura
+  static constexpr size_t BUCKET_COUNT =
+      (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+  explicit LatencyHistogram(HistogramUnit unit = HistogramUnit::NANOSECONDS);
+
+  /**
+   * @brief Registra una muestra, en la unidad del histograma
+   */
+  void record(uint64_t value);
+
+  /**
+   * @brief Valor en el percentil p (0-100), límite superior del bucket
+   */
+  uint64_t percentile(double p) const;
+
+  HistogramSummary summary() const;
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  HistogramUnit unit() const { return unit_; }
+  void reset();
+
+private:
+  const HistogramUnit unit_;
+  std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_;
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> max_;
+
+  static size_t bucketIndex(uint64_t value);
+  static uint64_t bucketUpperBound(size_t index);
+};
+
+/**
+ * @class Metrics
+ * @brief Registro global de histogramas y contadores de instrumentación
+ *
+ * Histogramas y contadores se crean por nombre la primera vez que se piden
+ * y nunca se destruyen, así que las referencias devueltas pueden guardarse
+ * (por ejemplo en una variable static local) y usarse sin lock.
+ */
+class Metrics {
+public:
+  static Metrics &instance();
+
+  /**
+   * @brief Obtiene (o crea) el histograma con el nombre dado
+   * La unidad solo se usa al crearlo: quien lo lea debe pedir la misma.
+   * NOTA: Toma un lock; no llamar en el camino caliente, guardar la referencia
+   */
+  LatencyHistogram &
+  histogram(const std::string &name,
+            HistogramUnit unit = HistogramUnit::NANOSECONDS);
+
+  /**
+   * @brief Obtiene (o crea) el contador monotónico con el nombre dado
+   * NOTA: Igual que histogram(): guardar la referencia
+   */
+  std::atomic<uint64_t> &counter(const std::string &name);
+
+  /**
+   * @brief Activa/desactiva la toma de tiempos (ScopedTimer, PhaseTimer...)
+   */
+  static void setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+  static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Serializa histogramas y contadores como JSON
+   * Las claves llevan la unidad de cada histograma (p99_ns, p99_ms...).
+   */
+  std::string toJSON() const;
+
+  /**
+   * @brief Imprime una tabla legible con todos los histogramas
+   * Los de ns se muestran en us y los de ms en una tabla aparte.
+   */
+  void printReport(std::ostream &os) const;
+
+  void resetAll();
+
+private:
+  Metrics() = default;
+
+  mutable std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms_;
+  std::map<std::string, std::unique_ptr<std::atomic<uint64_t>>> counters_;
+  static std::atomic<bool> enabled_;
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Mide la duración de un bloque y la registra al salir del scope
+ * Si las métricas están desactivadas no lee el reloj.
+ */
+class ScopedTimer {
+public:
+  explicit ScopedTimer(LatencyHistogram &histogram)
+      : histogram_(Metrics::isEnabled() ? &histogram : nullptr) {
+    if (histogram_)
+      start_ = std::chrono::steady_clock::now();
+  }
+
+  ~ScopedTimer() {
+    if (histogram_) {
+      auto elapsed = std::chrono::steady_clock::now() - start_;
+      histogram_->record(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count()));
+    }
+  }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+  LatencyHistogram *histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @class PhaseTimer
+ * @brief Cronómetro por vueltas para fases consecutivas de un tick
+ *
+ * Cada lap() registra el tiempo desde la vuelta anterior con una sola
+ * lectura de reloj; finish() registra el total sin leer el reloj otra vez.
+ * Así un tick de N fases cuesta N+1 lecturas en lugar de 2(N+1).
+ * Con 'sample' = false no lee el reloj ni registra nada (muestreo de ticks).
+ */
+class PhaseTimer {
+public:
+  explicit PhaseTimer(bool sample = true)
+      : enabled_(sample && Metrics::isEnabled()) {
+    if (enabled_)
+      start_ = last_ = std::chrono::steady_clock::now();
+  }
+
+  void lap(LatencyHistogram &histogram) {
+    if (!enabled_)
+      return;
+    auto now = std::chrono::steady_clock::now();
+    histogram.record(toNs(now - last_));
+    last_ = now;
+  }
+
+  void finish(LatencyHistogram &total) {
+    if (enabled_)
+      total.record(toNs(last_ - start_));
+  }
+
+private:
+  bool enabled_;
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::time_point last_;
+
+  static uint64_t toNs(std::chrono::steady_clock::duration d) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+  }
+};
+
+// timedLock() sondea la contención en 1 de cada N adquisiciones por hilo
+constexpr uint32_t LOCK_SAMPLE_EVERY = 8;
+
+/**
+ * @brief Adquiere un lock midiendo el tiempo de espera
+ * Muestreado: 1 de cada LOCK_SAMPLE_EVERY adquisiciones (por hilo) prueba
+ * try_lock y, si hay contención, registra la espera; el resto toma el lock
+ * directamente. Las adquisiciones sin contención no se registran: en el
+ * camino del tick try_lock y el histograma costarían más que el lock.
+ * @return std::unique_lock ya adquirido
+ */
+template <typename MutexT>
+std::unique_lock<MutexT> timedLock(MutexT &mutex, LatencyHistogram &waitHist) {
+  thread_local uint32_t acquisitions = 0;
+  if (!Metrics::isEnabled() || ++acquisitions % LOCK_SAMPLE_EVERY != 0) {
+    return std::unique_lock<MutexT>(mutex);
+  }
+  std::unique_lock<MutexT> fast(mutex, std::try_to_lock);
+  if (fast.owns_lock()) {
+    return fast;
+  }
+  auto start = std::chrono::steady_clock::now();
+  std::unique_lock<MutexT> lock(mutex);
+  waitHist.record(static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count()));
+  return lock;
+}
+
+} // namespace OSBot
+
+#endif // RIDEBOT_METRICS_H
@@ -0,0 +1,68 @@
+#ifndef RIDEBOT_PROFILEDMUTEX_H
+#define RIDEBOT_PROFILEDMUTEX_H
+
+#include "infrastructure/Metrics.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace OSBot {
+
+/**
+ * @class ProfiledMutex
+ * @brief std::mutex instrumentado por sitio de lock
+ *
+ * Por cada sitio (nombre del mutex) publica en Metrics:
+ * - lock.<sitio>.acquisitions / lock.<sitio>.contended (contadores)
+ * - lock.<sitio>.wait (espera solo de adquisiciones con contención)
+ * - lock.<sitio>.hold (tiempo que se mantuvo el lock)
+ * Varias instancias con el mismo nombre comparten estadísticas.
+ */
+class ProfiledMutex {
+public:
+  explicit ProfiledMutex(const char *site);
+
+  ProfiledMutex(const ProfiledMutex &) = delete;
+  ProfiledMutex &operator=(const ProfiledMutex &) = delete;
+
+  void lock();
+  bool try_lock();
+  void unlock();
+
+private:
+  std::mutex mutex_;
+  std::atomic<uint64_t> &acquisitions_;
+  std::atomic<uint64_t> &contended_;
+  LatencyHistogram &wait_;
+  LatencyHistogram &hold_;
+
+  // Solo lo escribe/lee el dueño del lock
+  std::chrono::steady_clock::time_point acquiredAt_;
+
+  void markAcquired();
+};
+
+/**
+ * @class PlainMutex
+ * @brief std::mutex con la misma interfaz de construcción que ProfiledMutex
+ * El nombre del sitio se ignora: coste idéntico a std::mutex.
+ */
+class PlainMutex : public std::mutex {
+public:
+  explicit PlainMutex(const char *) {}
+};
+
+/**
+ * @brief Mutex de los recursos compartidos del kernel
+ * Se instrumenta compilando con -DOSBOT_LOCK_PROFILING
+ * (meson configure -Dlock_profiling=true).
+ */
+#ifdef OSBOT_LOCK_PROFILING
+using KernelMutex = ProfiledMutex;
+#else
+using KernelMutex = PlainMutex;
+#endif
+
+} // namespace OSBot
+
+#endif // RIDEBOT_PROFILEDMUTEX_H
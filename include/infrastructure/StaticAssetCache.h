@@ -0,0 +1,88 @@
+#ifndef RIDEBOT_STATICASSETCACHE_H
+#define RIDEBOT_STATICASSETCACHE_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace OSBot {
+
+/**
+ * @brief Archivo estático listo para servir
+ */
+struct StaticAsset {
+  std::string contentType;
+  std::string body;
+  std::string etag;     // FNV-1a de 64 bits del contenido
+  std::string gzipBody; // Vacío si no hay zlib o no compensa comprimir
+  std::string gzipETag; // Las variantes comprimidas tienen su propio ETag
+};
+
+/**
+ * @class StaticAssetCache
+ * @brief Archivos de un directorio cargados en memoria una sola vez
+ *
+ * load() lee todos los archivos del directorio (sin subdirectorios), calcula
+ * su ETag y, para los tipos de texto, una variante gzip precomprimida.
+ * El conjunto se publica de una vez con std::atomic_store: los lectores
+ * nunca ven una recarga a medias ni toman locks, y un asset servido sigue
+ * vivo (shared_ptr) aunque se recargue durante la respuesta.
+ *
+ * Para desarrollo, SIGHUP solicita una recarga (requestReload) que atiende
+ * el bucle principal del Kernel.
+ */
+class StaticAssetCache {
+public:
+  explicit StaticAssetCache(std::string root) : root_(std::move(root)) {}
+
+  /**
+   * @brief Carga (o recarga) el directorio completo
+   * @return false si el directorio no existe; se conserva el contenido previo
+   */
+  bool load();
+
+  /**
+   * @brief Busca un asset por nombre de archivo ("app.js")
+   * @return nullptr si no existe
+   */
+  std::shared_ptr<const StaticAsset> find(const std::string &name) const;
+
+  size_t size() const;
+  const std::string &getRoot() const { return root_; }
+
+  /**
+   * @brief Content-Type según la extensión (application/octet-stream si no
+   * se conoce)
+   */
+  static std::string_view contentTypeFor(std::string_view filename);
+
+  /**
+   * @brief Solicita una recarga (async-signal-safe, p. ej. SIGHUP)
+   */
+  static void requestReload() {
+    reloadRequested_.store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Consume una solicitud de recarga pendiente
+   * @return true si había una solicitud
+   */
+  static bool consumeReloadRequest() {
+    return reloadRequested_.exchange(false, std::memory_order_relaxed);
+  }
+
+private:
+  using AssetMap = std::map<std::string, std::shared_ptr<const StaticAsset>,
+                            std::less<>>;
+
+  std::string root_;
+  std::shared_ptr<const AssetMap> assets_; // Solo con atomic_load/atomic_store
+
+  static std::atomic<bool> reloadRequested_;
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_STATICASSETCACHE_H
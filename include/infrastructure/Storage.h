@@ -13,12 +13,18 @@ namespace OSBot {
 /**
  * @brief Sistema de almacenamiento binario persistente
  * Formato: .osbot (binario personalizado con magic number)
+ *
+ * Versiones de la sección de entorno (ancho y alto int32 al inicio en ambas):
+ *   v1: lista de obstáculos (x,y int32); su número va en la cabecera (u16)
+ *   v2: u32 bytes + bitmap de GridCodec (mismo formato que /api/state.bin)
+ * Se escribe siempre v2 y se leen ambas.
  */
 class Storage {
 public:
   // Magic number para validar archivos
   static constexpr uint32_t MAGIC_NUMBER = 0x4F534254; // "OSBT" en ASCII
-  static constexpr uint16_t VERSION = 1;
+  static constexpr uint16_t VERSION = 2;
+  static constexpr uint16_t MIN_VERSION = 1; // Más antigua que se puede leer
 
   /**
    * @brief Guarda el estado completo del sistema
@@ -35,6 +41,13 @@ public:
                          std::vector<Robot *> &robots,
                          TaskScheduler &task_scheduler);
 
+  /**
+   * @brief Lee solo las dimensiones del mapa guardado
+   * Permite crear un Environment del tamaño correcto antes de load_state
+   */
+  static bool read_dimensions(const std::string &filename, int &width,
+                              int &height);
+
 private:
   // Métodos auxiliares de escritura
   static void writeHeader(std::ofstream &ofs, uint16_t num_robots,
@@ -46,10 +59,12 @@ private:
   static void writeTasks(std::ofstream &ofs, const TaskScheduler &scheduler);
 
   // Métodos auxiliares de lectura
-  static bool readHeader(std::ifstream &ifs, uint16_t &num_robots,
-                         uint16_t &num_tasks, uint16_t &num_obstacles);
+  static bool readHeader(std::ifstream &ifs, uint16_t &version,
+                         uint16_t &num_robots, uint16_t &num_tasks,
+                         uint16_t &num_obstacles);
   static Point readPoint(std::ifstream &ifs);
-  static bool readEnvironment(std::ifstream &ifs, Environment &env, uint16_t num_obstacles);
+  static bool readEnvironment(std::ifstream &ifs, Environment &env,
+                              uint16_t version, uint16_t num_obstacles);
   static bool readRobots(std::ifstream &ifs, std::vector<Robot *> &robots,
                          uint16_t count, Environment &env);
   static bool readTasks(std::ifstream &ifs, TaskScheduler &scheduler,
@@ -0,0 +1,154 @@
+#ifndef RIDEBOT_TRACER_H
+#define RIDEBOT_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OSBot {
+
+/**
+ * @brief Evento de traza completo (fase "X" del formato Chrome)
+ */
+struct TraceEvent {
+  static constexpr size_t NAME_CAPACITY = 48;
+
+  char name[NAME_CAPACITY]; // Copia truncada (admite nombres dinámicos)
+  const char *category;     // Debe ser un literal
+  uint64_t startNs;         // Relativo al inicio del Tracer
+  uint64_t durationNs;
+};
+
+/**
+ * @class Tracer
+ * @brief Trazas de spans con buffers circulares por hilo
+ *
+ * Cada hilo escribe en su propio buffer de capacidad fija (los eventos
+ * más antiguos se sobrescriben), así que registrar un span no reserva
+ * memoria ni compite con otros hilos. El volcado genera JSON compatible
+ * con chrome://tracing y Perfetto.
+ *
+ * Cuando un hilo termina (p. ej. un robot eliminado) su buffer se conserva
+ * para los volcados siguientes, pero como mucho quedan MAX_EXITED_BUFFERS
+ * de hilos terminados: al pasar del límite se descartan los más antiguos.
+ */
+class Tracer {
+public:
+  static constexpr size_t EVENTS_PER_THREAD = 16384;
+  static constexpr size_t MAX_EXITED_BUFFERS = 16;
+
+  static Tracer &instance();
+
+  static void setEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+  static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Registra un span ya terminado en el buffer del hilo actual
+   */
+  void record(const char *name, const char *category,
+              std::chrono::steady_clock::time_point start,
+              std::chrono::steady_clock::time_point end);
+
+  /**
+   * @brief Serializa todos los buffers en formato Chrome Trace Event
+   */
+  std::string toChromeJSON() const;
+
+  /**
+   * @brief Escribe la traza en un archivo .json
+   */
+  bool dumpToFile(const std::string &filename) const;
+
+  /**
+   * @brief Descarta todos los eventos registrados (y los buffers de hilos
+   * terminados)
+   */
+  void clear();
+
+  /**
+   * @brief Buffers registrados (hilos vivos + terminados conservados)
+   */
+  size_t bufferCount() const;
+
+  /**
+   * @brief Solicita un volcado a disco (async-signal-safe, p. ej. SIGUSR1)
+   * El Kernel atiende la solicitud desde su bucle principal.
+   */
+  static void requestDump() {
+    dumpRequested_.store(true, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Consume una solicitud de volcado pendiente
+   * @return true si había una solicitud
+   */
+  static bool consumeDumpRequest() {
+    return dumpRequested_.exchange(false, std::memory_order_relaxed);
+  }
+
+private:
+  struct ThreadBuffer {
+    std::mutex mutex; // Solo compite con el volcado, nunca entre hilos
+    std::vector<TraceEvent> events;
+    size_t next = 0;
+    bool wrapped = false;
+    uint32_t threadId = 0;
+    bool exited = false; // Protegido por registryMutex_
+  };
+
+  // Dueño thread_local del buffer: avisa al registro cuando el hilo termina
+  struct LocalBuffer;
+
+  Tracer();
+
+  ThreadBuffer &localBuffer();
+  void releaseBuffer(const std::shared_ptr<ThreadBuffer> &buffer);
+
+  std::chrono::steady_clock::time_point epoch_;
+  mutable std::mutex registryMutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+  uint32_t nextThreadId_;
+
+  static std::atomic<bool> enabled_;
+  static std::atomic<bool> dumpRequested_;
+};
+
+/**
+ * @class TraceSpan
+ * @brief Registra un span desde su construcción hasta su destrucción
+ * Si el Tracer está desactivado no lee el reloj.
+ */
+class TraceSpan {
+public:
+  TraceSpan(const char *name, const char *category)
+      : name_(name), category_(category), active_(Tracer::isEnabled()) {
+    if (active_)
+      start_ = std::chrono::steady_clock::now();
+  }
+
+  ~TraceSpan() {
+    if (active_) {
+      Tracer::instance().record(name_, category_, start_,
+                                std::chrono::steady_clock::now());
+    }
+  }
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+  const char *name_;
+  const char *category_;
+  bool active_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace OSBot
+
+#endif // RIDEBOT_TRACER_H
@@ -2,10 +2,16 @@
 #define WEBSERVER_H
 
 #include <atomic>
+#include "infrastructure/StaticAssetCache.h"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <thread>
 
+namespace httplib {
+class Server;
+}
+
 namespace OSBot {
 
 // Forward declarations
@@ -52,31 +58,51 @@ public:
    */
   int getPort() const { return port_; }
 
+  /**
+   * @brief Recarga web/ si se solicitó (SIGHUP); lo llama el Kernel
+   */
+  void serviceAssetReload();
+
+  /**
+   * @brief JSON con el estado de la foto vigente (memoizado en la foto)
+   * NOTA: Público para poder medirlo sin levantar el servidor (os-bot-bench)
+   */
+  std::string getStateJSON();
+
+  /**
+   * @brief Serializa la foto vigente en 'out' (se vacía, conserva capacidad)
+   * Reutilizando el mismo buffer entre llamadas no se reserva memoria.
+   */
+  void writeStateJSON(std::string &out);
+
+  /**
+   * @brief Escribe la foto vigente como frame binario (/api/state.bin)
+   * @param sinceEpoch Arranque del frame que tiene el cliente (cabecera,
+   *        byte 56); si no es el actual se envía el grid completo
+   * @param sinceVersion Versión del mapa que ya tiene el cliente (0 = ninguna);
+   *        si sigue en el historial el grid se envía como delta
+   * Formato documentado en WorldSnapshot::writeFrame().
+   */
+  void writeStateFrame(std::string &out, uint64_t sinceEpoch,
+                       uint64_t sinceVersion);
+
 private:
   Kernel &kernel_;
   int port_;
   std::atomic<bool> running_;
   std::unique_ptr<std::thread> serverThread_;
+  std::unique_ptr<httplib::Server> server_;
+  StaticAssetCache assets_; // web/ en memoria (cargado en start())
 
   /**
    * @brief Loop principal del servidor HTTP
    */
   void serverLoop();
 
-  /**
-   * @brief Genera JSON con el estado actual del sistema
-   */
-  std::string getStateJSON();
-
   /**
    * @brief Genera JSON con las estadísticas del sistema
    */
   std::string getStatsJSON();
-
-  /**
-   * @brief Sirve archivos estáticos desde el directorio web/
-   */
-  std::string serveStaticFile(const std::string &filename);
 };
 
 } // namespace OSBot
@@ -1,5 +1,7 @@
 #include "application/AStar.h"
 #include "domain/Environment.h"
+#include "infrastructure/Metrics.h"
+#include "infrastructure/Tracer.h"
 #include <algorithm>
 #include <cmath>
 #include <vector>
@@ -23,6 +25,11 @@ float calculate_h_value(int y, int x, const Point &end) {
 
 Route find_path(const Point &start, const Point &end,
                 const Environment &environment) {
+  static LatencyHistogram &plannerHist =
+      Metrics::instance().histogram("planner.find_path");
+  ScopedTimer timer(plannerHist);
+  TraceSpan span("AStar::find_path", "planner");
+
   int height = environment.getHeight();
   int width = environment.getWidth();
 
@@ -0,0 +1,211 @@
+#include "application/AssignmentSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+
+namespace OSBot {
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+// Los algoritmos trabajan con n <= m; si hay más filas que columnas se
+// resuelve la transpuesta y se invierte el resultado
+struct Problem {
+  const std::vector<double> &cost;
+  size_t rows;
+  size_t cols;
+  bool transposed;
+
+  size_t n() const { return transposed ? cols : rows; }
+  size_t m() const { return transposed ? rows : cols; }
+  double at(size_t i, size_t j) const {
+    return transposed ? cost[j * cols + i] : cost[i * cols + j];
+  }
+};
+
+AssignmentResult finish(const Problem &problem, const std::vector<int> &iToJ,
+                        AssignmentResult::Method method) {
+  AssignmentResult result;
+  result.method = method;
+  result.rowToCol.assign(problem.rows, -1);
+  for (size_t i = 0; i < problem.n(); ++i) {
+    int j = iToJ[i];
+    if (j < 0)
+      continue;
+    result.totalCost += problem.at(i, static_cast<size_t>(j));
+    if (problem.transposed)
+      result.rowToCol[static_cast<size_t>(j)] = static_cast<int>(i);
+    else
+      result.rowToCol[i] = j;
+  }
+  return result;
+}
+
+std::vector<int> hungarian(const Problem &problem) {
+  size_t n = problem.n();
+  size_t m = problem.m();
+
+  // Índices desde 1: la columna 0 es el origen ficticio de cada camino
+  std::vector<double> u(n + 1, 0.0), v(m + 1, 0.0), minv(m + 1);
+  std::vector<size_t> p(m + 1, 0), way(m + 1, 0);
+  std::vector<char> used(m + 1);
+
+  for (size_t i = 1; i <= n; ++i) {
+    p[0] = i;
+    size_t j0 = 0;
+    std::fill(minv.begin(), minv.end(), INF);
+    std::fill(used.begin(), used.end(), 0);
+
+    // Camino aumentante más corto (Dijkstra sobre costos reducidos)
+    do {
+      used[j0] = 1;
+      size_t i0 = p[j0];
+      size_t j1 = 0;
+      double delta = INF;
+      for (size_t j = 1; j <= m; ++j) {
+        if (used[j])
+          continue;
+        double reduced = problem.at(i0 - 1, j - 1) - u[i0] - v[j];
+        if (reduced < minv[j]) {
+          minv[j] = reduced;
+          way[j] = j0;
+        }
+        if (minv[j] < delta) {
+          delta = minv[j];
+          j1 = j;
+        }
+      }
+      for (size_t j = 0; j <= m; ++j) {
+        if (used[j]) {
+          u[p[j]] += delta;
+          v[j] -= delta;
+        } else {
+          minv[j] -= delta;
+        }
+      }
+      j0 = j1;
+    } while (p[j0] != 0);
+
+    // Invertir el camino
+    do {
+      size_t j1 = way[j0];
+      p[j0] = p[j1];
+      j0 = j1;
+    } while (j0 != 0);
+  }
+
+  std::vector<int> iToJ(n, -1);
+  for (size_t j = 1; j <= m; ++j) {
+    if (p[j] != 0)
+      iToJ[p[j] - 1] = static_cast<int>(j - 1);
+  }
+  return iToJ;
+}
+
+std::vector<int> auction(const Problem &problem) {
+  size_t n = problem.n();
+  size_t size = problem.m();
+
+  // Matriz de beneficios contigua por postor (el bucle interno recorre una
+  // fila). Las filas n..size-1 son postores ficticios de beneficio 0 que se
+  // quedan con las columnas sobrantes
+  std::vector<double> benefit(size * size, 0.0);
+  double maxCost = 0.0;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < size; ++j) {
+      benefit[i * size + j] = -problem.at(i, j);
+      maxCost = std::max(maxCost, problem.at(i, j));
+    }
+  }
+
+  constexpr double SCALING = 8.0;
+  const double finalEpsilon = 1.0 / static_cast<double>(size + 1);
+  double epsilon = std::max(maxCost / SCALING, finalEpsilon);
+
+  std::vector<double> price(size, 0.0);
+  std::vector<int> owner(size), assigned(size);
+  std::deque<size_t> unassigned;
+
+  while (true) {
+    // Cada fase parte de cero asignaciones pero conserva los precios
+    std::fill(owner.begin(), owner.end(), -1);
+    std::fill(assigned.begin(), assigned.end(), -1);
+    unassigned.clear();
+    for (size_t i = 0; i < size; ++i)
+      unassigned.push_back(i);
+
+    while (!unassigned.empty()) {
+      size_t i = unassigned.front();
+      unassigned.pop_front();
+
+      // Mejor y segundo mejor valor neto (beneficio - precio)
+      size_t bestJ = 0;
+      double best = -INF;
+      double second = -INF;
+      const double *row = &benefit[i * size];
+      for (size_t j = 0; j < size; ++j) {
+        double value = row[j] - price[j];
+        if (value > best) {
+          second = best;
+          best = value;
+          bestJ = j;
+        } else if (value > second) {
+          second = value;
+        }
+      }
+      if (size == 1)
+        second = best;
+
+      price[bestJ] += best - second + epsilon;
+      if (owner[bestJ] != -1) {
+        assigned[static_cast<size_t>(owner[bestJ])] = -1;
+        unassigned.push_back(static_cast<size_t>(owner[bestJ]));
+      }
+      owner[bestJ] = static_cast<int>(i);
+      assigned[i] = static_cast<int>(bestJ);
+    }
+
+    if (epsilon <= finalEpsilon)
+      break;
+    epsilon = std::max(epsilon / SCALING, finalEpsilon);
+  }
+
+  assigned.resize(n);
+  return assigned;
+}
+
+} // namespace
+
+AssignmentResult AssignmentSolver::solve(const std::vector<double> &cost,
+                                         size_t rows, size_t cols) {
+  // La subasta rellena con postores ficticios hasta hacer la matriz
+  // cuadrada; con muchos ficticios se pelean las columnas sobrantes y el
+  // húngaro (O(n^2 m) con n = menor dimensión) sale más barato
+  size_t n = std::min(rows, cols);
+  size_t m = std::max(rows, cols);
+  if (n <= HUNGARIAN_MAX_SIZE || m - n > n / AUCTION_MAX_PADDING)
+    return solveHungarian(cost, rows, cols);
+  return solveAuction(cost, rows, cols);
+}
+
+AssignmentResult
+AssignmentSolver::solveHungarian(const std::vector<double> &cost, size_t rows,
+                                 size_t cols) {
+  Problem problem{cost, rows, cols, rows > cols};
+  if (rows == 0 || cols == 0)
+    return finish(problem, {}, AssignmentResult::Method::NONE);
+  return finish(problem, hungarian(problem),
+                AssignmentResult::Method::HUNGARIAN);
+}
+
+AssignmentResult AssignmentSolver::solveAuction(const std::vector<double> &cost,
+                                                size_t rows, size_t cols) {
+  Problem problem{cost, rows, cols, rows > cols};
+  if (rows == 0 || cols == 0)
+    return finish(problem, {}, AssignmentResult::Method::NONE);
+  return finish(problem, auction(problem), AssignmentResult::Method::AUCTION);
+}
+
+} // namespace OSBot
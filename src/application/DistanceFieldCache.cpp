@@ -0,0 +1,124 @@
+#include "application/DistanceFieldCache.h"
+#include "domain/Environment.h"
+#include "infrastructure/Metrics.h"
+#include <algorithm>
+
+namespace OSBot {
+
+// ============================================================================
+// DistanceField
+// ============================================================================
+
+DistanceField::DistanceField(Point target, uint64_t mapVersion, int width,
+                             int height,
+                             const std::vector<uint8_t> &obstacleMask)
+    : target_(target), mapVersion_(mapVersion), width_(width),
+      height_(height),
+      distance_(static_cast<size_t>(width) * height, UNREACHABLE) {
+  if (target.x < 0 || target.x >= width || target.y < 0 || target.y >= height)
+    return;
+
+  // BFS desde el destino; el propio destino cuenta aunque sea obstáculo
+  // (la distancia a sus vecinos libres sigue siendo útil para costear)
+  std::vector<int> frontier;
+  frontier.reserve(distance_.size());
+  int start = target.y * width + target.x;
+  distance_[start] = 0;
+  frontier.push_back(start);
+
+  for (size_t head = 0; head < frontier.size(); ++head) {
+    int cell = frontier[head];
+    int x = cell % width;
+    int y = cell / width;
+    int32_t next = distance_[cell] + 1;
+
+    auto visit = [&](int neighbor) {
+      if (distance_[neighbor] == UNREACHABLE && !obstacleMask[neighbor]) {
+        distance_[neighbor] = next;
+        frontier.push_back(neighbor);
+      }
+    };
+    if (x > 0)
+      visit(cell - 1);
+    if (x + 1 < width)
+      visit(cell + 1);
+    if (y > 0)
+      visit(cell - width);
+    if (y + 1 < height)
+      visit(cell + width);
+  }
+}
+
+// ============================================================================
+// DistanceFieldCache
+// ============================================================================
+
+DistanceFieldCache::DistanceFieldCache(const Environment &environment,
+                                       size_t maxBytes)
+    : environment_(environment), maxBytes_(maxBytes) {}
+
+std::shared_ptr<const DistanceField>
+DistanceFieldCache::get(const Point &target) {
+  static LatencyHistogram &buildHist =
+      Metrics::instance().histogram("distance_field.build");
+  static std::atomic<uint64_t> &hits =
+      Metrics::instance().counter("distance_field.hits");
+  static std::atomic<uint64_t> &misses =
+      Metrics::instance().counter("distance_field.misses");
+
+  std::lock_guard<KernelMutex> lock(mutex_);
+
+  // Un cambio de mapa invalida todos los campos a la vez
+  if (!hasMask_ || environment_.getMapVersion() != mapVersion_) {
+    mapVersion_ = environment_.copyObstacleMask(obstacleMask_);
+    hasMask_ = true;
+    fields_.clear();
+    index_.clear();
+  }
+
+  uint64_t key = keyOf(target);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    fields_.splice(fields_.begin(), fields_, it->second);
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return fields_.front();
+  }
+
+  misses.fetch_add(1, std::memory_order_relaxed);
+  std::shared_ptr<const DistanceField> field;
+  {
+    ScopedTimer timer(buildHist);
+    field = std::make_shared<DistanceField>(target, mapVersion_,
+                                            environment_.getWidth(),
+                                            environment_.getHeight(),
+                                            obstacleMask_);
+  }
+
+  fields_.push_front(field);
+  index_[key] = fields_.begin();
+  while (fields_.size() > capacity()) {
+    index_.erase(keyOf(fields_.back()->getTarget()));
+    fields_.pop_back();
+  }
+  return field;
+}
+
+void DistanceFieldCache::clear() {
+  std::lock_guard<KernelMutex> lock(mutex_);
+  fields_.clear();
+  index_.clear();
+  hasMask_ = false;
+}
+
+size_t DistanceFieldCache::size() const {
+  std::lock_guard<KernelMutex> lock(mutex_);
+  return fields_.size();
+}
+
+size_t DistanceFieldCache::capacity() const {
+  size_t fieldBytes = static_cast<size_t>(environment_.getWidth()) *
+                      environment_.getHeight() * sizeof(int32_t);
+  return std::max<size_t>(1, maxBytes_ / std::max<size_t>(1, fieldBytes));
+}
+
+} // namespace OSBot
@@ -0,0 +1,107 @@
+#include "application/IdleRobotIndex.h"
+
+namespace OSBot {
+
+namespace {
+// Orden de los resultados: distancia y, a igualdad, ID
+void sortByDistance(const Point &target, std::vector<AvailableRobot> &robots) {
+  std::sort(robots.begin(), robots.end(),
+            [&](const AvailableRobot &a, const AvailableRobot &b) {
+              int da = IdleRobotIndex::distance(a.position, target);
+              int db = IdleRobotIndex::distance(b.position, target);
+              return da != db ? da < db : a.id < b.id;
+            });
+}
+} // namespace
+
+IdleRobotIndex::IdleRobotIndex(int width, int height)
+    : bucketsWide_(std::max(1, (width + BUCKET_SIZE - 1) / BUCKET_SIZE)),
+      bucketsHigh_(std::max(1, (height + BUCKET_SIZE - 1) / BUCKET_SIZE)),
+      buckets_(static_cast<size_t>(bucketsWide_) * bucketsHigh_) {}
+
+void IdleRobotIndex::update(int robotId, const Point &position,
+                            bool available) {
+  if (robotId < 0)
+    return;
+  if (static_cast<size_t>(robotId) >= slots_.size()) {
+    if (!available)
+      return;
+    slots_.resize(static_cast<size_t>(robotId) + 1);
+  }
+
+  Slot &slot = slots_[robotId];
+  int bucket = bucketY(position.y) * bucketsWide_ + bucketX(position.x);
+
+  if (slot.bucket >= 0) {
+    auto &entries = buckets_[slot.bucket];
+    if (available && slot.bucket == bucket) {
+      entries[slot.index].position = position; // Misma cubeta: solo mover
+      return;
+    }
+
+    // Quitar intercambiando con el último de la cubeta
+    AvailableRobot &last = entries.back();
+    slots_[last.id].index = slot.index;
+    entries[slot.index] = last;
+    entries.pop_back();
+    slot.bucket = -1;
+    count_--;
+  }
+
+  if (available) {
+    auto &entries = buckets_[bucket];
+    slot.bucket = bucket;
+    slot.index = static_cast<uint32_t>(entries.size());
+    entries.push_back({robotId, position});
+    count_++;
+  }
+}
+
+void IdleRobotIndex::clear() {
+  for (auto &entries : buckets_)
+    entries.clear();
+  slots_.clear();
+  count_ = 0;
+}
+
+void IdleRobotIndex::nearest(const Point &target, size_t k,
+                             std::vector<AvailableRobot> &out) const {
+  out.clear();
+  if (k == 0)
+    return;
+
+  // Se junta todo lo visitado y se corta cuando hay k candidatos y el
+  // siguiente anillo ya no puede traer uno más cercano que el k-ésimo
+  std::vector<int> distances;
+  visitByRing(
+      target,
+      [&](int minDistance) {
+        if (out.size() < k)
+          return false;
+        std::nth_element(distances.begin(), distances.begin() + (k - 1),
+                         distances.end());
+        return minDistance > distances[k - 1];
+      },
+      [&](const AvailableRobot &robot) {
+        out.push_back(robot);
+        distances.push_back(distance(robot.position, target));
+      });
+
+  sortByDistance(target, out);
+  if (out.size() > k)
+    out.resize(k);
+}
+
+void IdleRobotIndex::withinRadius(const Point &target, int radius,
+                                  std::vector<AvailableRobot> &out) const {
+  out.clear();
+  visitByRing(
+      target, [&](int minDistance) { return minDistance > radius; },
+      [&](const AvailableRobot &robot) {
+        if (distance(robot.position, target) <= radius)
+          out.push_back(robot);
+      });
+  sortByDistance(target, out);
+}
+
+} // namespace OSBot
@@ -1,13 +1,40 @@
 #include "application/Kernel.h"
+#include "infrastructure/Metrics.h"
+#include "infrastructure/Tracer.h"
 #include "infrastructure/WebServer.h"
+#include "domain/Random.h"
+#include "domain/SimulationClock.h"
 #include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <thread>
 
 namespace OSBot {
 
-Kernel::Kernel() : running_(false), paused_(false), 
-                   simulationSpeed_(Constants::SIMULATION_SPEED_MS) {}
+namespace {
+/**
+ * @brief Histogramas de las fases del tick (referencias estables)
+ */
+struct TickHistograms {
+  LatencyHistogram &total = Metrics::instance().histogram("tick.total");
+  LatencyHistogram &robotsStep =
+      Metrics::instance().histogram("tick.robots_step");
+  LatencyHistogram &robotsUpdate =
+      Metrics::instance().histogram("tick.robots_update");
+  LatencyHistogram &tasksUpdate =
+      Metrics::instance().histogram("tick.tasks_update");
+  LatencyHistogram &schedule = Metrics::instance().histogram("tick.schedule");
+
+  static TickHistograms &get() {
+    static TickHistograms histograms;
+    return histograms;
+  }
+};
+} // namespace
+
+Kernel::Kernel(const SimulationConfig &config)
+    : config_(config), tickCount_(0), running_(false), paused_(false),
+      simulationSpeed_(config.tickMs) {}
 
 Kernel::~Kernel() { shutdown(); }
 
@@ -15,11 +42,25 @@ bool Kernel::initialize() {
   std::cout << "[Kernel] Inicializando sistema operativo multi-robot..."
             << std::endl;
 
+  Metrics::setEnabled(config_.profiling);
+  Tracer::setEnabled(config_.tracing);
+
+  // En modo headless el tiempo es virtual y los robots no imprimen
+  SimulationClock::useVirtualTime(config_.headless);
+  Robot::setLoggingEnabled(!config_.headless);
+
+  // Semilla maestra: todos los flujos aleatorios derivan de ella
+  Random::setMasterSeed(config_.seed);
+  std::cout << "[Kernel] ✓ Semilla maestra: " << Random::masterSeed()
+            << std::endl;
+
   // Inicializar entorno
-  environment_ = std::make_unique<Environment>(Constants::GRID_WIDTH,
-                                               Constants::GRID_HEIGHT);
+  environment_ = std::make_unique<Environment>(config_.gridWidth,
+                                               config_.gridHeight);
   environment_->initialize();
-  environment_->start();
+  if (!config_.headless) {
+    environment_->start();
+  }
   std::cout << "[Kernel] ✓ Entorno inicializado" << std::endl;
 
   // Inicializar gestor de robots
@@ -28,8 +69,26 @@ bool Kernel::initialize() {
 
   // Inicializar gestor de tareas
   taskManager_ = std::make_unique<TaskManager>(*robotManager_);
+  taskManager_->setAssignmentMode(config_.assignment);
+  taskManager_->setSchedulingPolicy(config_.scheduling);
+  // En headless el orden solo depende de los topes deterministas de
+  // RouteOptions: el de reloj de pared cambiaría la ruta según la CPU
+  RouteOptions routeOptions;
+  routeOptions.fixLast = config_.routeFixLast;
+  if (config_.headless)
+    routeOptions.timeBudgetMs = 0.0;
+  taskManager_->setRouteOptimization(config_.optimizeRoutes, routeOptions);
   std::cout << "[Kernel] ✓ Gestor de tareas inicializado" << std::endl;
 
+  if (config_.headless) {
+    std::cout << "[Kernel] ✓ Modo headless (paso " << config_.tickMs
+              << "ms)" << std::endl;
+    return true;
+  }
+
+  // Primera foto antes de aceptar peticiones
+  publishSnapshot();
+
   // Inicializar servidor web
   webServer_ = std::make_unique<WebServer>(*this, 8080);
   webServer_->start();
@@ -47,6 +106,13 @@ void Kernel::start() {
 
   running_ = true;
 
+  if (config_.headless) {
+    // Sin hilos: el Kernel avanza los robots en step()
+    robotManager_->startAllRobotsStepped();
+    std::cout << "[Kernel] ✓ Robots preparados (modo paso a paso)" << std::endl;
+    return;
+  }
+
   // Iniciar robots
   robotManager_->startAllRobots();
   std::cout << "[Kernel] ✓ Robots iniciados" << std::endl;
@@ -57,6 +123,15 @@ void Kernel::start() {
 }
 
 void Kernel::run(int durationSeconds) {
+  if (config_.headless) {
+    uint64_t ticks = config_.maxTicks;
+    if (ticks == 0) {
+      ticks = static_cast<uint64_t>(durationSeconds) * 1000 / config_.tickMs;
+    }
+    runHeadless(ticks);
+    return;
+  }
+
   printSystemInfo();
 
   std::cout << "\n[Kernel] Sistema operativo en ejecución" << std::endl;
@@ -68,6 +143,8 @@ void Kernel::run(int durationSeconds) {
   while (running_) {
     // Renderizar entorno
     environment_->render();
+    serviceTraceDump();
+    webServer_->serviceAssetReload();
 
     // Verificar duración
     if (durationSeconds > 0) {
@@ -113,25 +190,46 @@ void Kernel::shutdown() {
   environment_->stop();
   std::cout << "[Kernel] ✓ Entorno detenido" << std::endl;
 
+  // Volcar métricas de instrumentación
+  if (Metrics::isEnabled()) {
+    Metrics::instance().printReport(std::cout);
+  }
+  if (Tracer::isEnabled()) {
+    Tracer::instance().dumpToFile("osbot_trace.json");
+  }
+
   std::cout << "[Kernel] Sistema apagado correctamente" << std::endl;
 }
 
 void Kernel::updateLoop() {
   std::cout << "[Update Thread] Bucle de actualización iniciado" << std::endl;
 
+  TickHistograms &hist = TickHistograms::get();
+
   while (running_) {
     // Solo actualizar si no está pausado
     if (!paused_) {
+      PhaseTimer phases(tickCount_ % PROFILE_EVERY_TICKS == 0);
+
       // Actualizar robots
       robotManager_->update();
+      phases.lap(hist.robotsUpdate);
 
       // Actualizar tareas
       taskManager_->update();
+      phases.lap(hist.tasksUpdate);
 
       // Planificar nuevas tareas
       taskManager_->scheduleNextTasks();
+      phases.lap(hist.schedule);
+
+      phases.finish(hist.total);
+      tickCount_++;
     }
 
+    // Publicar aunque esté pausado: los robots siguen en sus propios hilos
+    publishSnapshot();
+
     // Esperar antes de la siguiente actualización (usando velocidad configurable)
     std::this_thread::sleep_for(
         std::chrono::milliseconds(simulationSpeed_.load()));
@@ -140,6 +238,152 @@ void Kernel::updateLoop() {
   std::cout << "[Update Thread] Bucle de actualización finalizado" << std::endl;
 }
 
+void Kernel::step() {
+  TickHistograms &hist = TickHistograms::get();
+  PhaseTimer phases(tickCount_ % PROFILE_EVERY_TICKS == 0);
+
+  SimulationClock::advance(std::chrono::milliseconds(config_.tickMs));
+
+  // Mover robots (un paso cada uno, orden determinista)
+  robotManager_->stepAllRobots();
+  phases.lap(hist.robotsStep);
+
+  // Mismo orden que updateLoop()
+  robotManager_->update();
+  phases.lap(hist.robotsUpdate);
+  taskManager_->update();
+  phases.lap(hist.tasksUpdate);
+  taskManager_->scheduleNextTasks();
+  phases.lap(hist.schedule);
+
+  phases.finish(hist.total);
+  tickCount_++;
+}
+
+void Kernel::runHeadless(uint64_t ticks) {
+  std::cout << "[Kernel] Fast-forward: " << ticks << " ticks..." << std::endl;
+
+  auto wallStart = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < ticks && running_; ++i) {
+    step();
+    serviceTraceDump();
+  }
+  auto wallEnd = std::chrono::steady_clock::now();
+  double wallSeconds =
+      std::chrono::duration<double>(wallEnd - wallStart).count();
+
+  // Resumen de la ejecución
+  size_t goalsReached = 0;
+  size_t cellsTraveled = 0;
+  for (const auto *info : robotManager_->getAllRobots()) {
+    goalsReached += info->tasksCompleted;
+    cellsTraveled += info->cellsTraveled;
+  }
+
+  std::cout << "\n[Headless] Ticks simulados:   " << tickCount_ << std::endl;
+  std::cout << "[Headless] Tiempo virtual:    "
+            << SimulationClock::elapsedMs() / 1000.0 << " s" << std::endl;
+  std::cout << "[Headless] Tiempo real:       " << std::fixed
+            << std::setprecision(3) << wallSeconds << " s" << std::endl;
+  if (wallSeconds > 0.0) {
+    std::cout << "[Headless] Ticks/segundo:     " << std::setprecision(0)
+              << tickCount_ / wallSeconds << std::endl;
+  }
+  std::cout << std::defaultfloat;
+  std::cout << "[Headless] Robots:            "
+            << robotManager_->getRobotCount() << std::endl;
+  std::cout << "[Headless] Objetivos logrados: " << goalsReached << std::endl;
+  std::cout << "[Headless] Celdas recorridas: " << cellsTraveled << std::endl;
+  std::cout << "[Headless] Tareas completadas: "
+            << taskManager_->getCompletedTaskCount() << std::endl;
+  std::cout << "[Headless] Huella de estado:  0x" << std::hex
+            << std::setw(16) << std::setfill('0') << computeStateDigest()
+            << std::dec << std::setfill(' ') << std::endl;
+}
+
+int Kernel::spawnRobots(int count) {
+  int created = 0;
+  for (int i = 0; i < count; ++i) {
+    Point pos = environment_->randomFreePosition();
+    if (robotManager_->addRobot(pos) > 0) {
+      created++;
+    }
+  }
+  return created;
+}
+
+std::shared_ptr<const WorldSnapshot> Kernel::publishSnapshot() {
+  std::lock_guard<KernelMutex> lock(publishMutex_);
+  auto previous = std::atomic_load(&snapshot_);
+  auto snapshot = WorldSnapshot::capture(*environment_, *robotManager_,
+                                         tickCount_, paused_,
+                                         simulationSpeed_, previous.get());
+
+  // Cada versión nueva del mapa queda en el historial para servir deltas
+  if (!previous || snapshot->getGrid() != previous->getGrid()) {
+    const auto &grid = *snapshot->getGrid();
+    gridHistory_.record(grid.version, grid.packed);
+  }
+
+  std::atomic_store(&snapshot_, snapshot);
+  return snapshot;
+}
+
+std::shared_ptr<const WorldSnapshot> Kernel::getSnapshot() {
+  auto snapshot = std::atomic_load(&snapshot_);
+  if (!snapshot)
+    snapshot = publishSnapshot();
+  return snapshot;
+}
+
+uint64_t Kernel::computeStateDigest() const {
+  // FNV-1a de 64 bits sobre los campos observables
+  uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash](int64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      hash ^= static_cast<uint64_t>(value >> (i * 8)) & 0xFF;
+      hash *= 1099511628211ULL;
+    }
+  };
+
+  Point goal = environment_->getGoal();
+  mix(goal.x);
+  mix(goal.y);
+
+  for (const auto *info : robotManager_->getAllRobots()) {
+    Point pos = info->robot->getPosition();
+    mix(info->id);
+    mix(pos.x);
+    mix(pos.y);
+    mix(static_cast<int>(info->currentState));
+    mix(info->cellsTraveled);
+    mix(info->obstaclesAvoided);
+    mix(info->tasksCompleted);
+  }
+
+  for (const auto &task : taskManager_->getAllTasks()) {
+    mix(task->getId());
+    mix(static_cast<int>(task->getStatus()));
+    mix(task->getAssignedRobotId());
+    mix(task->getCurrentWaypointIndex());
+  }
+  // Terminadas, en orden de archivo
+  taskManager_->visitHistory([&](const TaskRecord &record) {
+    mix(record.id);
+    mix(static_cast<int>(record.status));
+    mix(record.robotId);
+    mix(record.waypointsVisited);
+  });
+
+  return hash;
+}
+
+void Kernel::serviceTraceDump() {
+  if (Tracer::consumeDumpRequest()) {
+    Tracer::instance().dumpToFile("osbot_trace.json");
+  }
+}
+
 void Kernel::printSystemInfo() {
   std::cout << "\n╔════════════════════════════════════════════════════╗"
             << std::endl;
@@ -1,13 +1,23 @@
 #include "application/RobotManager.h"
+#include "infrastructure/Metrics.h"
+#include "infrastructure/Tracer.h"
 #include <algorithm>
-#include <random>
 #include <iostream>
 
 namespace OSBot {
 
+namespace {
+// Un robot que llegó a su objetivo está parado y puede aceptar otra tarea
+bool isIdleState(State state) {
+    return state == State::IDLE || state == State::REACHED_GOAL;
+}
+} // namespace
+
 RobotManager::RobotManager(Environment& env)
     : environment_(env)
     , nextRobotId_(1)
+    , rng_(Random::stream(RandomStream::ROBOT_MANAGER))
+    , idleIndex_(env.getWidth(), env.getHeight())
 {
 }
 
@@ -16,7 +26,7 @@ RobotManager::~RobotManager() {
 }
 
 int RobotManager::addRobot(const Point& homePosition) {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     int robotId = nextRobotId_++;
     auto robot = std::make_unique<Robot>(environment_);
@@ -27,18 +37,20 @@ int RobotManager::addRobot(const Point& homePosition) {
     
     auto robotInfo = std::make_unique<RobotInfo>(robotId, std::move(robot), homePosition);
     
+    refreshIndex(*robotInfo);
     robots_[robotId] = std::move(robotInfo);
     return robotId;
 }
 
 bool RobotManager::removeRobot(int robotId) {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     auto it = robots_.find(robotId);
     if (it != robots_.end()) {
         if (it->second->robot) {
             it->second->robot->stop();
         }
+        idleIndex_.remove(robotId);
         robots_.erase(it);
         return true;
     }
@@ -46,7 +58,7 @@ bool RobotManager::removeRobot(int robotId) {
 }
 
 void RobotManager::startAllRobots() {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     for (auto& [id, info] : robots_) {
         if (info->robot && info->isActive) {
@@ -56,7 +68,7 @@ void RobotManager::startAllRobots() {
 }
 
 void RobotManager::stopAllRobots() {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     for (auto& [id, info] : robots_) {
         if (info->robot) {
@@ -65,29 +77,57 @@ void RobotManager::stopAllRobots() {
     }
 }
 
+void RobotManager::startAllRobotsStepped() {
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
+    
+    for (auto& [id, info] : robots_) {
+        if (info->robot && info->isActive) {
+            info->robot->startStepped();
+        }
+    }
+}
+
+void RobotManager::stepAllRobots() {
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
+    
+    // Orden determinista: std::map itera por ID ascendente
+    for (auto& [id, info] : robots_) {
+        if (info->robot && info->isActive) {
+            info->robot->step();
+        }
+    }
+}
+
 bool RobotManager::assignTask(int robotId, std::shared_ptr<Task> task) {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     auto it = robots_.find(robotId);
     if (it != robots_.end() && it->second->currentTaskId == -1) {
         it->second->currentTaskId = task->getId();
         task->setAssignedRobot(robotId);
+        
+        // El robot sale hacia el primer waypoint de la tarea
+        if (it->second->robot) {
+            it->second->robot->setPersonalGoal(task->getCurrentWaypoint());
+        }
+        refreshIndex(*it->second);
         return true;
     }
     return false;
 }
 
 void RobotManager::unassignTask(int robotId) {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     auto it = robots_.find(robotId);
     if (it != robots_.end()) {
         it->second->currentTaskId = -1;
+        refreshIndex(*it->second);
     }
 }
 
 bool RobotManager::setRobotGoal(int robotId, const Point& goal) {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     auto it = robots_.find(robotId);
     if (it != robots_.end() && it->second->robot) {
@@ -98,7 +138,7 @@ bool RobotManager::setRobotGoal(int robotId, const Point& goal) {
 }
 
 void RobotManager::clearAllPersonalGoals() {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     for (auto& [id, info] : robots_) {
         if (info && info->robot) {
@@ -108,12 +148,12 @@ void RobotManager::clearAllPersonalGoals() {
 }
 
 size_t RobotManager::getRobotCount() const {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     return robots_.size();
 }
 
 std::vector<int> RobotManager::getRobotIds() const {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     std::vector<int> ids;
     ids.reserve(robots_.size());
@@ -124,21 +164,21 @@ std::vector<int> RobotManager::getRobotIds() const {
 }
 
 RobotInfo* RobotManager::getRobotInfo(int robotId) {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     auto it = robots_.find(robotId);
     return (it != robots_.end()) ? it->second.get() : nullptr;
 }
 
 const RobotInfo* RobotManager::getRobotInfo(int robotId) const {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     auto it = robots_.find(robotId);
     return (it != robots_.end()) ? it->second.get() : nullptr;
 }
 
 std::vector<const RobotInfo*> RobotManager::getAllRobots() const {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     std::vector<const RobotInfo*> result;
     result.reserve(robots_.size());
@@ -149,7 +189,10 @@ std::vector<const RobotInfo*> RobotManager::getAllRobots() const {
 }
 
 void RobotManager::update() {
-  std::lock_guard<std::mutex> lock(robotsMutex_);
+  TraceSpan span("RobotManager::update", "kernel");
+  static LatencyHistogram &lockWait =
+      Metrics::instance().histogram("lock.robots.wait");
+  auto lock = timedLock(robotsMutex_, lockWait);
 
   for (auto &pair : robots_) {
     auto &info = pair.second;
@@ -157,7 +200,6 @@ void RobotManager::update() {
       // Actualizar estadísticas usando métodos de la clase Robot
     State previousState = info->currentState; // Keep previous state for task completion check
     info->currentState = info->robot->getState();
-    info->currentTaskId = -1; // TODO: Integrar con TaskScheduler
     info->cellsTraveled = info->robot->getCellsTraveled();
     info->obstaclesAvoided = info->robot->getObstaclesAvoided();
     
@@ -174,7 +216,7 @@ void RobotManager::update() {
     info->currentGoal = info->robot->getGoal();
     info->hasPersonalGoal = info->robot->hasPersonalGoal();
     
-    info->lastUpdateTime = std::chrono::system_clock::now();
+    info->lastUpdateTime = SimulationClock::now();
       // If robot just reached goal, increment completed tasks
       if (previousState == State::NAVIGATING && 
           info->currentState == State::REACHED_GOAL) {
@@ -183,42 +225,95 @@ void RobotManager::update() {
       
       // Update activity
       updateRobotStats(*info);
+      refreshIndex(*info);
     }
   }
 }
 
+void RobotManager::refreshIndex(const RobotInfo& info) {
+    bool available = info.isActive && 
+                     info.currentTaskId == -1 && 
+                     isIdleState(info.currentState) &&
+                     info.robot;
+    idleIndex_.update(info.id, available ? info.robot->getPosition() : Point(), available);
+}
+
 void RobotManager::updateRobotStats(RobotInfo& info) {
     // Aquí se pueden actualizar estadísticas como distancia recorrida, etc.
-    info.lastUpdateTime = std::chrono::system_clock::now();
+    info.lastUpdateTime = SimulationClock::now();
 }
 
 bool RobotManager::isRobotAvailable(int robotId) const {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     auto it = robots_.find(robotId);
     if (it != robots_.end()) {
         return it->second->isActive && 
                it->second->currentTaskId == -1 && 
-               it->second->currentState == State::IDLE;
+               isIdleState(it->second->currentState);
     }
     return false;
 }
 
 int RobotManager::findAvailableRobot() const {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     for (const auto& [id, info] : robots_) {
         if (info->isActive && 
             info->currentTaskId == -1 && 
-            info->currentState == State::IDLE) {
+            isIdleState(info->currentState)) {
             return id;
         }
     }
     return -1; // No hay robots disponibles
 }
 
+void RobotManager::getAvailableRobots(std::vector<AvailableRobot>& out) const {
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
+    
+    out.clear();
+    for (const auto& [id, info] : robots_) {
+        if (info->isActive && 
+            info->currentTaskId == -1 && 
+            isIdleState(info->currentState) &&
+            info->robot) {
+            out.push_back({id, info->robot->getPosition()});
+        }
+    }
+}
+
+void RobotManager::getRobotProgress(const std::vector<int>& robotIds,
+                                    std::vector<RobotProgress>& out) const {
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
+    
+    out.clear();
+    out.reserve(robotIds.size());
+    for (int robotId : robotIds) {
+        auto it = robots_.find(robotId);
+        if (it != robots_.end() && it->second->robot) {
+            const Robot& robot = *it->second->robot;
+            out.push_back({robot.getPosition(), it->second->currentState,
+                           static_cast<int>(robot.getCellsTraveled()), true});
+        } else {
+            out.push_back({Point(), State::IDLE, 0, false});
+        }
+    }
+}
+
+void RobotManager::findNearestAvailable(const Point& target, size_t k,
+                                        std::vector<AvailableRobot>& out) const {
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
+    idleIndex_.nearest(target, k, out);
+}
+
+void RobotManager::findAvailableWithin(const Point& target, int radius,
+                                       std::vector<AvailableRobot>& out) const {
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
+    idleIndex_.withinRadius(target, radius, out);
+}
+
 void RobotManager::resetRobotPosition() {
-    std::lock_guard<std::mutex> lock(robotsMutex_);
+    std::lock_guard<KernelMutex> lock(robotsMutex_);
     
     // Regenerar obstáculos aleatorios (25% del área)
     environment_.generateRandomObstacles(25);
@@ -229,11 +324,6 @@ void RobotManager::resetRobotPosition() {
     int height = environment_.getHeight();
     
     // Generar posición aleatoria válida (evitando bordes)
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> distX(2, width - 3);
-    std::uniform_int_distribution<> distY(2, height - 3);
-    
     for (auto& [id, info] : robots_) {
         if (info && info->robot) {
             // Detener el robot actual
@@ -245,8 +335,8 @@ void RobotManager::resetRobotPosition() {
             int attempts = 0;
             
             while (!validPosition && attempts < 100) {
-                newPos.x = distX(gen);
-                newPos.y = distY(gen);
+                newPos.x = rng_.uniformInt(2, width - 3);
+                newPos.y = rng_.uniformInt(2, height - 3);
                 
                 // Verificar que la posición esté libre
                 if (environment_.isPositionFree(newPos)) {
@@ -275,6 +365,7 @@ void RobotManager::resetRobotPosition() {
             info->obstaclesAvoided = 0;
             info->currentTaskId = -1;
             info->currentState = State::IDLE;
+            refreshIndex(*info);
             
             // Actualizar posición del robot en el entorno
             environment_.updateRobotPosition(newPos);
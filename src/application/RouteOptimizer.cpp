@@ -0,0 +1,438 @@
+#include "application/RouteOptimizer.h"
+#include "domain/Environment.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <numeric>
+
+namespace OSBot {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int64_t INF = std::numeric_limits<int64_t>::max() / 4;
+
+/**
+ * @brief Tope de reloj de pared de una optimización (inactivo si el
+ * presupuesto es 0: el trabajo lo acotan maxStops y maxPasses)
+ */
+class Deadline {
+public:
+  explicit Deadline(double budgetMs) : timed_(budgetMs > 0.0) {
+    if (timed_)
+      at_ = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                               std::chrono::duration<double, std::milli>(
+                                   budgetMs));
+  }
+
+  bool expired() const { return timed_ && Clock::now() > at_; }
+
+private:
+  bool timed_;
+  Clock::time_point at_;
+};
+
+/**
+ * @brief Matriz simétrica de costos para la búsqueda
+ */
+class CostMatrix {
+public:
+  CostMatrix(const std::vector<int64_t> &distance, size_t n)
+      : n_(n), cost_(n * n) {
+    auto leg = [&](size_t from, size_t to) {
+      int64_t d = distance[from * n + to];
+      return d < 0 ? RouteOptimizer::UNREACHABLE_LEG : d;
+    };
+    for (size_t i = 0; i < n; ++i)
+      for (size_t j = 0; j < n; ++j)
+        cost_[i * n + j] = std::max(leg(i, j), leg(j, i));
+  }
+
+  int64_t operator()(int from, int to) const {
+    return cost_[static_cast<size_t>(from) * n_ + static_cast<size_t>(to)];
+  }
+
+  int64_t pathCost(const std::vector<int> &order) const {
+    int64_t total = 0;
+    for (size_t i = 1; i < order.size(); ++i)
+      total += (*this)(order[i - 1], order[i]);
+    return total;
+  }
+
+private:
+  size_t n_;
+  std::vector<int64_t> cost_;
+};
+
+// Recorrido real en 'order' (-1 si algún tramo no tiene camino)
+int64_t routeCells(const std::vector<int64_t> &distance, size_t n,
+                   const std::vector<int> &order) {
+  int64_t total = 0;
+  for (size_t i = 1; i < order.size(); ++i) {
+    int64_t d = distance[static_cast<size_t>(order[i - 1]) * n + order[i]];
+    if (d < 0)
+      return -1;
+    total += d;
+  }
+  return total;
+}
+
+/**
+ * @brief Held-Karp para camino abierto: dp[mask][last] = costo mínimo de
+ * visitar 'mask' terminando en 'last'
+ */
+std::vector<int> solveExact(const CostMatrix &cost, size_t n,
+                            const RouteOptions &options) {
+  const size_t full = (size_t{1} << n) - 1;
+  const int last = static_cast<int>(n) - 1;
+  std::vector<int64_t> dp((full + 1) * n, INF);
+  std::vector<int8_t> parent((full + 1) * n, -1);
+
+  for (size_t s = 0; s < n; ++s) {
+    bool allowed = options.fixFirst ? s == 0
+                                    : !(options.fixLast && s == n - 1);
+    if (allowed)
+      dp[(size_t{1} << s) * n + s] = 0;
+  }
+
+  for (size_t mask = 1; mask <= full; ++mask) {
+    for (size_t end = 0; end < n; ++end) {
+      int64_t base = dp[mask * n + end];
+      if (base >= INF)
+        continue;
+      for (size_t next = 0; next < n; ++next) {
+        size_t bit = size_t{1} << next;
+        if (mask & bit)
+          continue;
+        // El último fijo solo puede cerrar el recorrido
+        if (options.fixLast && static_cast<int>(next) == last &&
+            (mask | bit) != full)
+          continue;
+        int64_t candidate = base + cost(static_cast<int>(end),
+                                        static_cast<int>(next));
+        size_t index = (mask | bit) * n + next;
+        if (candidate < dp[index]) {
+          dp[index] = candidate;
+          parent[index] = static_cast<int8_t>(end);
+        }
+      }
+    }
+  }
+
+  int end = last;
+  if (!options.fixLast) {
+    for (size_t e = 0; e < n; ++e) {
+      if (dp[full * n + e] < dp[full * n + static_cast<size_t>(end)])
+        end = static_cast<int>(e);
+    }
+  }
+
+  std::vector<int> order;
+  size_t mask = full;
+  while (end >= 0) {
+    order.push_back(end);
+    int previous = parent[mask * n + static_cast<size_t>(end)];
+    mask &= ~(size_t{1} << end);
+    end = previous;
+  }
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+std::vector<int> nearestNeighbor(const CostMatrix &cost, size_t n,
+                                 const RouteOptions &options) {
+  const int last = static_cast<int>(n) - 1;
+  std::vector<bool> used(n, false);
+  std::vector<int> order = {0};
+  used[0] = true;
+  if (options.fixLast)
+    used[static_cast<size_t>(last)] = true;
+
+  while (order.size() < n - (options.fixLast ? 1 : 0)) {
+    int best = -1;
+    for (size_t j = 0; j < n; ++j) {
+      if (!used[j] && (best < 0 || cost(order.back(), static_cast<int>(j)) <
+                                       cost(order.back(), best)))
+        best = static_cast<int>(j);
+    }
+    used[static_cast<size_t>(best)] = true;
+    order.push_back(best);
+  }
+  if (options.fixLast)
+    order.push_back(last);
+  return order;
+}
+
+/**
+ * @brief Una pasada de 2-opt: invierte el mejor tramo [i, j] dentro del
+ * rango movible [lo, hi]
+ * @return true si mejoró
+ */
+bool improveTwoOpt(const CostMatrix &cost, std::vector<int> &order, int lo,
+                   int hi, const Deadline &deadline, bool &timedOut) {
+  const int n = static_cast<int>(order.size());
+  bool improved = false;
+  for (int i = lo; i < hi; ++i) {
+    if (deadline.expired()) {
+      timedOut = true;
+      return improved;
+    }
+    for (int j = i + 1; j <= hi; ++j) {
+      int64_t before = 0, after = 0;
+      if (i > 0) {
+        before += cost(order[i - 1], order[i]);
+        after += cost(order[i - 1], order[j]);
+      }
+      if (j < n - 1) {
+        before += cost(order[j], order[j + 1]);
+        after += cost(order[i], order[j + 1]);
+      }
+      if (after < before) {
+        std::reverse(order.begin() + i, order.begin() + j + 1);
+        improved = true;
+      }
+    }
+  }
+  return improved;
+}
+
+/**
+ * @brief Una pasada de Or-opt: mueve tramos de 1 a 3 paradas a la mejor
+ * posición dentro del rango movible
+ * @return true si mejoró
+ */
+bool improveOrOpt(const CostMatrix &cost, std::vector<int> &order, int lo,
+                  int hi, const Deadline &deadline, bool &timedOut) {
+  bool improved = false;
+  std::vector<int> rest;
+  for (int length = 1; length <= 3; ++length) {
+    for (int i = lo; i + length - 1 <= hi; ++i) {
+      if (deadline.expired()) {
+        timedOut = true;
+        return improved;
+      }
+      const int n = static_cast<int>(order.size());
+      int first = order[i];
+      int tail = order[i + length - 1];
+
+      // Ahorro de quitar el tramo
+      int64_t removed = 0;
+      if (i > 0)
+        removed += cost(order[i - 1], first);
+      if (i + length < n)
+        removed += cost(tail, order[i + length]);
+      if (i > 0 && i + length < n)
+        removed -= cost(order[i - 1], order[i + length]);
+
+      rest.assign(order.begin(), order.begin() + i);
+      rest.insert(rest.end(), order.begin() + i + length, order.end());
+
+      // Insertar antes de rest[k]; los extremos fijos no se desplazan
+      const int restSize = static_cast<int>(rest.size());
+      int kMax = hi - length + 1;
+      int bestK = -1;
+      int64_t bestGain = 0;
+      for (int k = lo; k <= kMax; ++k) {
+        if (k == i)
+          continue; // Posición original
+        int64_t added = 0;
+        if (k > 0)
+          added += cost(rest[k - 1], first);
+        if (k < restSize)
+          added += cost(tail, rest[k]);
+        if (k > 0 && k < restSize)
+          added -= cost(rest[k - 1], rest[k]);
+        if (removed - added > bestGain) {
+          bestGain = removed - added;
+          bestK = k;
+        }
+      }
+
+      if (bestK >= 0) {
+        std::vector<int> segment(order.begin() + i,
+                                 order.begin() + i + length);
+        rest.insert(rest.begin() + bestK, segment.begin(), segment.end());
+        order.swap(rest);
+        improved = true;
+      }
+    }
+  }
+  return improved;
+}
+
+RouteResult identity(size_t n) {
+  RouteResult result;
+  result.order.resize(n);
+  std::iota(result.order.begin(), result.order.end(), 0);
+  return result;
+}
+
+RouteResult solveMatrix(const std::vector<int64_t> &distance, size_t n,
+                        const RouteOptions &options, const Deadline &deadline) {
+  RouteResult result = identity(n);
+  result.originalCells = routeCells(distance, n, result.order);
+  result.optimizedCells = result.originalCells;
+
+  // Con los extremos fijos no queda nada que mover
+  size_t fixed = (options.fixFirst ? 1 : 0) + (options.fixLast ? 1 : 0);
+  if (n < 2 || n <= fixed + 1)
+    return result;
+
+  CostMatrix cost(distance, n);
+  std::vector<int> best;
+  if (n <= RouteOptimizer::EXACT_MAX_STOPS) {
+    best = solveExact(cost, n, options);
+    result.method = RouteResult::Method::EXACT;
+  } else {
+    best = nearestNeighbor(cost, n, options);
+    if (cost.pathCost(result.order) < cost.pathCost(best))
+      best = result.order;
+
+    int lo = options.fixFirst ? 1 : 0;
+    int hi = static_cast<int>(n) - (options.fixLast ? 2 : 1);
+    bool improved = true;
+    for (int pass = 0; improved && pass < options.maxPasses && !result.timedOut;
+         ++pass) {
+      improved = improveTwoOpt(cost, best, lo, hi, deadline, result.timedOut);
+      if (!result.timedOut)
+        improved |= improveOrOpt(cost, best, lo, hi, deadline,
+                                 result.timedOut);
+    }
+    result.method = RouteResult::Method::HEURISTIC;
+  }
+
+  if (cost.pathCost(best) < cost.pathCost(result.order)) {
+    result.order = std::move(best);
+    result.optimizedCells = routeCells(distance, n, result.order);
+  }
+  return result;
+}
+
+/**
+ * @brief Buffers de los BFS, reutilizados entre llamadas del mismo hilo
+ * Las marcas por generación evitan limpiar el grid en cada BFS.
+ */
+struct BfsScratch {
+  std::vector<uint8_t> mask;
+  std::vector<uint32_t> seen; // Generación del BFS que visitó la celda
+  std::vector<int32_t> distance;
+  std::vector<int> frontier;
+  std::vector<uint8_t> isStop; // 1 en las celdas con parada
+  uint32_t generation = 0;
+
+  void resize(size_t cells) {
+    if (seen.size() != cells) {
+      seen.assign(cells, 0);
+      distance.assign(cells, 0);
+      isStop.assign(cells, 0);
+      generation = 0;
+    }
+  }
+
+  uint32_t nextGeneration() {
+    if (++generation == 0) { // Vuelta del contador: limpiar una vez
+      std::fill(seen.begin(), seen.end(), 0);
+      generation = 1;
+    }
+    return generation;
+  }
+};
+
+} // namespace
+
+RouteResult RouteOptimizer::solve(const std::vector<int64_t> &distance,
+                                  size_t n, const RouteOptions &options) {
+  return solveMatrix(distance, n, options, Deadline(options.timeBudgetMs));
+}
+
+RouteResult RouteOptimizer::optimize(const std::vector<Point> &waypoints,
+                                     const RouteOptions &options) const {
+  Deadline deadline(options.timeBudgetMs);
+  size_t n = waypoints.size();
+  if (n < 2 || n > options.maxStops)
+    return identity(n);
+
+  thread_local BfsScratch scratch;
+  environment_.copyObstacleMask(scratch.mask);
+  const int width = environment_.getWidth();
+  const int height = environment_.getHeight();
+  scratch.resize(static_cast<size_t>(width) * height);
+
+  std::vector<int> cells(n, -1);
+  size_t stopCells = 0;
+  for (size_t i = 0; i < n; ++i) {
+    const Point &p = waypoints[i];
+    if (p.x < 0 || p.x >= width || p.y < 0 || p.y >= height)
+      continue;
+    cells[i] = p.y * width + p.x;
+    if (!scratch.isStop[static_cast<size_t>(cells[i])]) {
+      scratch.isStop[static_cast<size_t>(cells[i])] = 1;
+      stopCells++;
+    }
+  }
+  auto clearStops = [&]() {
+    for (int cell : cells)
+      if (cell >= 0)
+        scratch.isStop[static_cast<size_t>(cell)] = 0;
+  };
+
+  // distance[i][j]: celdas desde el waypoint i hasta el j, con la misma
+  // convención que DistanceField: BFS desde el destino j, que cuenta aunque
+  // sea obstáculo; se corta al alcanzar todas las paradas
+  std::vector<int64_t> distance(n * n, -1);
+  for (size_t j = 0; j < n; ++j) {
+    if (cells[j] < 0)
+      continue;
+    uint32_t generation = scratch.nextGeneration();
+    size_t pending = stopCells - 1;
+    scratch.frontier.clear();
+    scratch.frontier.push_back(cells[j]);
+    scratch.seen[static_cast<size_t>(cells[j])] = generation;
+    scratch.distance[static_cast<size_t>(cells[j])] = 0;
+
+    for (size_t head = 0; head < scratch.frontier.size() && pending > 0;
+         ++head) {
+      if ((head & 4095) == 4095 && deadline.expired()) {
+        clearStops();
+        RouteResult result = identity(n);
+        result.timedOut = true;
+        return result;
+      }
+      int cell = scratch.frontier[head];
+      int x = cell % width;
+      int y = cell / width;
+      int32_t next = scratch.distance[static_cast<size_t>(cell)] + 1;
+
+      auto visit = [&](int neighbor) {
+        size_t index = static_cast<size_t>(neighbor);
+        if (scratch.seen[index] != generation && !scratch.mask[index]) {
+          scratch.seen[index] = generation;
+          scratch.distance[index] = next;
+          scratch.frontier.push_back(neighbor);
+          if (scratch.isStop[index])
+            pending--;
+        }
+      };
+      if (x > 0)
+        visit(cell - 1);
+      if (x + 1 < width)
+        visit(cell + 1);
+      if (y > 0)
+        visit(cell - width);
+      if (y + 1 < height)
+        visit(cell + width);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+      if (cells[i] >= 0 &&
+          scratch.seen[static_cast<size_t>(cells[i])] == generation)
+        distance[i * n + j] = scratch.distance[static_cast<size_t>(cells[i])];
+    }
+  }
+  clearStops();
+
+  return solveMatrix(distance, n, options, deadline);
+}
+
+} // namespace OSBot
@@ -0,0 +1,398 @@
+#include "application/ScenarioRunner.h"
+#include "application/TaskScheduler.h"
+#include "domain/SimulationClock.h"
+#include "infrastructure/Storage.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace OSBot {
+
+namespace {
+
+bool parsePoint(const std::string &token, Point &point) {
+  size_t comma = token.find(',');
+  if (comma == std::string::npos)
+    return false;
+  try {
+    size_t used = 0;
+    point.x = std::stoi(token.substr(0, comma), &used);
+    if (used != comma)
+      return false;
+    point.y = std::stoi(token.substr(comma + 1), &used);
+    return used == token.size() - comma - 1;
+  } catch (const std::exception &) {
+    return false;
+  }
+}
+
+HistogramSummary summaryOf(const char *name) {
+  return Metrics::instance().histogram(name).summary();
+}
+
+} // namespace
+
+ScenarioRunner::ScenarioRunner(const ScenarioConfig &config)
+    : config_(config), nextEvent_(0) {
+  // Siempre fast-forward; los percentiles requieren los histogramas
+  config_.simulation.headless = true;
+  config_.simulation.profiling = true;
+  if (config_.replaySpeed <= 0.0)
+    config_.replaySpeed = 1.0;
+}
+
+bool ScenarioRunner::parseEvents(std::istream &in,
+                                 std::vector<ScenarioEvent> &events,
+                                 std::string &error) {
+  std::string line;
+  int lineNumber = 0;
+
+  while (std::getline(in, line)) {
+    lineNumber++;
+    size_t hash = line.find('#');
+    if (hash != std::string::npos)
+      line.erase(hash);
+
+    std::istringstream iss(line);
+    std::string tickToken;
+    if (!(iss >> tickToken))
+      continue; // Línea vacía o comentario
+
+    ScenarioEvent event;
+    std::string type;
+    try {
+      event.tick = std::stoull(tickToken);
+    } catch (const std::exception &) {
+      error = "línea " + std::to_string(lineNumber) + ": tick inválido";
+      return false;
+    }
+    iss >> type;
+
+    if (type == "task") {
+      event.type = ScenarioEvent::Type::TASK;
+      std::string token;
+      while (iss >> token) {
+        Point p;
+        if (token.rfind("p=", 0) == 0) {
+          int priority = std::atoi(token.c_str() + 2);
+          if (priority < 0 || priority > 3) {
+            error = "línea " + std::to_string(lineNumber) +
+                    ": prioridad fuera de rango (0-3)";
+            return false;
+          }
+          event.priority = static_cast<TaskPriority>(priority);
+        } else if (token.rfind("d=", 0) == 0) {
+          event.deadlineMs = std::atoi(token.c_str() + 2);
+          if (event.deadlineMs <= 0) {
+            error = "línea " + std::to_string(lineNumber) +
+                    ": plazo inválido (ms > 0)";
+            return false;
+          }
+        } else if (parsePoint(token, p)) {
+          event.points.push_back(p);
+        } else {
+          error = "línea " + std::to_string(lineNumber) +
+                  ": waypoint inválido '" + token + "'";
+          return false;
+        }
+      }
+      if (event.points.empty()) {
+        error = "línea " + std::to_string(lineNumber) + ": tarea sin waypoints";
+        return false;
+      }
+    } else if (type == "obstacle") {
+      event.type = ScenarioEvent::Type::OBSTACLE;
+      std::string token;
+      Point p;
+      if (!(iss >> token) || !parsePoint(token, p)) {
+        error = "línea " + std::to_string(lineNumber) + ": celda inválida";
+        return false;
+      }
+      event.points.push_back(p);
+    } else {
+      error = "línea " + std::to_string(lineNumber) + ": tipo desconocido '" +
+              type + "'";
+      return false;
+    }
+
+    events.push_back(std::move(event));
+  }
+
+  // Orden estable por tick: los eventos del mismo tick conservan su orden
+  std::stable_sort(events.begin(), events.end(),
+                   [](const ScenarioEvent &a, const ScenarioEvent &b) {
+                     return a.tick < b.tick;
+                   });
+  return true;
+}
+
+bool ScenarioRunner::loadEvents() {
+  events_.clear();
+  nextEvent_ = 0;
+  if (config_.eventsFile.empty())
+    return true;
+
+  std::ifstream ifs(config_.eventsFile);
+  if (!ifs.is_open()) {
+    std::cerr << "[Scenario] Error: No se pudo abrir el archivo: "
+              << config_.eventsFile << std::endl;
+    return false;
+  }
+
+  std::string error;
+  if (!parseEvents(ifs, events_, error)) {
+    std::cerr << "[Scenario] Error en " << config_.eventsFile << ": " << error
+              << std::endl;
+    return false;
+  }
+
+  std::cout << "[Scenario] Eventos cargados: " << events_.size() << std::endl;
+  return true;
+}
+
+bool ScenarioRunner::loadMap(Kernel &kernel, ScenarioReport &report) {
+  std::vector<Robot *> loadedRobots;
+  TaskScheduler loadedTasks;
+  if (!Storage::load_state(config_.mapFile, kernel.getEnvironment(),
+                           loadedRobots, loadedTasks)) {
+    return false;
+  }
+
+  // Los robots guardados pasan a ser parte de la flota (en su posición)
+  for (Robot *robot : loadedRobots) {
+    if (static_cast<int>(kernel.getRobotManager().getRobotCount()) <
+        config_.robots) {
+      kernel.getRobotManager().addRobot(robot->getPosition());
+    }
+    delete robot;
+  }
+
+  // Las tareas sin terminar se vuelven a encolar
+  for (const Task &task : loadedTasks.getAllTasks()) {
+    if (task.getStatus() == TaskStatus::PENDING || task.isActive()) {
+      kernel.getTaskManager().createTask(task.getWaypoints(),
+                                         task.getPriority());
+      report.tasksInjected++;
+    }
+  }
+  return true;
+}
+
+bool ScenarioRunner::run(ScenarioReport &report) {
+  report = ScenarioReport();
+
+  if (!config_.mapFile.empty() &&
+      !Storage::read_dimensions(config_.mapFile, config_.simulation.gridWidth,
+                                config_.simulation.gridHeight)) {
+    return false;
+  }
+  if (!loadEvents())
+    return false;
+
+  Kernel kernel(config_.simulation);
+  if (!kernel.initialize())
+    return false;
+
+  // Flujo propio: la carga sintética no altera la del entorno
+  rng_ = Random::stream(RandomStream::SCENARIO);
+
+  if (!config_.mapFile.empty() && !loadMap(kernel, report))
+    return false;
+
+  int missing = config_.robots -
+                static_cast<int>(kernel.getRobotManager().getRobotCount());
+  if (missing > 0)
+    kernel.spawnRobots(missing);
+
+  // Robots estacionados en su sitio: solo se mueven cuando reciben tareas
+  for (const RobotInfo *info : kernel.getRobotManager().getAllRobots()) {
+    kernel.getRobotManager().setRobotGoal(info->id,
+                                          info->robot->getPosition());
+  }
+
+  kernel.start();
+
+  // Medir solo la simulación, no la preparación
+  Metrics::instance().resetAll();
+
+  uint64_t ticks = config_.simulation.maxTicks;
+  auto wallStart = std::chrono::steady_clock::now();
+  for (uint64_t tick = 0; tick < ticks; ++tick) {
+    injectTick(kernel, tick, report);
+    kernel.step();
+  }
+  auto wallEnd = std::chrono::steady_clock::now();
+
+  report.ticks = kernel.getTickCount();
+  report.robots = kernel.getRobotManager().getRobotCount();
+  report.wallSeconds =
+      std::chrono::duration<double>(wallEnd - wallStart).count();
+  report.virtualSeconds = SimulationClock::elapsedMs() / 1000.0;
+
+  TaskManager &tasks = kernel.getTaskManager();
+  report.tasksCompleted = tasks.getCompletedTaskCount();
+  report.tasksFailed = tasks.getTaskCount(TaskStatus::FAILED);
+  report.tasksPending = tasks.getPendingTaskCount();
+  for (const RobotInfo *info : kernel.getRobotManager().getAllRobots())
+    report.cellsTraveled += static_cast<size_t>(info->cellsTraveled);
+  report.approachCells =
+      Metrics::instance().counter("schedule.approach_cells").load();
+
+  if (report.wallSeconds > 0.0) {
+    report.robotStepsPerSecond =
+        static_cast<double>(report.robots) * report.ticks / report.wallSeconds;
+    report.tasksPerSecond = report.tasksCompleted / report.wallSeconds;
+  }
+  report.tick = summaryOf("tick.total");
+  report.planner = summaryOf("planner.find_path");
+  report.assignment = summaryOf("schedule.assignment_solve");
+  for (int level = 0; level < 4; ++level)
+    report.wait[level] =
+        TaskManager::waitHistogram(static_cast<TaskPriority>(level)).summary();
+  tasks.getOldestPendingWaitMs(report.oldestPendingMs);
+  report.deadlinesMissed =
+      Metrics::instance().counter("task.deadline_missed").load();
+  report.routeEstimatedCells =
+      Metrics::instance().counter("route.estimated_cells").load();
+  report.routeActualCells =
+      Metrics::instance().counter("route.actual_cells").load();
+  report.routeSavedCells =
+      Metrics::instance().counter("route.saved_cells").load();
+  report.digest = kernel.computeStateDigest();
+
+  kernel.shutdown();
+  return true;
+}
+
+void ScenarioRunner::injectTick(Kernel &kernel, uint64_t tick,
+                                ScenarioReport &report) {
+  // Eventos grabados: el tick grabado se escala con replaySpeed
+  while (nextEvent_ < events_.size()) {
+    const ScenarioEvent &event = events_[nextEvent_];
+    auto due = static_cast<uint64_t>(event.tick / config_.replaySpeed);
+    if (due > tick)
+      break;
+    applyEvent(kernel, event, report);
+    nextEvent_++;
+  }
+
+  Environment &env = kernel.getEnvironment();
+
+  // Carga sintética
+  for (int i = sampleCount(config_.taskRate); i > 0; --i) {
+    ScenarioEvent event;
+    event.type = ScenarioEvent::Type::TASK;
+    event.points = {randomFreeCell(env), randomFreeCell(env)};
+    event.priority = static_cast<TaskPriority>(rng_.uniformInt(0, 3));
+    applyEvent(kernel, event, report);
+  }
+
+  for (int i = sampleCount(config_.obstacleRate); i > 0; --i) {
+    ScenarioEvent event;
+    event.type = ScenarioEvent::Type::OBSTACLE;
+    event.points = {Point(rng_.uniformInt(1, env.getWidth() - 2),
+                          rng_.uniformInt(1, env.getHeight() - 2))};
+    applyEvent(kernel, event, report);
+  }
+}
+
+void ScenarioRunner::applyEvent(Kernel &kernel, const ScenarioEvent &event,
+                                ScenarioReport &report) {
+  if (event.type == ScenarioEvent::Type::TASK) {
+    kernel.getTaskManager().createTask(event.points, event.priority,
+                                       event.deadlineMs);
+    report.tasksInjected++;
+  } else {
+    kernel.getEnvironment().toggleObstacle(event.points.front());
+    report.obstacleEdits++;
+  }
+}
+
+int ScenarioRunner::sampleCount(double rate) {
+  if (rate <= 0.0)
+    return 0;
+
+  // Parte entera fija + un evento extra con probabilidad igual a la fracción
+  double whole = std::floor(rate);
+  int count = static_cast<int>(whole);
+  if (rng_.uniformReal() < rate - whole)
+    count++;
+  return count;
+}
+
+Point ScenarioRunner::randomFreeCell(const Environment &env) {
+  for (int attempt = 0; attempt < 100; ++attempt) {
+    Point p(rng_.uniformInt(1, env.getWidth() - 2),
+            rng_.uniformInt(1, env.getHeight() - 2));
+    if (env.isPositionFree(p))
+      return p;
+  }
+  return Point(1, 1);
+}
+
+void ScenarioRunner::printReport(const ScenarioReport &report,
+                                 std::ostream &os) {
+  auto us = [](uint64_t ns) { return ns / 1000.0; };
+
+  os << std::fixed << std::setprecision(1);
+  os << "\n[Scenario] Robots:              " << report.robots << "\n";
+  os << "[Scenario] Ticks:               " << report.ticks << " ("
+     << report.virtualSeconds << " s virtuales)\n";
+  os << "[Scenario] Tiempo real:         " << std::setprecision(3)
+     << report.wallSeconds << " s\n" << std::setprecision(1);
+  os << "[Scenario] Robots/segundo:      " << report.robotStepsPerSecond
+     << " (pasos de robot por segundo real)\n";
+  os << "[Scenario] Tareas/segundo:      " << report.tasksPerSecond << "\n";
+  os << "[Scenario] Tareas:              " << report.tasksInjected
+     << " inyectadas, " << report.tasksCompleted << " completadas, "
+     << report.tasksFailed << " fallidas, " << report.tasksPending
+     << " en cola\n";
+  os << "[Scenario] Celdas recorridas:   " << report.cellsTraveled << " ("
+     << report.approachCells << " de aproximación estimada)\n";
+  os << "[Scenario] Ediciones de mapa:   " << report.obstacleEdits << "\n";
+  os << "[Scenario] Tick p50/p99/max:    " << us(report.tick.p50) << " / "
+     << us(report.tick.p99) << " / " << us(report.tick.max) << " us\n";
+  os << "[Scenario] Planner p50/p99/max: " << us(report.planner.p50) << " / "
+     << us(report.planner.p99) << " / " << us(report.planner.max) << " us ("
+     << report.planner.count << " llamadas)\n";
+  if (report.assignment.count > 0) {
+    os << "[Scenario] Asignación p50/p99:  " << us(report.assignment.p50)
+       << " / " << us(report.assignment.p99) << " us ("
+       << report.assignment.count << " rondas)\n";
+  }
+  // Espera en cola (reloj virtual) por clase de prioridad: las que
+  // salieron de la cola y, aparte, la más antigua de las que siguen
+  const char *classNames[4] = {"low", "normal", "high", "urgent"};
+  os << "[Scenario] Espera p99 (s):     ";
+  for (int level = 0; level < 4; ++level) {
+    os << (level > 0 ? " / " : "") << classNames[level] << " "
+       << report.wait[level].p99 / 1e3;
+  }
+  os << "\n";
+  if (report.tasksPending > 0) {
+    os << "[Scenario] En cola, máx (s):    ";
+    for (int level = 0; level < 4; ++level) {
+      os << (level > 0 ? " / " : "") << classNames[level] << " "
+         << report.oldestPendingMs[level] / 1e3;
+    }
+    os << "\n";
+  }
+  if (report.deadlinesMissed > 0) {
+    os << "[Scenario] Plazos incumplidos:  " << report.deadlinesMissed
+       << "\n";
+  }
+  if (report.routeEstimatedCells > 0 || report.routeSavedCells > 0) {
+    os << "[Scenario] Rutas:               " << report.routeEstimatedCells
+       << " celdas estimadas, " << report.routeActualCells << " reales ("
+       << report.routeSavedCells << " ahorradas al reordenar)\n";
+  }
+  os << "[Scenario] Huella de estado:    0x" << std::hex << std::setw(16)
+     << std::setfill('0') << report.digest << std::dec << std::setfill(' ')
+     << std::defaultfloat << std::endl;
+}
+
+} // namespace OSBot
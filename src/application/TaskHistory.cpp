@@ -0,0 +1,67 @@
+#include "application/TaskHistory.h"
+#include <algorithm>
+
+namespace OSBot {
+
+namespace {
+int64_t toMs(Task::TimePoint time) {
+  if (time == Task::TimePoint{})
+    return 0;
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             time.time_since_epoch())
+      .count();
+}
+} // namespace
+
+TaskHistory::TaskHistory(size_t capacity)
+    : ring_(std::max<size_t>(1, capacity)) {}
+
+void TaskHistory::record(const Task &task) {
+  TaskRecord &slot = ring_[head_];
+  if (size_ == ring_.size()) {
+    // Lleno: se sobrescribe la más antigua
+    auto it = slots_.find(slot.id);
+    if (it != slots_.end() && it->second == head_)
+      slots_.erase(it);
+  } else {
+    size_++;
+  }
+
+  slot.id = task.getId();
+  slot.status = task.getStatus();
+  slot.priority = task.getPriority();
+  slot.robotId = task.getAssignedRobotId();
+  slot.waypointsVisited = task.getCurrentWaypointIndex();
+  slot.waypointCount = static_cast<int>(task.getWaypoints().size());
+  slot.createdMs = toMs(task.getCreatedTime());
+  slot.startMs = toMs(task.getStartTime());
+  slot.finishedMs = toMs(task.getCompletionTime());
+
+  slots_[slot.id] = head_;
+  head_ = (head_ + 1) % ring_.size();
+  totalRecorded_++;
+}
+
+bool TaskHistory::find(int taskId, TaskRecord &out) const {
+  auto it = slots_.find(taskId);
+  if (it == slots_.end())
+    return false;
+  out = ring_[it->second];
+  return true;
+}
+
+void TaskHistory::recent(size_t limit, std::vector<TaskRecord> &out) const {
+  out.clear();
+  size_t count = std::min(limit, size_);
+  out.reserve(count);
+  for (size_t i = 1; i <= count; ++i)
+    out.push_back(ring_[(head_ + ring_.size() - i) % ring_.size()]);
+}
+
+void TaskHistory::clear() {
+  head_ = 0;
+  size_ = 0;
+  slots_.clear();
+}
+
+} // namespace OSBot
@@ -1,74 +1,212 @@
 #include "application/TaskManager.h"
+#include "application/AssignmentSolver.h"
+#include "domain/SimulationClock.h"
+#include "infrastructure/Metrics.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace OSBot {
 
-TaskManager::TaskManager(RobotManager& robotManager)
+namespace {
+// Recargo para robots sin camino hasta la tarea (mayor que cualquier ruta)
+constexpr double UNREACHABLE_COST = 1e6;
+
+// Pesos de SchedulingPolicy::FAIR por clase (LOW..URGENT)
+constexpr double FAIR_WEIGHTS[4] = {1.0, 2.0, 4.0, 8.0};
+
+double toMs(Task::TimePoint time) {
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count());
+}
+
+/**
+ * @brief Registra la espera en cola de 'task' hasta 'end' en ms (reloj de
+ * la simulación) en el histograma de su clase
+ */
+void recordWait(TaskPriority priority, const Task& task, Task::TimePoint end) {
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end - task.getCreatedTime()).count();
+    TaskManager::waitHistogram(priority).record(
+        static_cast<uint64_t>(std::max<int64_t>(0, wait)));
+}
+} // namespace
+
+TaskManager::TaskManager(RobotManager& robotManager, size_t historyCapacity)
     : robotManager_(robotManager)
+    , history_(historyCapacity)
     , nextTaskId_(1)
+    , assignmentMode_(AssignmentMode::GREEDY)
+    , schedulingPolicy_(SchedulingPolicy::PRIORITY)
+    , fairVirtualTime_(0.0)
+    , fairLastRank_{0.0, 0.0, 0.0, 0.0}
+    , optimizeRoutes_(false)
+    , distanceFields_(robotManager.getEnvironment())
+    , routeOptimizer_(robotManager.getEnvironment())
 {
 }
 
+LatencyHistogram& TaskManager::waitHistogram(TaskPriority priority) {
+    // En ms y no en ns: en ns el histograma satura a los ~36 minutos
+    static LatencyHistogram* waitHist[4] = {
+        &Metrics::instance().histogram("task.wait_ms.low", HistogramUnit::MILLISECONDS),
+        &Metrics::instance().histogram("task.wait_ms.normal", HistogramUnit::MILLISECONDS),
+        &Metrics::instance().histogram("task.wait_ms.high", HistogramUnit::MILLISECONDS),
+        &Metrics::instance().histogram("task.wait_ms.urgent", HistogramUnit::MILLISECONDS),
+    };
+    return *waitHist[static_cast<int>(priority)];
+}
+
 TaskManager::~TaskManager() {
+    // Quien conserve una tarea no debe actualizar contadores ya destruidos
+    for (auto& [id, task] : allTasks_) {
+        task->attachStats(nullptr);
+    }
 }
 
-int TaskManager::createTask(const std::vector<Point>& waypoints, TaskPriority priority) {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
+int TaskManager::createTask(const std::vector<Point>& waypoints, TaskPriority priority,
+                            int deadlineMs) {
+    static LatencyHistogram& optimizeHist =
+        Metrics::instance().histogram("route.optimize");
+    static std::atomic<uint64_t>& savedCells =
+        Metrics::instance().counter("route.saved_cells");
+    
+    bool optimize = false;
+    RouteOptions options;
+    {
+        std::lock_guard<KernelMutex> lock(tasksMutex_);
+        optimize = optimizeRoutes_;
+        options = routeOptions_;
+    }
+    
+    // Reordenar fuera de tasksMutex_: los BFS de la ruta no usan la cache
+    // del planificador; solo se toma un momento el lock del mapa
+    std::vector<Point> route = waypoints;
+    int64_t routeCells = -1;
+    if (optimize && waypoints.size() > 1) {
+        RouteResult result;
+        {
+            ScopedTimer timer(optimizeHist);
+            result = routeOptimizer_.optimize(waypoints, options);
+        }
+        for (size_t i = 0; i < route.size(); ++i) {
+            route[i] = waypoints[static_cast<size_t>(result.order[i])];
+        }
+        routeCells = result.optimizedCells;
+        if (result.originalCells >= 0 && result.optimizedCells >= 0) {
+            savedCells.fetch_add(static_cast<uint64_t>(result.originalCells - result.optimizedCells),
+                                 std::memory_order_relaxed);
+        }
+    }
+    
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
     
     int taskId = nextTaskId_++;
-    auto task = std::make_shared<Task>(taskId, waypoints, priority);
+    auto task = std::make_shared<Task>(taskId, route, priority);
+    task->setEstimatedRouteCells(routeCells);
+    if (deadlineMs > 0) {
+        task->setDeadline(task->getCreatedTime() + std::chrono::milliseconds(deadlineMs));
+    }
     
+    task->attachStats(&stats_);
     allTasks_[taskId] = task;
-    pendingTasks_.push(task);
+    pendingTasks_.push(taskId, makePending(task));
     
     return taskId;
 }
 
 bool TaskManager::cancelTask(int taskId) {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
     
     auto it = allTasks_.find(taskId);
     if (it != allTasks_.end()) {
         auto task = it->second;
         
-        if (task->getStatus() == TaskStatus::PENDING || 
-            task->getStatus() == TaskStatus::ASSIGNED) {
+        if (task->getStatus() == TaskStatus::PENDING || task->isActive()) {
+            // Una tarea que sale de la cola sin arrancar también esperó:
+            // sin esta muestra la inanición no se vería en task.wait_ms
+            if (const PendingTask* entry = pendingTasks_.find(taskId)) {
+                recordWait(entry->priority, *task, SimulationClock::now());
+                pendingTasks_.erase(taskId);
+            }
             task->setStatus(TaskStatus::CANCELLED);
             
             // Desasignar del robot si estaba asignada
             if (task->getAssignedRobotId() != -1) {
                 robotManager_.unassignTask(task->getAssignedRobotId());
             }
+            archiveTask(it);
             return true;
         }
     }
     return false;
 }
 
+bool TaskManager::setTaskPriority(int taskId, TaskPriority priority) {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    
+    auto it = allTasks_.find(taskId);
+    if (it == allTasks_.end() || it->second->getStatus() != TaskStatus::PENDING) {
+        return false;
+    }
+    
+    const PendingTask* entry = pendingTasks_.find(taskId);
+    if (!entry || entry->priority == priority) {
+        return entry != nullptr; // Misma clase: no se vuelve a encolar
+    }
+    
+    // FAIR: la clase de origen deja de pagar por esta tarea. Su última
+    // etiqueta pasa a ser la mayor de las que le quedan en cola
+    TaskPriority previous = entry->priority;
+    double previousRank = entry->rank;
+    it->second->setPriority(priority);
+    pendingTasks_.update(taskId, makePending(it->second));
+    if (schedulingPolicy_ == SchedulingPolicy::FAIR) {
+        int level = static_cast<int>(previous);
+        if (fairLastRank_[level] == previousRank) {
+            double last = fairVirtualTime_;
+            for (const auto& queued : pendingTasks_.entries()) {
+                if (queued.value.priority == previous) {
+                    last = std::max(last, queued.value.rank);
+                }
+            }
+            fairLastRank_[level] = last;
+        }
+    }
+    return true;
+}
+
 std::shared_ptr<Task> TaskManager::getTask(int taskId) const {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
     
     auto it = allTasks_.find(taskId);
     return (it != allTasks_.end()) ? it->second : nullptr;
 }
 
 void TaskManager::scheduleNextTasks() {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
+    static LatencyHistogram& lockWait =
+        Metrics::instance().histogram("lock.tasks.wait");
+    auto lock = timedLock(tasksMutex_, lockWait);
+    
+    if (assignmentMode_ == AssignmentMode::BATCH) {
+        scheduleBatch();
+        return;
+    }
     
     // Intentar asignar tareas pendientes a robots disponibles
     while (!pendingTasks_.empty()) {
-        auto task = pendingTasks_.top();
+        PendingTask entry = pendingTasks_.top().value;
         
         // Verificar que la tarea siga pendiente
-        if (task->getStatus() != TaskStatus::PENDING) {
+        if (entry.task->getStatus() != TaskStatus::PENDING) {
             pendingTasks_.pop();
             continue;
         }
         
         // Intentar asignar a un robot
-        if (assignTaskToRobot(task)) {
+        if (assignTaskToRobot(entry.task)) {
             pendingTasks_.pop();
+            onTaskStarted(entry);
         } else {
             // No hay robots disponibles, esperar
             break;
@@ -76,71 +214,233 @@ void TaskManager::scheduleNextTasks() {
     }
 }
 
+void TaskManager::setAssignmentMode(AssignmentMode mode) {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    assignmentMode_ = mode;
+}
+
+AssignmentMode TaskManager::getAssignmentMode() const {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    return assignmentMode_;
+}
+
+void TaskManager::setSchedulingPolicy(SchedulingPolicy policy) {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    if (policy == schedulingPolicy_) {
+        return;
+    }
+    schedulingPolicy_ = policy;
+    
+    // Los rangos dependen de la política: recalcular la cola en orden de
+    // llegada (FAIR reparte los rangos a partir del tiempo virtual actual)
+    std::vector<std::shared_ptr<Task>> pending;
+    pending.reserve(pendingTasks_.size());
+    for (const auto& entry : pendingTasks_.entries()) {
+        pending.push_back(entry.value.task);
+    }
+    std::sort(pending.begin(), pending.end(),
+              [](const auto& a, const auto& b) { return a->getId() < b->getId(); });
+    
+    pendingTasks_.clear();
+    std::fill(std::begin(fairLastRank_), std::end(fairLastRank_), fairVirtualTime_);
+    for (const auto& task : pending) {
+        pendingTasks_.push(task->getId(), makePending(task));
+    }
+}
+
+void TaskManager::setRouteOptimization(bool enabled, const RouteOptions& options) {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    optimizeRoutes_ = enabled;
+    routeOptions_ = options;
+}
+
+SchedulingPolicy TaskManager::getSchedulingPolicy() const {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    return schedulingPolicy_;
+}
+
+PendingTask TaskManager::makePending(const std::shared_ptr<Task>& task) {
+    TaskPriority priority = task->getPriority();
+    int level = static_cast<int>(priority);
+    double rank = 0.0;
+    
+    switch (schedulingPolicy_) {
+    case SchedulingPolicy::PRIORITY:
+        rank = -level;
+        break;
+    case SchedulingPolicy::DEADLINE:
+        rank = task->hasDeadline() ? toMs(task->getDeadline())
+                                   : std::numeric_limits<double>::infinity();
+        break;
+    case SchedulingPolicy::AGING:
+        // Esperar AGING_STEP_MS equivale a un nivel más de prioridad
+        rank = toMs(task->getCreatedTime()) - static_cast<double>(level * AGING_STEP_MS);
+        break;
+    case SchedulingPolicy::FAIR:
+        // Etiqueta de fin virtual: cada tarea de la clase 'avanza' 1/peso
+        rank = std::max(fairVirtualTime_, fairLastRank_[level]) + 1.0 / FAIR_WEIGHTS[level];
+        fairLastRank_[level] = rank;
+        break;
+    }
+    return {rank, priority, task};
+}
+
+void TaskManager::onTaskStarted(const PendingTask& entry) {
+    static std::atomic<uint64_t>& deadlineMissed =
+        Metrics::instance().counter("task.deadline_missed");
+    
+    // Espera en cola: creación -> asignación
+    const Task& task = *entry.task;
+    recordWait(entry.priority, task, task.getStartTime());
+    if (task.hasDeadline() && task.getStartTime() > task.getDeadline()) {
+        deadlineMissed.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    if (schedulingPolicy_ == SchedulingPolicy::FAIR) {
+        fairVirtualTime_ = std::max(fairVirtualTime_, entry.rank);
+    }
+    activeTasks_.push_back(entry.task);
+}
+
 void TaskManager::update() {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
+    static LatencyHistogram& lockWait =
+        Metrics::instance().histogram("lock.tasks.wait");
+    static std::atomic<uint64_t>& estimatedCells =
+        Metrics::instance().counter("route.estimated_cells");
+    static std::atomic<uint64_t>& actualCells =
+        Metrics::instance().counter("route.actual_cells");
+    auto lock = timedLock(tasksMutex_, lockWait);
     
-    // Actualizar el estado de las tareas activas
-    for (auto& [id, task] : allTasks_) {
-        if (task->isActive()) {
-            int robotId = task->getAssignedRobotId();
-            if (robotId != -1) {
-                const RobotInfo* robotInfo = robotManager_.getRobotInfo(robotId);
-                if (robotInfo) {
-                    // Verificar si el robot alcanzó el waypoint actual
-                    Point robotPos = robotInfo->robot->getPosition();
-                    Point targetWaypoint = task->getCurrentWaypoint();
-                    
-                    if (robotPos == targetWaypoint) {
-                        task->advanceToNextWaypoint();
-                        
-                        if (!task->hasMoreWaypoints()) {
-                            task->setStatus(TaskStatus::COMPLETED);
-                            robotManager_.unassignTask(robotId);
-                        }
-                    }
+    // Las canceladas siguen en activeTasks_ hasta esta pasada: se quitan
+    // aquí en lugar de buscarlas al cancelar
+    activeTasks_.erase(std::remove_if(activeTasks_.begin(), activeTasks_.end(),
+                                      [](const auto& task) { return !task->isActive(); }),
+                       activeTasks_.end());
+    
+    // Posición y estado de los robots ocupados, con un solo lock
+    activeRobotIds_.clear();
+    for (const auto& task : activeTasks_) {
+        activeRobotIds_.push_back(task->getAssignedRobotId());
+    }
+    robotManager_.getRobotProgress(activeRobotIds_, activeProgress_);
+    
+    // Actualizar el estado de las tareas activas; las que terminan pasan
+    // al historial
+    size_t kept = 0;
+    for (size_t i = 0; i < activeTasks_.size(); ++i) {
+        auto& task = activeTasks_[i];
+        int robotId = activeRobotIds_[i];
+        const RobotProgress& robot = activeProgress_[i];
+        bool finished = false;
+        
+        if (robotId != -1 && robot.found) {
+            // Verificar si el robot alcanzó el waypoint actual
+            if (robot.position == task->getCurrentWaypoint()) {
+                if (task->getCurrentWaypointIndex() == 0) {
+                    task->setRouteStartCells(robot.cellsTraveled);
+                }
+                task->advanceToNextWaypoint();
+                
+                if (!task->hasMoreWaypoints()) {
+                    task->setStatus(TaskStatus::COMPLETED);
+                    robotManager_.unassignTask(robotId);
+                    finished = true;
                     
-                    // Verificar si el robot está bloqueado
-                    if (robotInfo->currentState == State::BLOCKED) {
-                        task->setStatus(TaskStatus::FAILED);
-                        robotManager_.unassignTask(robotId);
+                    // Ruta estimada al crearla frente a lo recorrido de verdad
+                    if (task->getEstimatedRouteCells() >= 0 && task->getRouteStartCells() >= 0) {
+                        estimatedCells.fetch_add(static_cast<uint64_t>(task->getEstimatedRouteCells()),
+                                                 std::memory_order_relaxed);
+                        actualCells.fetch_add(static_cast<uint64_t>(robot.cellsTraveled - task->getRouteStartCells()),
+                                              std::memory_order_relaxed);
                     }
+                } else {
+                    // Siguiente tramo de la tarea
+                    robotManager_.setRobotGoal(robotId, task->getCurrentWaypoint());
                 }
+            } else if (robot.state == State::BLOCKED) {
+                // El robot está bloqueado
+                task->setStatus(TaskStatus::FAILED);
+                robotManager_.unassignTask(robotId);
+                finished = true;
+            }
+        } else {
+            // El robot se eliminó con la tarea en curso: nadie la terminará
+            task->setStatus(TaskStatus::FAILED);
+            finished = true;
+        }
+        
+        if (finished) {
+            archiveTask(allTasks_.find(task->getId()));
+        } else {
+            if (kept != i) {
+                activeTasks_[kept] = std::move(task);
             }
+            kept++;
         }
     }
+    activeTasks_.resize(kept);
+}
+
+std::map<int, std::shared_ptr<Task>>::iterator
+TaskManager::archiveTask(std::map<int, std::shared_ptr<Task>>::iterator it) {
+    history_.record(*it->second);
+    it->second->detachStats(); // Sigue contada en su estado final
+    return allTasks_.erase(it);
+}
+
+size_t TaskManager::getTaskCount(TaskStatus status) const {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    return stats_.count(status);
+}
+
+bool TaskManager::getTaskRecord(int taskId, TaskRecord& out) const {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    return history_.find(taskId, out);
+}
+
+std::vector<TaskRecord> TaskManager::getRecentHistory(size_t limit) const {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    std::vector<TaskRecord> records;
+    history_.recent(limit, records);
+    return records;
+}
+
+void TaskManager::visitHistory(const std::function<void(const TaskRecord&)>& visit) const {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    history_.forEach(visit);
+}
+
+void TaskManager::getOldestPendingWaitMs(int64_t out[4]) const {
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    
+    // Recorrido completo de la cola: consulta de informes, no de cada tick
+    Task::TimePoint now = SimulationClock::now();
+    std::fill(out, out + 4, int64_t{0});
+    for (const auto& queued : pendingTasks_.entries()) {
+        int level = static_cast<int>(queued.value.priority);
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - queued.value.task->getCreatedTime()).count();
+        out[level] = std::max(out[level], static_cast<int64_t>(wait));
+    }
 }
 
 size_t TaskManager::getPendingTaskCount() const {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
     return pendingTasks_.size();
 }
 
 size_t TaskManager::getActiveTaskCount() const {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
-    
-    size_t count = 0;
-    for (const auto& [id, task] : allTasks_) {
-        if (task->isActive()) {
-            count++;
-        }
-    }
-    return count;
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    return stats_.count(TaskStatus::ASSIGNED) + stats_.count(TaskStatus::IN_PROGRESS);
 }
 
 size_t TaskManager::getCompletedTaskCount() const {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
-    
-    size_t count = 0;
-    for (const auto& [id, task] : allTasks_) {
-        if (task->isCompleted()) {
-            count++;
-        }
-    }
-    return count;
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
+    return stats_.count(TaskStatus::COMPLETED);
 }
 
 std::vector<std::shared_ptr<Task>> TaskManager::getAllTasks() const {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
     
     std::vector<std::shared_ptr<Task>> tasks;
     tasks.reserve(allTasks_.size());
@@ -151,7 +451,7 @@ std::vector<std::shared_ptr<Task>> TaskManager::getAllTasks() const {
 }
 
 std::vector<std::shared_ptr<Task>> TaskManager::getTasksByStatus(TaskStatus status) const {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
     
     std::vector<std::shared_ptr<Task>> tasks;
     for (const auto& [id, task] : allTasks_) {
@@ -163,87 +463,134 @@ std::vector<std::shared_ptr<Task>> TaskManager::getTasksByStatus(TaskStatus stat
 }
 
 double TaskManager::getAverageCompletionTime() const {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
     
-    double totalTime = 0.0;
-    int count = 0;
-    
-    for (const auto& [id, task] : allTasks_) {
-        if (task->isCompleted()) {
-            auto duration = std::chrono::duration_cast<std::chrono::seconds>(
-                task->getCompletionTime() - task->getStartTime()
-            ).count();
-            totalTime += duration;
-            count++;
-        }
-    }
-    
-    return (count > 0) ? totalTime / count : 0.0;
+    size_t count = stats_.count(TaskStatus::COMPLETED);
+    return (count > 0) ? static_cast<double>(stats_.completedSeconds) / count : 0.0;
 }
 
 double TaskManager::getSuccessRate() const {
-    std::lock_guard<std::mutex> lock(tasksMutex_);
-    
-    int completed = 0;
-    int total = 0;
-    
-    for (const auto& [id, task] : allTasks_) {
-        if (task->isCompleted() || task->isFailed()) {
-            total++;
-            if (task->isCompleted()) {
-                completed++;
-            }
-        }
-    }
+    std::lock_guard<KernelMutex> lock(tasksMutex_);
     
+    size_t completed = stats_.count(TaskStatus::COMPLETED);
+    size_t total = completed + stats_.count(TaskStatus::FAILED);
     return (total > 0) ? (static_cast<double>(completed) / total * 100.0) : 100.0;
 }
 
 bool TaskManager::assignTaskToRobot(std::shared_ptr<Task> task) {
-    int bestRobotId = findBestRobotForTask(*task);
+    static std::atomic<uint64_t>& approachCells =
+        Metrics::instance().counter("schedule.approach_cells");
+    
+    double cost = 0.0;
+    int bestRobotId = findBestRobotForTask(*task, &cost);
     
+    // Si assignTask falla es que otro hilo ocupó el robot entre la consulta
+    // y la asignación: la tarea espera a la próxima ronda
     if (bestRobotId != -1) {
         if (robotManager_.assignTask(bestRobotId, task)) {
-            task->setStatus(TaskStatus::ASSIGNED);
+            // assignTask ya fijó el objetivo del robot: la tarea arranca
+            task->setStatus(TaskStatus::IN_PROGRESS);
+            if (cost < UNREACHABLE_COST) {
+                approachCells.fetch_add(static_cast<uint64_t>(cost), std::memory_order_relaxed);
+            }
             return true;
         }
     }
     return false;
 }
 
-int TaskManager::findBestRobotForTask(const Task& task) const {
-    auto robotIds = robotManager_.getRobotIds();
+void TaskManager::scheduleBatch() {
+    static LatencyHistogram& solveHist =
+        Metrics::instance().histogram("schedule.assignment_solve");
+    static std::atomic<uint64_t>& approachCells =
+        Metrics::instance().counter("schedule.approach_cells");
+    
+    // Robots libres (filas de la matriz), leídos con un solo lock
+    robotManager_.getAvailableRobots(availableRobots_);
+    const std::vector<AvailableRobot>& robots = availableRobots_;
     
-    int bestRobotId = -1;
-    double bestCost = std::numeric_limits<double>::max();
+    // Tareas de la ronda (columnas): como mucho una por robot libre, en
+    // orden de prioridad
+    std::vector<PendingTask> batch;
+    while (!pendingTasks_.empty() && batch.size() < robots.size()) {
+        PendingTask entry = pendingTasks_.top().value;
+        pendingTasks_.pop();
+        if (entry.task->getStatus() == TaskStatus::PENDING) {
+            batch.push_back(std::move(entry));
+        }
+    }
+    if (batch.empty()) {
+        return;
+    }
     
-    for (int robotId : robotIds) {
-        if (robotManager_.isRobotAvailable(robotId)) {
-            double cost = calculateTaskCost(robotId, task);
-            if (cost < bestCost) {
-                bestCost = cost;
-                bestRobotId = robotId;
+    // Un BFS por tarea (o ninguno si el campo está en caché) y N lecturas
+    std::vector<double> cost(robots.size() * batch.size());
+    for (size_t t = 0; t < batch.size(); ++t) {
+        auto toTask = distanceFields_.get(batch[t].task->getWaypoints().front());
+        for (size_t r = 0; r < robots.size(); ++r) {
+            cost[r * batch.size() + t] = travelCost(robots[r].position, *toTask);
+        }
+    }
+    
+    AssignmentResult result;
+    {
+        ScopedTimer timer(solveHist);
+        result = AssignmentSolver::solve(cost, robots.size(), batch.size());
+    }
+    
+    std::vector<bool> taskAssigned(batch.size(), false);
+    for (size_t r = 0; r < robots.size(); ++r) {
+        int t = result.rowToCol[r];
+        if (t < 0) {
+            continue;
+        }
+        auto& task = batch[static_cast<size_t>(t)].task;
+        if (robotManager_.assignTask(robots[r].id, task)) {
+            task->setStatus(TaskStatus::IN_PROGRESS);
+            onTaskStarted(batch[static_cast<size_t>(t)]);
+            taskAssigned[static_cast<size_t>(t)] = true;
+            double taskCost = cost[r * batch.size() + t];
+            if (taskCost < UNREACHABLE_COST) {
+                approachCells.fetch_add(static_cast<uint64_t>(taskCost),
+                                        std::memory_order_relaxed);
             }
         }
     }
     
-    return bestRobotId;
+    // Lo que no se pudo asignar vuelve a la cola (con su rango) para la
+    // próxima ronda
+    for (size_t t = 0; t < batch.size(); ++t) {
+        if (!taskAssigned[t]) {
+            pendingTasks_.push(batch[t].task->getId(), std::move(batch[t]));
+        }
+    }
 }
 
-double TaskManager::calculateTaskCost(int robotId, const Task& task) const {
-    const RobotInfo* robotInfo = robotManager_.getRobotInfo(robotId);
-    if (!robotInfo || !robotInfo->robot) {
-        return std::numeric_limits<double>::max();
-    }
-    
-    Point robotPos = robotInfo->robot->getPosition();
+int TaskManager::findBestRobotForTask(const Task& task, double* bestCostOut) const {
     Point taskStart = task.getWaypoints().front();
+    auto toTask = distanceFields_.get(taskStart);
     
-    // Costo basado en distancia Manhattan
+    // La distancia de grid nunca es menor que la Manhattan: la búsqueda por
+    // anillos del índice espacial puede cortar sin perder el óptimo
+    return robotManager_.findBestAvailable(
+        taskStart,
+        [&](const Point& robotPos) { return travelCost(robotPos, *toTask); },
+        bestCostOut);
+}
+
+double TaskManager::travelCost(const Point& robotPos, const DistanceField& toTask) {
+    // Costo basado en la distancia real de grid (BFS desde el waypoint)
+    int32_t cells = toTask.distanceFrom(robotPos);
+    if (cells != DistanceField::UNREACHABLE) {
+        return static_cast<double>(cells);
+    }
+    
+    // Sin camino: costo finito pero peor que cualquier robot alcanzable, para
+    // que la tarea no bloquee la cola si nadie puede llegar
+    Point taskStart = toTask.getTarget();
     int dx = std::abs(robotPos.x - taskStart.x);
     int dy = std::abs(robotPos.y - taskStart.y);
-    
-    return static_cast<double>(dx + dy);
+    return UNREACHABLE_COST + static_cast<double>(dx + dy);
 }
 
 } // namespace OSBot
@@ -0,0 +1,360 @@
+#include "application/WorldSnapshot.h"
+#include "application/RobotManager.h"
+#include "domain/Environment.h"
+#include "infrastructure/Gzip.h"
+#include "infrastructure/JsonWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace OSBot {
+
+namespace {
+
+// "state" se envía como cadena ("0".."5") por compatibilidad con el cliente
+constexpr std::string_view STATE_NAMES[] = {"0", "1", "2", "3", "4", "5"};
+
+std::string_view stateName(State state) {
+  auto index = static_cast<size_t>(state);
+  return index < std::size(STATE_NAMES) ? STATE_NAMES[index] : "?";
+}
+
+using SnapshotRobot = WorldSnapshot::Robot;
+
+// Registro de robot en /api/state
+constexpr auto ROBOT_SCHEMA = makeJsonSchema(
+    jsonField("id", [](const SnapshotRobot &r) { return r.id; }),
+    jsonField("x", [](const SnapshotRobot &r) { return r.position.x; }),
+    jsonField("y", [](const SnapshotRobot &r) { return r.position.y; }),
+    jsonField("state", [](const SnapshotRobot &r) { return stateName(r.state); }),
+    jsonField("obstaclesAvoided", [](const SnapshotRobot &r) { return r.obstaclesAvoided; }),
+    jsonField("active", [](const SnapshotRobot &r) { return r.active; }),
+    jsonField("goalX", [](const SnapshotRobot &r) { return r.goal.x; }),
+    jsonField("goalY", [](const SnapshotRobot &r) { return r.goal.y; }),
+    jsonField("hasPersonalGoal", [](const SnapshotRobot &r) { return r.hasPersonalGoal; }));
+
+// Frame binario de /api/state.bin (formato documentado en WorldSnapshot.h)
+constexpr uint32_t FRAME_MAGIC = 0x5342534F; // "OSBS" en little-endian
+constexpr uint16_t FRAME_FORMAT = 2;
+constexpr size_t FRAME_HEADER_SIZE = 64;
+constexpr uint32_t FRAME_ROBOT_SIZE = 16;
+
+// Cota superior de un registro de ROBOT_SCHEMA (claves + 7 enteros de 11)
+constexpr size_t ROBOT_JSON_SIZE = 256;
+constexpr size_t STATS_JSON_SIZE = 512;
+
+/**
+ * @brief Tamaño de /api/state, para reservar el buffer de una sola vez
+ */
+size_t estimateStateSize(int width, int height, size_t robots) {
+  size_t cells = static_cast<size_t>(width) * height;
+  return 2 * cells + 2 * static_cast<size_t>(height) + 256 +
+         robots * ROBOT_JSON_SIZE;
+}
+
+/**
+ * @brief Escribe las filas del grid ([[0,1,...],...]) directamente al buffer
+ * Cada fila ocupa exactamente 2*width+1 bytes, así que se reserva el bloque
+ * completo y se rellena sin comprobaciones por celda.
+ */
+void writeGridCells(JsonWriter &json, const WorldSnapshot::Grid &grid) {
+  int width = grid.width;
+  int height = grid.height;
+  if (width <= 0 || height <= 0 ||
+      grid.packed.size() < GridCodec::packedSize(width, height)) {
+    json.beginArray();
+    json.endArray();
+    return;
+  }
+
+  size_t rowBytes = 2 * static_cast<size_t>(width) + 1;
+  size_t total = 2 + height * rowBytes + (height - 1);
+  char *p = json.appendRaw(total);
+
+  *p++ = '[';
+  const auto *bits = reinterpret_cast<const uint8_t *>(grid.packed.data());
+  size_t cell = 0;
+  for (int y = 0; y < height; ++y) {
+    if (y > 0)
+      *p++ = ',';
+    *p++ = '[';
+    // Cada celda es el par "d,": una copia de 2 bytes por celda
+    static constexpr char CELL_PAIRS[2][2] = {{'0', ','}, {'1', ','}};
+    for (int x = 0; x < width; ++x, ++cell) {
+      std::memcpy(p + 2 * x, CELL_PAIRS[(bits[cell / 8] >> (cell % 8)) & 1], 2);
+    }
+    p += 2 * static_cast<size_t>(width);
+    p[-1] = ']'; // La última coma de la fila cierra el array
+  }
+  *p = ']';
+}
+
+} // namespace
+
+uint64_t WorldSnapshot::bootEpoch() {
+  static const uint64_t epoch = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+  return epoch;
+}
+
+std::shared_ptr<const WorldSnapshot>
+WorldSnapshot::capture(const Environment &env, const RobotManager &robots,
+                       uint64_t tick, bool paused, int speed,
+                       const WorldSnapshot *previous) {
+  // Referencia del uptime: la primera captura (arranque del kernel)
+  static const auto startTime = std::chrono::steady_clock::now();
+
+  auto snapshot = std::make_shared<WorldSnapshot>();
+  snapshot->tick_ = tick;
+  snapshot->paused_ = paused;
+  snapshot->speed_ = speed;
+  snapshot->goal_ = env.getGoal();
+
+  // Grid: solo se copia y empaqueta si la versión del mapa cambió
+  int width = env.getWidth();
+  int height = env.getHeight();
+  const Grid *previousGrid = previous ? previous->grid_.get() : nullptr;
+  if (previousGrid && previousGrid->version == env.getMapVersion() &&
+      previousGrid->width == width && previousGrid->height == height) {
+    snapshot->grid_ = previous->grid_;
+  } else {
+    std::vector<uint8_t> mask;
+    auto grid = std::make_shared<Grid>();
+    grid->version = env.copyObstacleMask(mask);
+    grid->width = width;
+    grid->height = height;
+    GridCodec::pack(mask, width, height, grid->packed);
+    snapshot->grid_ = std::move(grid);
+  }
+
+  // Robots y agregados de estadísticas en una sola pasada bajo robotsMutex_
+  Stats &stats = snapshot->stats_;
+  snapshot->robots_.reserve(robots.getRobotCount());
+  robots.forEachRobot([&](const RobotInfo &info) {
+    stats.totalRobots++;
+    if (!info.robot)
+      return;
+
+    snapshot->robots_.push_back({info.id, info.robot->getPosition(),
+                                 info.currentGoal, info.currentState,
+                                 info.obstaclesAvoided, info.isActive,
+                                 info.hasPersonalGoal});
+
+    // Contar robots por estado
+    State state = info.robot->getState();
+    if (state == State::NAVIGATING) {
+      stats.activeRobots++;
+    } else if (state == State::IDLE || state == State::REACHED_GOAL) {
+      stats.idleRobots++;
+    }
+
+    stats.totalDistance += info.totalDistanceTraveled;
+    stats.completedTasks += info.tasksCompleted;
+    stats.failedTasks += info.tasksFailed;
+    stats.cellsTraveled += info.cellsTraveled;
+  });
+  stats.uptimeSeconds = std::chrono::duration_cast<std::chrono::seconds>(
+                            std::chrono::steady_clock::now() - startTime)
+                            .count();
+
+  // Mismo mundo que la foto anterior: misma versión y mismas serializaciones
+  if (previous && snapshot->sameWorld(*previous)) {
+    snapshot->version_ = previous->version_;
+    snapshot->worldMemos_ = previous->worldMemos_;
+  } else if (previous) {
+    snapshot->version_ = previous->version_ + 1;
+  }
+
+  return snapshot;
+}
+
+bool WorldSnapshot::sameWorld(const WorldSnapshot &other) const {
+  if (paused_ != other.paused_ || speed_ != other.speed_ ||
+      !(goal_ == other.goal_) || grid_ != other.grid_ ||
+      robots_.size() != other.robots_.size())
+    return false;
+
+  // Agregados de /api/stats, que comparte la versión (salvo el uptime)
+  const Stats &a = stats_;
+  const Stats &b = other.stats_;
+  if (a.totalRobots != b.totalRobots || a.activeRobots != b.activeRobots ||
+      a.idleRobots != b.idleRobots || a.totalDistance != b.totalDistance ||
+      a.completedTasks != b.completedTasks || a.failedTasks != b.failedTasks ||
+      a.cellsTraveled != b.cellsTraveled)
+    return false;
+
+  return std::equal(robots_.begin(), robots_.end(), other.robots_.begin(),
+                    [](const Robot &a, const Robot &b) {
+                      return a.id == b.id && a.position == b.position &&
+                             a.goal == b.goal && a.state == b.state &&
+                             a.obstaclesAvoided == b.obstaclesAvoided &&
+                             a.active == b.active &&
+                             a.hasPersonalGoal == b.hasPersonalGoal;
+                    });
+}
+
+// ============================================================================
+// Formas memoizadas
+// ============================================================================
+
+const std::string &WorldSnapshot::stateJSON() const {
+  return memoize(worldMemos_->stateJSON,
+                 [this](std::string &out) { writeStateJSON(out); });
+}
+
+const std::string &WorldSnapshot::stateJSONGzip(int level) const {
+  return memoize(worldMemos_->stateJSONGzip, [this, level](std::string &out) {
+    const std::string &json = stateJSON();
+    if (!Gzip::compress(json, out, level) || out.size() >= json.size())
+      out.clear();
+  });
+}
+
+const std::string &WorldSnapshot::statsJSON() const {
+  return memoize(statsJSON_,
+                 [this](std::string &out) { writeStatsJSON(out); });
+}
+
+const std::string &WorldSnapshot::frame() const {
+  return memoize(frame_,
+                 [this](std::string &out) { writeFrame(out, 0, 0, nullptr); });
+}
+
+const std::string &WorldSnapshot::unchangedFrame() const {
+  return memoize(unchangedFrame_, [this](std::string &out) {
+    writeFrame(out, bootEpoch(), grid_->version, nullptr);
+  });
+}
+
+// ============================================================================
+// Serialización
+// ============================================================================
+
+void WorldSnapshot::writeStateJSON(std::string &out) const {
+  const Grid &grid = *grid_;
+
+  out.clear();
+  out.reserve(estimateStateSize(grid.width, grid.height, robots_.size()));
+  JsonWriter json(out);
+
+  json.beginObject();
+  json.key("grid");
+  json.beginObject();
+  json.field("width", grid.width);
+  json.field("height", grid.height);
+  json.key("cells");
+  writeGridCells(json, grid);
+  json.endObject();
+
+  // Robots
+  json.key("robots");
+  json.beginArray();
+  for (const Robot &robot : robots_)
+    ROBOT_SCHEMA.write(json, robot);
+  json.endArray();
+
+  // Goal
+  json.key("goal");
+  json.beginObject();
+  json.field("x", goal_.x);
+  json.field("y", goal_.y);
+  json.endObject();
+
+  // Estado de pausa y velocidad
+  json.field("paused", paused_);
+  json.field("speed", speed_);
+  json.endObject();
+}
+
+void WorldSnapshot::writeStatsJSON(std::string &out) const {
+  // Calcular eficiencia
+  int totalTasks = stats_.completedTasks + stats_.failedTasks;
+  double efficiency = (totalTasks > 0) ?
+    (static_cast<double>(stats_.completedTasks) / totalTasks * 100.0) : 0.0;
+
+  out.clear();
+  out.reserve(STATS_JSON_SIZE);
+  JsonWriter json(out);
+  json.beginObject();
+  json.field("totalTasks", totalTasks);
+  json.field("completedTasks", stats_.completedTasks);
+  json.field("failedTasks", stats_.failedTasks);
+  json.field("cellsTraveled", stats_.cellsTraveled);
+  json.field("totalDistance", stats_.totalDistance, 2);
+  json.field("robotsActive", stats_.activeRobots);
+  json.field("robotsIdle", stats_.idleRobots);
+  json.field("totalRobots", stats_.totalRobots);
+  json.field("efficiency", efficiency, 1);
+  json.field("uptime", stats_.uptimeSeconds);
+  json.endObject();
+}
+
+void WorldSnapshot::writeFrame(std::string &out, uint64_t sinceEpoch,
+                               uint64_t sinceVersion,
+                               const GridHistory *history) const {
+  const Grid &grid = *grid_;
+
+  // Una versión de otro arranque nombra otro bitmap: enviar el completo
+  if (sinceEpoch != bootEpoch())
+    sinceVersion = 0;
+
+  out.clear();
+  out.reserve(FRAME_HEADER_SIZE + grid.packed.size() +
+              robots_.size() * FRAME_ROBOT_SIZE);
+  out.resize(FRAME_HEADER_SIZE); // La cabecera se completa al final
+
+  // Grid: delta vacío si el cliente ya tiene esta versión; delta desde el
+  // historial si su versión sigue ahí; si no, el bitmap completo
+  GridEncoding encoding = GridEncoding::FULL;
+  if (sinceVersion != 0 && sinceVersion == grid.version) {
+    uint8_t empty[4] = {0, 0, 0, 0};
+    out.append(reinterpret_cast<const char *>(empty), sizeof(empty));
+    encoding = GridEncoding::DELTA;
+  } else if (sinceVersion == 0 || !history ||
+             !history->writeSection(grid.version, sinceVersion, out,
+                                    encoding)) {
+    out += grid.packed;
+    encoding = GridEncoding::FULL;
+  }
+  auto gridBytes = static_cast<uint32_t>(out.size() - FRAME_HEADER_SIZE);
+
+  // Robots: registros de ancho fijo
+  for (const Robot &robot : robots_) {
+    uint8_t flags = (robot.active ? 1 : 0) | (robot.hasPersonalGoal ? 2 : 0);
+    int avoided = std::clamp(robot.obstaclesAvoided, 0, 0xFFFF);
+
+    uint8_t record[FRAME_ROBOT_SIZE];
+    storeU32(record, static_cast<uint32_t>(robot.id));
+    storeU16(record + 4, static_cast<uint16_t>(robot.position.x));
+    storeU16(record + 6, static_cast<uint16_t>(robot.position.y));
+    storeU16(record + 8, static_cast<uint16_t>(robot.goal.x));
+    storeU16(record + 10, static_cast<uint16_t>(robot.goal.y));
+    record[12] = static_cast<uint8_t>(robot.state);
+    record[13] = flags;
+    storeU16(record + 14, static_cast<uint16_t>(avoided));
+    out.append(reinterpret_cast<const char *>(record), FRAME_ROBOT_SIZE);
+  }
+
+  // Cabecera
+  auto *header = reinterpret_cast<uint8_t *>(out.data());
+  storeU32(header, FRAME_MAGIC);
+  storeU16(header + 4, FRAME_FORMAT);
+  header[6] = static_cast<uint8_t>(encoding);
+  header[7] = paused_ ? 1 : 0;
+  storeU64(header + 8, tick_);
+  storeU64(header + 16, grid.version);
+  storeU64(header + 24, encoding == GridEncoding::DELTA ? sinceVersion : 0);
+  storeU16(header + 32, static_cast<uint16_t>(grid.width));
+  storeU16(header + 34, static_cast<uint16_t>(grid.height));
+  storeU16(header + 36, static_cast<uint16_t>(goal_.x));
+  storeU16(header + 38, static_cast<uint16_t>(goal_.y));
+  storeU32(header + 40, static_cast<uint32_t>(speed_));
+  storeU32(header + 44, static_cast<uint32_t>(robots_.size()));
+  storeU32(header + 48, gridBytes);
+  storeU32(header + 52, FRAME_ROBOT_SIZE);
+  storeU64(header + 56, bootEpoch());
+}
+
+} // namespace OSBot
@@ -1,26 +1,22 @@
 #include "domain/Environment.h"
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
-#include <random>
 #include <thread>
 
 namespace OSBot {
 
 Environment::Environment(int width, int height)
-    : width_(width), height_(height), robotPosition_(1, 1), running_(false),
+    : width_(width), height_(height), robotPosition_(1, 1),
+      rng_(Random::stream(RandomStream::ENVIRONMENT)), running_(false),
       currentObstacleCount_(0) {
 
   // Generar posición aleatoria para la meta
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> distX(2, width - 3);
-  std::uniform_int_distribution<> distY(2, height - 3);
-
   // Asegurar que la meta no esté en la posición inicial del robot
   do {
-    goalPosition_.x = distX(gen);
-    goalPosition_.y = distY(gen);
+    goalPosition_.x = rng_.uniformInt(2, width - 3);
+    goalPosition_.y = rng_.uniformInt(2, height - 3);
   } while (goalPosition_.x == robotPosition_.x &&
            goalPosition_.y == robotPosition_.y);
 
@@ -32,10 +28,11 @@ Environment::~Environment() { stop(); }
 
 void Environment::initialize() {
   // SECCIÓN CRÍTICA: Modificación del mapa compartido
-  std::lock_guard<std::mutex> lock(mapMutex_);
+  std::lock_guard<KernelMutex> lock(mapMutex_);
 
   graph_.clear();
   graph_.reserve(width_ * height_);
+  obstacleMask_.assign(static_cast<size_t>(width_) * height_, 0);
 
   // Crear nodos
   for (int y = 0; y < height_; ++y) {
@@ -64,12 +61,12 @@ void Environment::initialize() {
 
   // Colocar bordes (obstáculos)
   for (int x = 0; x < width_; ++x) {
-    getNode(x, 0)->type = CellType::OBSTACLE;
-    getNode(x, height_ - 1)->type = CellType::OBSTACLE;
+    setCellType(getNode(x, 0), CellType::OBSTACLE);
+    setCellType(getNode(x, height_ - 1), CellType::OBSTACLE);
   }
   for (int y = 0; y < height_; ++y) {
-    getNode(0, y)->type = CellType::OBSTACLE;
-    getNode(width_ - 1, y)->type = CellType::OBSTACLE;
+    setCellType(getNode(0, y), CellType::OBSTACLE);
+    setCellType(getNode(width_ - 1, y), CellType::OBSTACLE);
   }
 
   // Colocar obstáculos aleatorios al inicio
@@ -78,12 +75,21 @@ void Environment::initialize() {
   // Colocar objetivo en el grid
   Node *goalNode = getNode(goalPosition_.x, goalPosition_.y);
   if (goalNode)
-    goalNode->type = CellType::GOAL;
+    setCellType(goalNode, CellType::GOAL);
     
   // NOTA: Los robots YA NO se marcan en el grid (multi-robot fix)
   // Las posiciones de robots se manejan en RobotManager
 }
 
+void Environment::setCellType(Node *node, CellType type) {
+  node->type = type;
+  uint8_t obstacle = type == CellType::OBSTACLE ? 1 : 0;
+  if (obstacleMask_[node->id] != obstacle) {
+    obstacleMask_[node->id] = obstacle;
+    mapVersion_++;
+  }
+}
+
 Environment::Node *Environment::getNode(int x, int y) {
   if (x < 0 || x >= width_ || y < 0 || y >= height_) {
     return nullptr;
@@ -92,25 +98,20 @@ Environment::Node *Environment::getNode(int x, int y) {
 }
 
 void Environment::placeObstacles() {
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> distX(2, width_ - 3);
-  std::uniform_int_distribution<> distY(2, height_ - 3);
-
   // Colocar bastantes obstáculos aleatorios para evaluar navegación
   int numObstacles =
       (width_ * height_) / 4; // ~25% del área (sin contar bordes)
 
   for (int i = 0; i < numObstacles; ++i) {
-    int x = distX(gen);
-    int y = distY(gen);
+    int x = rng_.uniformInt(2, width_ - 3);
+    int y = rng_.uniformInt(2, height_ - 3);
 
     // No colocar obstáculos en posición inicial del robot o objetivo
     if ((x != robotPosition_.x || y != robotPosition_.y) &&
         (x != goalPosition_.x || y != goalPosition_.y)) {
       Node *node = getNode(x, y);
       if (node)
-        node->type = CellType::OBSTACLE;
+        setCellType(node, CellType::OBSTACLE);
     }
   }
 }
@@ -120,7 +121,7 @@ void Environment::clearScreen() { (void)std::system("clear"); }
 void Environment::render() {
   // *** SECCIÓN CRÍTICA ***
   // Lock para lectura del mapa compartido durante el renderizado
-  std::lock_guard<std::mutex> lock(mapMutex_);
+  std::lock_guard<KernelMutex> lock(mapMutex_);
 
   clearScreen();
 
@@ -164,7 +165,7 @@ void Environment::render() {
 bool Environment::isPositionFree(const Point &pos) const {
   // *** SECCIÓN CRÍTICA ***
   // Lock para lectura segura del mapa
-  std::lock_guard<std::mutex> lock(mapMutex_);
+  std::lock_guard<KernelMutex> lock(mapMutex_);
 
   // Verificar límites
   if (pos.x < 0 || pos.x >= width_ || pos.y < 0 || pos.y >= height_) {
@@ -193,23 +194,23 @@ void Environment::updateRobotPosition(const Point &pos) {
 }
 
 void Environment::setGoal(const Point &pos) {
-  std::lock_guard<std::mutex> lock(mapMutex_);
+  std::lock_guard<KernelMutex> lock(mapMutex_);
   
   // Limpiar objetivo anterior
   Node *oldNode = getNode(goalPosition_.x, goalPosition_.y);
   if (oldNode && oldNode->type == CellType::GOAL) {
-    oldNode->type = CellType::EMPTY;
+    setCellType(oldNode, CellType::EMPTY);
   }
 
   goalPosition_ = pos;
   Node *newGoalNode = getNode(goalPosition_.x, goalPosition_.y);
   if (newGoalNode) {
-    newGoalNode->type = CellType::GOAL;
+    setCellType(newGoalNode, CellType::GOAL);
   }
 }
 
 Point Environment::getGoal() const {
-  std::lock_guard<std::mutex> lock(mapMutex_);
+  std::lock_guard<KernelMutex> lock(mapMutex_);
   return goalPosition_;
 }
 
@@ -232,7 +233,7 @@ void Environment::stop() {
 std::vector<std::vector<int>> Environment::getGridSnapshot() const {
   // *** SOLUCIÓN DEFINITIVA AL BUG DE RACE CONDITION ***
   // Adquirir mutex UNA VEZ y copiar todo el grid
-  std::lock_guard<std::mutex> lock(mapMutex_);
+  std::lock_guard<KernelMutex> lock(mapMutex_);
   
   std::vector<std::vector<int>> snapshot(height_, std::vector<int>(width_, 0));
   
@@ -249,6 +250,18 @@ std::vector<std::vector<int>> Environment::getGridSnapshot() const {
   return snapshot;
 }
 
+uint64_t Environment::copyObstacleMask(std::vector<uint8_t> &mask) const {
+  std::lock_guard<KernelMutex> lock(mapMutex_);
+
+  mask.assign(obstacleMask_.begin(), obstacleMask_.end());
+  return mapVersion_;
+}
+
+uint64_t Environment::getMapVersion() const {
+  std::lock_guard<KernelMutex> lock(mapMutex_);
+  return mapVersion_;
+}
+
 void Environment::updateLoop() {
   while (running_) {
     std::this_thread::sleep_for(std::chrono::milliseconds(2000));
@@ -261,7 +274,7 @@ void Environment::updateLoop() {
     // Los obstáculos solo se deben agregar/eliminar mediante la interfaz web
     
     /* COMENTADO - Generación automática de obstáculos
-    std::lock_guard<std::mutex> lock(mapMutex_);
+    std::lock_guard<KernelMutex> lock(mapMutex_);
 
     // Contar obstáculos actuales
     currentObstacleCount_ = countObstacles();
@@ -309,7 +322,7 @@ int Environment::countObstacles() const {
 // ========== Implementación de métodos de edición interactiva ==========
 
 bool Environment::toggleObstacle(const Point &pos) {
-  std::lock_guard<std::mutex> lock(mapMutex_);
+  std::lock_guard<KernelMutex> lock(mapMutex_);
   
   // Validar posición
   if (pos.x <= 0 || pos.x >= width_ - 1 || pos.y <= 0 || pos.y >= height_ - 1) {
@@ -327,25 +340,25 @@ bool Environment::toggleObstacle(const Point &pos) {
   
   // Alternar
   if (node->type == CellType::OBSTACLE) {
-    node->type = CellType::EMPTY;
+    setCellType(node, CellType::EMPTY);
     currentObstacleCount_--;
     return false; // Se eliminó
   } else {
-    node->type = CellType::OBSTACLE;
+    setCellType(node, CellType::OBSTACLE);
     currentObstacleCount_++;
     return true; // Se agregó
   }
 }
 
 void Environment::clearAllObstacles() {
-  std::lock_guard<std::mutex> lock(mapMutex_);
+  std::lock_guard<KernelMutex> lock(mapMutex_);
   
   // Limpiar todos los obstáculos excepto bordes
   for (int y = 1; y < height_ - 1; y++) {
     for (int x = 1; x < width_ - 1; x++) {
       Node *node = getNode(x, y);
       if (node && node->type == CellType::OBSTACLE) {
-        node->type = CellType::EMPTY;
+        setCellType(node, CellType::EMPTY);
       }
     }
   }
@@ -353,34 +366,44 @@ void Environment::clearAllObstacles() {
   currentObstacleCount_ = countObstacles();
 }
 
-void Environment::generateRandomObstacles(int percentage) {
-  std::lock_guard<std::mutex> lock(mapMutex_);
+bool Environment::generateRandomObstacles(int percentage) {
+  std::lock_guard<KernelMutex> lock(mapMutex_);
+  
+  // Calcular número de obstáculos basado en porcentaje
+  int innerArea = std::max(0, width_ - 2) * std::max(0, height_ - 2);
+  int targetObstacles = (innerArea * std::clamp(percentage, 0, 100)) / 100;
+  
+  // Celdas que el muestreo puede ocupar: sin ellas el bucle no terminaría
+  int placeable = 0;
+  for (int y = 1; y < height_ - 1; y++) {
+    for (int x = 1; x < width_ - 1; x++) {
+      Node *node = getNode(x, y);
+      Point cell(x, y);
+      if (node && (node->type == CellType::EMPTY || node->type == CellType::OBSTACLE) &&
+          !(cell == robotPosition_) && !(cell == goalPosition_)) {
+        placeable++;
+      }
+    }
+  }
+  if (targetObstacles > placeable) {
+    return false;
+  }
   
   // Primero limpiar obstáculos existentes (excepto bordes)
   for (int y = 1; y < height_ - 1; y++) {
     for (int x = 1; x < width_ - 1; x++) {
       Node *node = getNode(x, y);
       if (node && node->type == CellType::OBSTACLE) {
-        node->type = CellType::EMPTY;
+        setCellType(node, CellType::EMPTY);
       }
     }
   }
   
   // Generar nuevos obstáculos aleatorios
-  std::random_device rd;
-  std::mt19937 gen(rd());
-  std::uniform_int_distribution<> distX(1, width_ - 2);
-  std::uniform_int_distribution<> distY(1, height_ - 2);
-  std::uniform_int_distribution<> distChance(0, 100);
-  
-  // Calcular número de obstáculos basado en porcentaje
-  int innerArea = (width_ - 2) * (height_ - 2);
-  int targetObstacles = (innerArea * percentage) / 100;
-  
   int placed = 0;
   while (placed < targetObstacles) {
-    int x = distX(gen);
-    int y = distY(gen);
+    int x = rng_.uniformInt(1, width_ - 2);
+    int y = rng_.uniformInt(1, height_ - 2);
     
     // No colocar en robot o objetivo
     if ((x == robotPosition_.x && y == robotPosition_.y) ||
@@ -390,12 +413,29 @@ void Environment::generateRandomObstacles(int percentage) {
     
     Node *node = getNode(x, y);
     if (node && node->type == CellType::EMPTY) {
-      node->type = CellType::OBSTACLE;
+      setCellType(node, CellType::OBSTACLE);
       placed++;
     }
   }
   
   currentObstacleCount_ = countObstacles();
+  return true;
+}
+
+Point Environment::randomFreePosition() {
+  std::lock_guard<KernelMutex> lock(mapMutex_);
+
+  for (int attempts = 0; attempts < 100; ++attempts) {
+    int x = rng_.uniformInt(2, width_ - 3);
+    int y = rng_.uniformInt(2, height_ - 3);
+    Node *node = getNode(x, y);
+    if (node && node->type != CellType::OBSTACLE) {
+      return Point(x, y);
+    }
+  }
+
+  // Fallback a posición por defecto
+  return Point(5, 5);
 }
 
 } // namespace OSBot
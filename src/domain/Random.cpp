@@ -0,0 +1,46 @@
+#include "domain/Random.h"
+#include <atomic>
+#include <random>
+
+namespace OSBot {
+namespace Random {
+
+namespace {
+std::atomic<uint64_t> g_masterSeed{0};
+
+uint64_t resolveSeed() {
+  uint64_t seed = g_masterSeed.load(std::memory_order_relaxed);
+  if (seed == 0) {
+    // Sin semilla explícita: elegir una una sola vez para todo el proceso
+    std::random_device rd;
+    uint64_t fresh = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+    if (fresh == 0)
+      fresh = 1;
+    uint64_t expected = 0;
+    if (!g_masterSeed.compare_exchange_strong(expected, fresh)) {
+      fresh = expected; // Otro hilo ganó la carrera
+    }
+    seed = fresh;
+  }
+  return seed;
+}
+} // namespace
+
+void setMasterSeed(uint64_t seed) {
+  g_masterSeed.store(seed, std::memory_order_relaxed);
+}
+
+uint64_t masterSeed() { return resolveSeed(); }
+
+Xoshiro256 stream(RandomStream id, uint64_t instance) {
+  // Derivar una semilla por (componente, instancia) mezclando con splitmix64
+  uint64_t x = resolveSeed();
+  uint64_t seed = Xoshiro256::splitmix64(x);
+  x = seed ^ static_cast<uint64_t>(id);
+  seed = Xoshiro256::splitmix64(x);
+  x = seed ^ instance;
+  return Xoshiro256(Xoshiro256::splitmix64(x));
+}
+
+} // namespace Random
+} // namespace OSBot
@@ -1,6 +1,7 @@
 #include "domain/Robot.h"
 #include "application/AStar.h"
 #include "infrastructure/LIDARSensor.h"
+#include "infrastructure/Tracer.h"
 #include <algorithm>
 #include <chrono>
 #include <iostream>
@@ -9,10 +10,13 @@
 
 namespace OSBot {
 
+std::atomic<bool> Robot::loggingEnabled_{true};
+
 Robot::Robot(Environment &env)
     : environment_(env), currentPosition_(1, 1), currentState_(State::IDLE),
-      running_(false), pathIndex_(0), obstaclesAvoided_(0), cellsTraveled_(0),
-      id_(0), batteryLevel_(100.0f) {}
+      personalGoal_(1, 1), hasPersonalGoal_(false), running_(false), id_(0),
+      batteryLevel_(100.0f), pathIndex_(0), obstaclesAvoided_(0),
+      cellsTraveled_(0) {}
 
 // ... existing code ...
 
@@ -54,7 +58,8 @@ void Robot::start() {
   // Crear y lanzar el hilo del robot
   robotThread_ = std::make_unique<std::thread>(&Robot::run, this);
 
-  std::cout << "[Robot] Hilo iniciado\n";
+  if (loggingEnabled_)
+    std::cout << "[Robot] Hilo iniciado\n";
 }
 
 void Robot::stop() {
@@ -70,42 +75,29 @@ void Robot::stop() {
     robotThread_->join();
   }
 
-  std::cout << "[Robot] Hilo detenido\n";
+  if (loggingEnabled_)
+    std::cout << "[Robot] Hilo detenido\n";
 }
 
 State Robot::getState() const { return currentState_; }
 
 Point Robot::getPosition() const { return currentPosition_; }
 
+void Robot::startStepped() {
+  currentState_ = State::NAVIGATING;
+  lastGoal_ = getGoal();
+}
+
 void Robot::run() {
-  std::cout << "[Robot] Bucle principal iniciado\n";
-  
-  Point lastGoal = getGoal(); // Guardar objetivo inicial
+  if (loggingEnabled_)
+    std::cout << "[Robot] Bucle principal iniciado\n";
+
+  lastGoal_ = getGoal(); // Guardar objetivo inicial
 
   while (running_.load()) {
-    Point currentGoal = getGoal();
-    
-    // Detectar si el objetivo cambió
-    if (currentState_ == State::REACHED_GOAL && currentGoal != lastGoal) {
-      std::cout << "[Robot] 🎯 Nuevo objetivo detectado! Reiniciando navegación...\n";
-      currentState_ = State::NAVIGATING;
-      plannedPath_.clear();
-      pathIndex_ = 0;
-      lastGoal = currentGoal;
-    }
-    
-    // Forzar actualización si el objetivo cambia mientras se navega
-    if (currentState_ == State::NAVIGATING && currentGoal != lastGoal) {
-         lastGoal = currentGoal;
-         // Opcional: Recalcular ruta inmediatamente si el objetivo cambia drásticamente
-         plannedPath_.clear(); 
-         pathIndex_ = 0;
-    }
-    
-    if (currentState_ == State::NAVIGATING) {
-      navigate();
-      lastGoal = currentGoal; // Actualizar objetivo conocido
-    } else if (currentState_ == State::REACHED_GOAL) {
+    step();
+
+    if (currentState_ == State::REACHED_GOAL) {
       // Robot en espera, esperando nuevo objetivo
       std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
@@ -115,10 +107,39 @@ void Robot::run() {
         std::chrono::milliseconds(Constants::SIMULATION_SPEED_MS));
   }
 
-  std::cout << "[Robot] Bucle principal finalizado\n";
+  if (loggingEnabled_)
+    std::cout << "[Robot] Bucle principal finalizado\n";
+}
+
+void Robot::step() {
+  Point currentGoal = getGoal();
+
+  // Detectar si el objetivo cambió
+  if (currentState_ == State::REACHED_GOAL && currentGoal != lastGoal_) {
+    if (loggingEnabled_)
+      std::cout << "[Robot] 🎯 Nuevo objetivo detectado! Reiniciando navegación...\n";
+    currentState_ = State::NAVIGATING;
+    plannedPath_.clear();
+    pathIndex_ = 0;
+    lastGoal_ = currentGoal;
+  }
+
+  // Forzar actualización si el objetivo cambia mientras se navega
+  if (currentState_ == State::NAVIGATING && currentGoal != lastGoal_) {
+    lastGoal_ = currentGoal;
+    // Opcional: Recalcular ruta inmediatamente si el objetivo cambia drásticamente
+    plannedPath_.clear();
+    pathIndex_ = 0;
+  }
+
+  if (currentState_ == State::NAVIGATING) {
+    navigate();
+    lastGoal_ = currentGoal; // Actualizar objetivo conocido
+  }
 }
 
 void Robot::navigate() {
+  TraceSpan span("Robot::navigate", "robot");
   Point goal = getGoal();
 
   // Verificar si ya alcanzó el objetivo
@@ -133,7 +154,8 @@ void Robot::navigate() {
 
   // 2. Detectar stuck
   if (isStuck()) {
-    std::cout << "🔴 STUCK detectado! Recalculando ruta...\n";
+    if (loggingEnabled_)
+      std::cout << "🔴 STUCK detectado! Recalculando ruta...\n";
     recalculatePath();
   }
 
@@ -185,8 +207,10 @@ void Robot::navigateGreedy() {
   }
 
   if (validMoves.empty()) {
-    std::cout << "🚫 Robot bloqueado! No hay movimientos válidos\n";
-    std::cout << "🔄 Recalculando ruta con A*...\n";
+    if (loggingEnabled_) {
+      std::cout << "🚫 Robot bloqueado! No hay movimientos válidos\n";
+      std::cout << "🔄 Recalculando ruta con A*...\n";
+    }
     recalculatePath();
     return;
   }
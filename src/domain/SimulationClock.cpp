@@ -0,0 +1,28 @@
+#include "domain/SimulationClock.h"
+
+namespace OSBot {
+
+std::atomic<bool> SimulationClock::virtual_{false};
+std::atomic<int64_t> SimulationClock::virtualMs_{0};
+
+SimulationClock::TimePoint SimulationClock::now() {
+  if (!virtual_.load(std::memory_order_relaxed)) {
+    return std::chrono::system_clock::now();
+  }
+  // Época virtual: time_point{} + milisegundos simulados
+  return TimePoint{} + std::chrono::milliseconds(
+                           virtualMs_.load(std::memory_order_relaxed));
+}
+
+void SimulationClock::useVirtualTime(bool enabled) {
+  virtualMs_.store(0, std::memory_order_relaxed);
+  virtual_.store(enabled, std::memory_order_relaxed);
+}
+
+void SimulationClock::advance(std::chrono::milliseconds step) {
+  if (virtual_.load(std::memory_order_relaxed)) {
+    virtualMs_.fetch_add(step.count(), std::memory_order_relaxed);
+  }
+}
+
+} // namespace OSBot
@@ -1,4 +1,5 @@
 #include "domain/Task.h"
+#include "domain/SimulationClock.h"
 #include <algorithm>
 
 namespace OSBot {
@@ -10,8 +11,11 @@ Task::Task(int id, const std::vector<Point>& waypoints, TaskPriority priority)
     , priority_(priority)
     , status_(TaskStatus::PENDING)
     , assignedRobotId_(-1)
-    , createdTime_(std::chrono::system_clock::now())
+    , createdTime_(SimulationClock::now())
     , estimatedDuration_(0.0)
+    , estimatedRouteCells_(-1)
+    , routeStartCells_(-1)
+    , stats_(nullptr)
 {
 }
 
@@ -23,15 +27,40 @@ Point Task::getCurrentWaypoint() const {
 }
 
 void Task::setStatus(TaskStatus status) {
+    TaskStatus previous = status_;
     status_ = status;
     
     if (status == TaskStatus::IN_PROGRESS && 
         startTime_ == std::chrono::system_clock::time_point{}) {
-        startTime_ = std::chrono::system_clock::now();
+        startTime_ = SimulationClock::now();
     }
     
     if (status == TaskStatus::COMPLETED || status == TaskStatus::FAILED || status == TaskStatus::CANCELLED) {
-        completionTime_ = std::chrono::system_clock::now();
+        completionTime_ = SimulationClock::now();
+    }
+    
+    if (stats_ && previous != status) {
+        stats_->onTransition(*this, previous, status);
+    }
+}
+
+void Task::attachStats(TaskStats* stats) {
+    if (stats_) {
+        stats_->byStatus[static_cast<size_t>(status_)]--;
+    }
+    stats_ = stats;
+    if (stats_) {
+        stats_->byStatus[static_cast<size_t>(status_)]++;
+    }
+}
+
+void TaskStats::onTransition(const Task& task, TaskStatus from, TaskStatus to) {
+    byStatus[static_cast<size_t>(from)]--;
+    byStatus[static_cast<size_t>(to)]++;
+    if (to == TaskStatus::COMPLETED) {
+        // Segundos enteros, como los informaba el recorrido completo
+        completedSeconds += std::chrono::duration_cast<std::chrono::seconds>(
+            task.getCompletionTime() - task.getStartTime()).count();
     }
 }
 
@@ -1,12 +1,14 @@
 #include "infrastructure/GPSSensor.h"
 #include <cmath>
-#include <random>
 
 namespace OSBot {
 
-GPSSensor::GPSSensor(double base_lat, double base_lon, double scale_factor)
+GPSSensor::GPSSensor(double base_lat, double base_lon, double scale_factor,
+                     int sensor_id)
     : base_latitude_(base_lat), base_longitude_(base_lon),
-      scale_factor_(scale_factor), add_noise_(true) {}
+      scale_factor_(scale_factor), add_noise_(true),
+      rng_(Random::stream(RandomStream::GPS,
+                          static_cast<uint64_t>(sensor_id))) {}
 
 GPSData GPSSensor::get_data(const Point &position) {
   GPSData data;
@@ -21,14 +23,12 @@ GPSData GPSSensor::get_data(const Point &position) {
 
   // Simular ruido gaussiano (precisión típica de GPS: 5-10 metros)
   if (add_noise_) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::normal_distribution<> noise(0.0, 0.00005); // ~5 metros de desviación
-
-    data.latitude += noise(gen);
-    data.longitude += noise(gen);
-    data.accuracy =
-        std::abs(noise(gen)) * 111000.0; // Convertir a metros aproximados
+    const double sigma = 0.00005; // ~5 metros de desviación
+
+    data.latitude += rng_.normal(0.0, sigma);
+    data.longitude += rng_.normal(0.0, sigma);
+    data.accuracy = std::abs(rng_.normal(0.0, sigma)) *
+                    111000.0; // Convertir a metros aproximados
   } else {
     data.accuracy = 0.0; // GPS perfecto
   }
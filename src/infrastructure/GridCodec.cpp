@@ -0,0 +1,169 @@
+#include "infrastructure/GridCodec.h"
+#include <algorithm>
+
+namespace OSBot {
+
+namespace {
+// Hasta 8 bytes de 'data' desde 'offset' como palabra little-endian
+uint64_t loadWord(const std::string &data, size_t offset, size_t size) {
+  auto *p = reinterpret_cast<const uint8_t *>(data.data() + offset);
+  if (offset + 8 <= size)
+    return loadU64(p);
+  uint64_t word = 0;
+  for (size_t i = 0; offset + i < size; ++i)
+    word |= static_cast<uint64_t>(p[i]) << (8 * i);
+  return word;
+}
+} // namespace
+
+// ============================================================================
+// GridCodec
+// ============================================================================
+
+size_t GridCodec::packedSize(int width, int height) {
+  if (width <= 0 || height <= 0)
+    return 0;
+  return (static_cast<size_t>(width) * height + 7) / 8;
+}
+
+void GridCodec::pack(const std::vector<uint8_t> &mask, int width, int height,
+                     std::string &out) {
+  size_t cells = static_cast<size_t>(width > 0 ? width : 0) *
+                 static_cast<size_t>(height > 0 ? height : 0);
+  size_t offset = out.size();
+  out.resize(offset + packedSize(width, height));
+  if (mask.size() < cells)
+    return; // Máscara incompleta (entorno sin inicializar): grid vacío
+  auto *dst = reinterpret_cast<uint8_t *>(out.data() + offset);
+
+  // 8 celdas por byte; el bucle interno no tiene saltos
+  size_t full = cells / 8;
+  const uint8_t *src = mask.data();
+  for (size_t i = 0; i < full; ++i, src += 8) {
+    uint8_t byte = 0;
+    for (int bit = 0; bit < 8; ++bit)
+      byte |= static_cast<uint8_t>((src[bit] & 1) << bit);
+    dst[i] = byte;
+  }
+  if (cells % 8) {
+    uint8_t byte = 0;
+    for (size_t bit = 0; bit < cells % 8; ++bit)
+      byte |= static_cast<uint8_t>((src[bit] & 1) << bit);
+    dst[full] = byte;
+  }
+}
+
+bool GridCodec::unpack(const uint8_t *data, size_t size, int width, int height,
+                       std::vector<uint8_t> &mask) {
+  if (width <= 0 || height <= 0 || size != packedSize(width, height))
+    return false;
+
+  size_t cells = static_cast<size_t>(width) * height;
+  mask.resize(cells);
+  for (size_t i = 0; i < cells; ++i)
+    mask[i] = (data[i / 8] >> (i % 8)) & 1;
+  return true;
+}
+
+uint32_t GridCodec::appendDelta(const std::string &basePacked,
+                                const std::string &packed, std::string &out) {
+  size_t countOffset = out.size();
+  out.resize(countOffset + 4);
+
+  uint32_t count = 0;
+  size_t bytes = std::min(basePacked.size(), packed.size());
+  for (size_t i = 0; i < bytes; i += 8) {
+    // Palabras de 64 bits (little-endian): la mayoría son iguales
+    uint64_t diff = loadWord(basePacked, i, bytes) ^ loadWord(packed, i, bytes);
+    while (diff) {
+      int bit = __builtin_ctzll(diff);
+      diff &= diff - 1;
+      uint8_t index[4];
+      storeU32(index, static_cast<uint32_t>(i * 8 + bit));
+      out.append(reinterpret_cast<const char *>(index), 4);
+      count++;
+    }
+  }
+
+  storeU32(reinterpret_cast<uint8_t *>(out.data() + countOffset), count);
+  return count;
+}
+
+size_t GridCodec::applyDelta(const uint8_t *data, size_t size,
+                             std::vector<uint8_t> &mask) {
+  if (size < 4)
+    return 0;
+  uint32_t count = loadU32(data);
+  size_t needed = 4 + static_cast<size_t>(count) * 4;
+  if (size < needed)
+    return 0;
+
+  for (uint32_t i = 0; i < count; ++i) {
+    uint32_t cell = loadU32(data + 4 + 4 * static_cast<size_t>(i));
+    if (cell >= mask.size())
+      return 0;
+    mask[cell] ^= 1;
+  }
+  return needed;
+}
+
+// ============================================================================
+// GridHistory
+// ============================================================================
+
+const GridHistory::Entry *GridHistory::find(uint64_t version) const {
+  for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+    if (it->version == version)
+      return &*it;
+  }
+  return nullptr;
+}
+
+void GridHistory::record(uint64_t version, std::string packed) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (find(version))
+    return;
+
+  entries_.push_back({version, std::move(packed)});
+  while (entries_.size() > capacity_)
+    entries_.pop_front();
+}
+
+bool GridHistory::writeSection(uint64_t version, uint64_t baseVersion,
+                               std::string &out,
+                               GridEncoding &encoding) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const Entry *current = find(version);
+  if (!current)
+    return false;
+
+  // El cliente ya tiene esta versión: delta vacío sin comparar nada
+  if (baseVersion == version) {
+    uint8_t empty[4] = {0, 0, 0, 0};
+    out.append(reinterpret_cast<const char *>(empty), sizeof(empty));
+    encoding = GridEncoding::DELTA;
+    return true;
+  }
+
+  const Entry *base = find(baseVersion);
+  if (base && base->packed.size() == current->packed.size()) {
+    // Contar primero: el delta solo se escribe si ocupa menos que el bitmap
+    size_t size = current->packed.size();
+    size_t changed = 0;
+    for (size_t i = 0; i < size; i += 8) {
+      changed += __builtin_popcountll(loadWord(base->packed, i, size) ^
+                                      loadWord(current->packed, i, size));
+    }
+    if (4 + 4 * changed < size) {
+      GridCodec::appendDelta(base->packed, current->packed, out);
+      encoding = GridEncoding::DELTA;
+      return true;
+    }
+  }
+
+  out += current->packed;
+  encoding = GridEncoding::FULL;
+  return true;
+}
+
+} // namespace OSBot
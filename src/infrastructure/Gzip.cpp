@@ -0,0 +1,87 @@
+#include "infrastructure/Gzip.h"
+#include <algorithm>
+#include <cctype>
+
+#ifdef OSBOT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace OSBot {
+
+bool Gzip::isAvailable() {
+#ifdef OSBOT_HAVE_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool Gzip::compress(std::string_view input, std::string &out, int level) {
+#ifdef OSBOT_HAVE_ZLIB
+  z_stream stream{};
+  // windowBits 15 + 16: cabecera y CRC gzip en lugar de zlib
+  if (deflateInit2(&stream, std::clamp(level, 1, 9), Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+    return false;
+
+  // deflateBound garantiza que una sola llamada con Z_FINISH basta
+  out.resize(deflateBound(&stream, static_cast<uLong>(input.size())));
+  stream.next_in =
+      reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+  stream.avail_in = static_cast<uInt>(input.size());
+  stream.next_out = reinterpret_cast<Bytef *>(out.data());
+  stream.avail_out = static_cast<uInt>(out.size());
+
+  int result = deflate(&stream, Z_FINISH);
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+  return result == Z_STREAM_END;
+#else
+  (void)input;
+  (void)out;
+  (void)level;
+  return false;
+#endif
+}
+
+bool Gzip::isAccepted(std::string_view acceptEncoding) {
+  // Lista separada por comas: "gzip, deflate, br" o "gzip;q=0.5, *;q=0"
+  while (!acceptEncoding.empty()) {
+    size_t comma = acceptEncoding.find(',');
+    std::string_view token = acceptEncoding.substr(0, comma);
+    acceptEncoding = comma == std::string_view::npos
+                         ? std::string_view()
+                         : acceptEncoding.substr(comma + 1);
+
+    std::string_view params;
+    size_t semicolon = token.find(';');
+    if (semicolon != std::string_view::npos) {
+      params = token.substr(semicolon + 1);
+      token = token.substr(0, semicolon);
+    }
+    while (!token.empty() && token.front() == ' ')
+      token.remove_prefix(1);
+    while (!token.empty() && token.back() == ' ')
+      token.remove_suffix(1);
+
+    bool isGzip = token.size() == 4 &&
+                  std::equal(token.begin(), token.end(), "gzip",
+                             [](char a, char b) {
+                               return std::tolower(static_cast<unsigned char>(
+                                          a)) == b;
+                             });
+    if (!isGzip)
+      continue;
+
+    // q=0 (o 0.0, 0.00...) rechaza explícitamente la codificación
+    size_t q = params.find("q=");
+    if (q == std::string_view::npos)
+      return true;
+    std::string_view value = params.substr(q + 2);
+    value = value.substr(0, value.find(';'));
+    return value.find_first_not_of("0. ") != std::string_view::npos;
+  }
+  return false;
+}
+
+} // namespace OSBot
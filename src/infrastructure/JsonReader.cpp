@@ -0,0 +1,228 @@
+#include "infrastructure/JsonReader.h"
+#include <charconv>
+
+namespace OSBot {
+
+namespace {
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+bool isHexDigit(char c) {
+  return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+} // namespace
+
+void JsonReader::skipWhitespace() {
+  while (pos_ < input_.size()) {
+    char c = input_[pos_];
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+      break;
+    pos_++;
+  }
+}
+
+bool JsonReader::fail(const char *message) {
+  // Se conserva el primer error: es el que apunta a la causa real
+  if (!error_) {
+    error_ = message;
+    errorOffset_ = pos_;
+  }
+  return false;
+}
+
+char JsonReader::peek() {
+  if (failed())
+    return '\0';
+  skipWhitespace();
+  return pos_ < input_.size() ? input_[pos_] : '\0';
+}
+
+bool JsonReader::consume(char expected, const char *message) {
+  if (failed())
+    return false;
+  skipWhitespace();
+  if (pos_ >= input_.size() || input_[pos_] != expected)
+    return fail(message);
+  pos_++;
+  return true;
+}
+
+bool JsonReader::consumeLiteral(std::string_view literal) {
+  if (input_.substr(pos_, literal.size()) != literal)
+    return fail("literal inválido");
+  pos_ += literal.size();
+  return true;
+}
+
+bool JsonReader::enter() {
+  if (++depth_ > MAX_DEPTH)
+    return fail("anidamiento demasiado profundo");
+  return true;
+}
+
+bool JsonReader::finish() {
+  if (failed())
+    return false;
+  skipWhitespace();
+  if (pos_ != input_.size())
+    return fail("datos sobrantes tras el valor");
+  return true;
+}
+
+bool JsonReader::scanNumber(std::string_view &number) {
+  if (failed())
+    return false;
+  skipWhitespace();
+
+  // Gramática JSON: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+  size_t start = pos_;
+  size_t end = input_.size();
+  size_t p = pos_;
+
+  if (p < end && input_[p] == '-')
+    p++;
+  if (p >= end || !isDigit(input_[p]))
+    return fail("se esperaba un número");
+  if (input_[p] == '0') {
+    p++;
+  } else {
+    while (p < end && isDigit(input_[p]))
+      p++;
+  }
+  if (p < end && input_[p] == '.') {
+    p++;
+    if (p >= end || !isDigit(input_[p])) {
+      pos_ = p;
+      return fail("fracción sin dígitos");
+    }
+    while (p < end && isDigit(input_[p]))
+      p++;
+  }
+  if (p < end && (input_[p] == 'e' || input_[p] == 'E')) {
+    p++;
+    if (p < end && (input_[p] == '+' || input_[p] == '-'))
+      p++;
+    if (p >= end || !isDigit(input_[p])) {
+      pos_ = p;
+      return fail("exponente sin dígitos");
+    }
+    while (p < end && isDigit(input_[p]))
+      p++;
+  }
+
+  number = input_.substr(start, p - start);
+  pos_ = p;
+  return true;
+}
+
+bool JsonReader::readInt(int &value) {
+  std::string_view number;
+  size_t start = pos_;
+  if (!scanNumber(number))
+    return false;
+
+  int parsed = 0;
+  auto [ptr, ec] =
+      std::from_chars(number.data(), number.data() + number.size(), parsed);
+  if (ec == std::errc::result_out_of_range) {
+    pos_ = start;
+    return fail("entero fuera de rango");
+  }
+  if (ec != std::errc() || ptr != number.data() + number.size()) {
+    pos_ = start;
+    return fail("se esperaba un entero");
+  }
+  value = parsed;
+  return true;
+}
+
+bool JsonReader::readDouble(double &value) {
+  std::string_view number;
+  size_t start = pos_;
+  if (!scanNumber(number))
+    return false;
+
+  double parsed = 0.0;
+  auto [ptr, ec] =
+      std::from_chars(number.data(), number.data() + number.size(), parsed);
+  if (ec != std::errc() || ptr != number.data() + number.size()) {
+    pos_ = start;
+    return fail("número fuera de rango");
+  }
+  value = parsed;
+  return true;
+}
+
+bool JsonReader::readBool(bool &value) {
+  char c = peek();
+  if (c == 't' && consumeLiteral("true")) {
+    value = true;
+    return true;
+  }
+  if (c == 'f' && consumeLiteral("false")) {
+    value = false;
+    return true;
+  }
+  return fail("se esperaba un booleano");
+}
+
+bool JsonReader::readString(std::string_view &value) {
+  if (!consume('"', "se esperaba una cadena"))
+    return false;
+
+  size_t start = pos_;
+  while (pos_ < input_.size()) {
+    char c = input_[pos_];
+    if (c == '"') {
+      value = input_.substr(start, pos_ - start);
+      pos_++;
+      return true;
+    }
+    if (static_cast<unsigned char>(c) < 0x20)
+      return fail("carácter de control en cadena");
+    if (c == '\\') {
+      pos_++;
+      if (pos_ >= input_.size())
+        break;
+      char escaped = input_[pos_];
+      if (escaped == 'u') {
+        for (int i = 1; i <= 4; ++i) {
+          if (pos_ + i >= input_.size() || !isHexDigit(input_[pos_ + i]))
+            return fail("escape unicode inválido");
+        }
+        pos_ += 4;
+      } else if (std::string_view("\"\\/bfnrt").find(escaped) ==
+                 std::string_view::npos) {
+        return fail("escape inválido");
+      }
+    }
+    pos_++;
+  }
+  return fail("cadena sin cerrar");
+}
+
+bool JsonReader::skipValue() {
+  switch (peek()) {
+  case '{':
+    return readObject([this](std::string_view) { return skipValue(); });
+  case '[':
+    return readArray([this](size_t) { return skipValue(); });
+  case '"': {
+    std::string_view ignored;
+    return readString(ignored);
+  }
+  case 't':
+  case 'f': {
+    bool ignored;
+    return readBool(ignored);
+  }
+  case 'n':
+    return consumeLiteral("null");
+  case '\0':
+    return fail("fin de entrada inesperado");
+  default: {
+    std::string_view ignored;
+    return scanNumber(ignored);
+  }
+  }
+}
+
+} // namespace OSBot
@@ -0,0 +1,213 @@
+#include "infrastructure/Metrics.h"
+#include <iomanip>
+#include <sstream>
+
+namespace OSBot {
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+LatencyHistogram::LatencyHistogram(HistogramUnit unit) : unit_(unit) {
+  reset();
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+  if (value < SUB_BUCKETS) {
+    return static_cast<size_t>(value);
+  }
+
+  // Magnitud = posición del bit más significativo
+  int magnitude = 63 - __builtin_clzll(value);
+  if (magnitude > MAX_MAGNITUDE) {
+    return BUCKET_COUNT - 1; // Saturar en el último bucket
+  }
+
+  int shift = magnitude - SUB_BUCKET_BITS;
+  size_t group = static_cast<size_t>(shift + 1);
+  size_t sub = static_cast<size_t>((value >> shift) - SUB_BUCKETS);
+  return group * SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+  size_t group = index / SUB_BUCKETS;
+  uint64_t sub = index % SUB_BUCKETS;
+  if (group == 0) {
+    return sub;
+  }
+  int shift = static_cast<int>(group) - 1;
+  return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+  buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  uint64_t currentMax = max_.load(std::memory_order_relaxed);
+  while (value > currentMax &&
+         !max_.compare_exchange_weak(currentMax, value,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+  uint64_t total = count();
+  if (total == 0) {
+    return 0;
+  }
+
+  uint64_t target = static_cast<uint64_t>(p / 100.0 * total + 0.5);
+  if (target == 0)
+    target = 1;
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= target) {
+      // El bucket puede exceder el máximo real: acotar
+      uint64_t bound = bucketUpperBound(i);
+      uint64_t maxValue = max_.load(std::memory_order_relaxed);
+      return bound < maxValue ? bound : maxValue;
+    }
+  }
+  return max_.load(std::memory_order_relaxed);
+}
+
+HistogramSummary LatencyHistogram::summary() const {
+  HistogramSummary s;
+  s.count = count();
+  s.p50 = percentile(50.0);
+  s.p99 = percentile(99.0);
+  s.max = max_.load(std::memory_order_relaxed);
+  s.mean = s.count > 0 ? static_cast<double>(sum_.load()) / s.count : 0.0;
+  return s;
+}
+
+void LatencyHistogram::reset() {
+  for (auto &bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// Metrics
+// ============================================================================
+
+std::atomic<bool> Metrics::enabled_{true};
+
+Metrics &Metrics::instance() {
+  static Metrics metrics;
+  return metrics;
+}
+
+LatencyHistogram &Metrics::histogram(const std::string &name,
+                                     HistogramUnit unit) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto &slot = histograms_[name];
+  if (!slot) {
+    slot = std::make_unique<LatencyHistogram>(unit);
+  }
+  return *slot;
+}
+
+std::atomic<uint64_t> &Metrics::counter(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto &slot = counters_[name];
+  if (!slot) {
+    slot = std::make_unique<std::atomic<uint64_t>>(0);
+  }
+  return *slot;
+}
+
+std::string Metrics::toJSON() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::ostringstream json;
+  json << "{\"enabled\":" << (isEnabled() ? "true" : "false") << ",";
+  json << "\"histograms\":{";
+
+  bool first = true;
+  for (const auto &[name, histogram] : histograms_) {
+    HistogramSummary s = histogram->summary();
+    if (!first)
+      json << ",";
+    first = false;
+
+    const char *unit =
+        histogram->unit() == HistogramUnit::MILLISECONDS ? "ms" : "ns";
+    json << "\"" << name << "\":{";
+    json << "\"count\":" << s.count << ",";
+    json << "\"p50_" << unit << "\":" << s.p50 << ",";
+    json << "\"p99_" << unit << "\":" << s.p99 << ",";
+    json << "\"max_" << unit << "\":" << s.max << ",";
+    json << "\"mean_" << unit << "\":" << static_cast<uint64_t>(s.mean);
+    json << "}";
+  }
+
+  json << "},\"counters\":{";
+  first = true;
+  for (const auto &[name, value] : counters_) {
+    if (!first)
+      json << ",";
+    first = false;
+    json << "\"" << name << "\":" << value->load(std::memory_order_relaxed);
+  }
+
+  json << "}}";
+  return json.str();
+}
+
+void Metrics::printReport(std::ostream &os) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Una tabla por unidad: los de ns se muestran en us, los de ms tal cual
+  auto printTable = [&](HistogramUnit unit, const char *label, double scale) {
+    bool header = false;
+    for (const auto &[name, histogram] : histograms_) {
+      HistogramSummary s = histogram->summary();
+      if (histogram->unit() != unit || s.count == 0)
+        continue;
+      if (!header) {
+        const std::string suffix = std::string("(") + label + ")";
+        os << "[Metrics] " << std::left << std::setw(44) << "Histograma"
+           << std::right << std::setw(10) << "count" << std::setw(12)
+           << "p50" + suffix << std::setw(12) << "p99" + suffix
+           << std::setw(12) << "max" + suffix << "\n";
+        header = true;
+      }
+      os << "[Metrics] " << std::left << std::setw(44) << name << std::right
+         << std::setw(10) << s.count << std::fixed << std::setprecision(1)
+         << std::setw(12) << s.p50 / scale << std::setw(12) << s.p99 / scale
+         << std::setw(12) << s.max / scale << std::defaultfloat << "\n";
+    }
+  };
+  printTable(HistogramUnit::NANOSECONDS, "us", 1000.0);
+  printTable(HistogramUnit::MILLISECONDS, "ms", 1.0);
+
+  for (const auto &[name, value] : counters_) {
+    uint64_t v = value->load(std::memory_order_relaxed);
+    if (v == 0)
+      continue;
+    os << "[Metrics] " << std::left << std::setw(44) << name << std::right
+       << std::setw(10) << v << "\n";
+  }
+  os.flush();
+}
+
+void Metrics::resetAll() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &[name, histogram] : histograms_) {
+    histogram->reset();
+  }
+  for (auto &[name, value] : counters_) {
+    value->store(0, std::memory_order_relaxed);
+  }
+}
+
+} // namespace OSBot
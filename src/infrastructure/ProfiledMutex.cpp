@@ -0,0 +1,68 @@
+#include "infrastructure/ProfiledMutex.h"
+#include <string>
+
+namespace OSBot {
+
+namespace {
+uint64_t elapsedNs(std::chrono::steady_clock::time_point since,
+                   std::chrono::steady_clock::time_point until) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(until - since)
+          .count());
+}
+} // namespace
+
+ProfiledMutex::ProfiledMutex(const char *site)
+    : acquisitions_(Metrics::instance().counter(std::string("lock.") + site +
+                                                ".acquisitions")),
+      contended_(Metrics::instance().counter(std::string("lock.") + site +
+                                             ".contended")),
+      wait_(Metrics::instance().histogram(std::string("lock.") + site +
+                                          ".wait")),
+      hold_(Metrics::instance().histogram(std::string("lock.") + site +
+                                          ".hold")) {}
+
+void ProfiledMutex::lock() {
+  acquisitions_.fetch_add(1, std::memory_order_relaxed);
+
+  // Camino rápido: sin contención no se mide espera
+  if (mutex_.try_lock()) {
+    markAcquired();
+    return;
+  }
+
+  contended_.fetch_add(1, std::memory_order_relaxed);
+  if (!Metrics::isEnabled()) {
+    mutex_.lock();
+    acquiredAt_ = {};
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  mutex_.lock();
+  acquiredAt_ = std::chrono::steady_clock::now();
+  wait_.record(elapsedNs(start, acquiredAt_));
+}
+
+bool ProfiledMutex::try_lock() {
+  if (!mutex_.try_lock()) {
+    return false;
+  }
+  acquisitions_.fetch_add(1, std::memory_order_relaxed);
+  markAcquired();
+  return true;
+}
+
+void ProfiledMutex::unlock() {
+  if (acquiredAt_ != std::chrono::steady_clock::time_point{}) {
+    hold_.record(elapsedNs(acquiredAt_, std::chrono::steady_clock::now()));
+  }
+  mutex_.unlock();
+}
+
+void ProfiledMutex::markAcquired() {
+  acquiredAt_ = Metrics::isEnabled() ? std::chrono::steady_clock::now()
+                                     : std::chrono::steady_clock::time_point{};
+}
+
+} // namespace OSBot
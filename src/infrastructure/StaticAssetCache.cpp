@@ -0,0 +1,135 @@
+#include "infrastructure/StaticAssetCache.h"
+#include "infrastructure/Gzip.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace OSBot {
+
+std::atomic<bool> StaticAssetCache::reloadRequested_{false};
+
+namespace {
+
+struct ContentType {
+  std::string_view extension;
+  std::string_view type;
+  bool compressible;
+};
+
+constexpr ContentType CONTENT_TYPES[] = {
+    {".html", "text/html; charset=utf-8", true},
+    {".css", "text/css; charset=utf-8", true},
+    {".js", "application/javascript; charset=utf-8", true},
+    {".json", "application/json", true},
+    {".svg", "image/svg+xml", true},
+    {".txt", "text/plain; charset=utf-8", true},
+    {".png", "image/png", false},
+    {".ico", "image/x-icon", false},
+    {".woff2", "font/woff2", false},
+};
+
+const ContentType *findContentType(std::string_view filename) {
+  size_t dot = filename.rfind('.');
+  if (dot == std::string_view::npos)
+    return nullptr;
+  std::string_view extension = filename.substr(dot);
+  for (const ContentType &entry : CONTENT_TYPES) {
+    if (entry.extension == extension)
+      return &entry;
+  }
+  return nullptr;
+}
+
+std::string quotedHash(std::string_view data, std::string_view suffix) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : data) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ULL;
+  }
+  std::string etag(18, '"');
+  for (int i = 0; i < 16; ++i)
+    etag[16 - i] = "0123456789abcdef"[(hash >> (4 * i)) & 0xF];
+  etag.insert(17, suffix);
+  return etag;
+}
+
+} // namespace
+
+bool StaticAssetCache::load() {
+  namespace fs = std::filesystem;
+
+  std::error_code error;
+  fs::directory_iterator it(root_, error);
+  if (error) {
+    std::cerr << "[StaticAssetCache] No se puede abrir " << root_ << ": "
+              << error.message() << std::endl;
+    return false;
+  }
+
+  auto assets = std::make_shared<AssetMap>();
+  size_t bytes = 0;
+  size_t gzipBytes = 0;
+  for (const fs::directory_entry &entry : it) {
+    if (!entry.is_regular_file(error))
+      continue;
+
+    std::ifstream file(entry.path(), std::ios::binary);
+    if (!file.is_open()) {
+      std::cerr << "[StaticAssetCache] No se puede leer " << entry.path()
+                << std::endl;
+      continue;
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+
+    std::string name = entry.path().filename().string();
+    const ContentType *type = findContentType(name);
+
+    auto asset = std::make_shared<StaticAsset>();
+    asset->contentType = std::string(contentTypeFor(name));
+    asset->body = content.str();
+    asset->etag = quotedHash(asset->body, "");
+
+    // Variante gzip de nivel máximo: se comprime una vez, se sirve siempre
+    if (type && type->compressible &&
+        Gzip::compress(asset->body, asset->gzipBody, 9) &&
+        asset->gzipBody.size() < asset->body.size()) {
+      asset->gzipETag = quotedHash(asset->body, "-gz");
+    } else {
+      asset->gzipBody.clear();
+    }
+
+    bytes += asset->body.size();
+    gzipBytes += asset->gzipBody.empty() ? asset->body.size()
+                                         : asset->gzipBody.size();
+    (*assets)[name] = std::move(asset);
+  }
+
+  std::cout << "[StaticAssetCache] " << assets->size() << " archivos de "
+            << root_ << " (" << bytes << " bytes, " << gzipBytes
+            << " con gzip)" << std::endl;
+  std::atomic_store(&assets_, std::shared_ptr<const AssetMap>(assets));
+  return true;
+}
+
+std::shared_ptr<const StaticAsset>
+StaticAssetCache::find(const std::string &name) const {
+  auto assets = std::atomic_load(&assets_);
+  if (!assets)
+    return nullptr;
+  auto it = assets->find(name);
+  return it != assets->end() ? it->second : nullptr;
+}
+
+size_t StaticAssetCache::size() const {
+  auto assets = std::atomic_load(&assets_);
+  return assets ? assets->size() : 0;
+}
+
+std::string_view StaticAssetCache::contentTypeFor(std::string_view filename) {
+  const ContentType *type = findContentType(filename);
+  return type ? type->type : "application/octet-stream";
+}
+
+} // namespace OSBot
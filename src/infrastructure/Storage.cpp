@@ -2,6 +2,9 @@
 #include "domain/Environment.h"
 #include "domain/Robot.h"
 #include "application/TaskScheduler.h"
+#include "infrastructure/GridCodec.h"
+#include "infrastructure/Tracer.h"
+#include <algorithm>
 #include <cstring>
 #include <ctime>
 #include <iostream>
@@ -16,6 +19,7 @@ bool Storage::save_state(const std::string &filename,
                          const Environment &environment,
                          const std::vector<const Robot *> &robots,
                          const TaskScheduler &task_scheduler) {
+  TraceSpan span("Storage::save_state", "storage");
 
   std::ofstream ofs(filename, std::ios::binary);
   if (!ofs.is_open()) {
@@ -30,15 +34,12 @@ bool Storage::save_state(const std::string &filename,
     uint16_t num_robots = static_cast<uint16_t>(robots.size());
     uint16_t num_tasks = static_cast<uint16_t>(tasks.size());
 
-    // Contar obstáculos
-    uint16_t num_obstacles = 0;
-    for (int x = 0; x < environment.getWidth(); ++x) {
-        for (int y = 0; y < environment.getHeight(); ++y) {
-            if (!environment.isPositionFree(Point(x, y))) {
-                num_obstacles++;
-            }
-        }
-    }
+    // Contar obstáculos (solo informativo en v2; se satura en 65535)
+    std::vector<uint8_t> mask;
+    environment.copyObstacleMask(mask);
+    size_t obstacles = std::count(mask.begin(), mask.end(), uint8_t{1});
+    uint16_t num_obstacles =
+        static_cast<uint16_t>(std::min<size_t>(obstacles, UINT16_MAX));
 
     // Escribir secciones
     writeHeader(ofs, num_robots, num_tasks, num_obstacles);
@@ -88,14 +89,15 @@ void Storage::writeEnvironment(std::ofstream &ofs, const Environment &env) {
   ofs.write(reinterpret_cast<const char *>(&width), sizeof(width));
   ofs.write(reinterpret_cast<const char *>(&height), sizeof(height));
 
-  // Escribir obstáculos
-  for (int x = 0; x < width; ++x) {
-      for (int y = 0; y < height; ++y) {
-          if (!env.isPositionFree(Point(x, y))) {
-              writePoint(ofs, Point(x, y));
-          }
-      }
-  }
+  // Bitmap de obstáculos (v2): una sola copia del mapa bajo su lock
+  std::vector<uint8_t> mask;
+  env.copyObstacleMask(mask);
+  std::string packed;
+  GridCodec::pack(mask, width, height, packed);
+
+  uint32_t packed_size = static_cast<uint32_t>(packed.size());
+  ofs.write(reinterpret_cast<const char *>(&packed_size), sizeof(packed_size));
+  ofs.write(packed.data(), packed.size());
 }
 
 void Storage::writeRobots(std::ofstream &ofs,
@@ -149,17 +151,17 @@ bool Storage::load_state(const std::string &filename, Environment &environment,
   }
 
   try {
-    uint16_t num_robots, num_tasks, num_obstacles;
+    uint16_t version, num_robots, num_tasks, num_obstacles;
 
     // Leer y validar header
-    if (!readHeader(ifs, num_robots, num_tasks, num_obstacles)) {
+    if (!readHeader(ifs, version, num_robots, num_tasks, num_obstacles)) {
       std::cerr << "[Storage] Error: Archivo corrupto o incompatible"
                 << std::endl;
       return false;
     }
 
     // Leer secciones
-    if (!readEnvironment(ifs, environment, num_obstacles))
+    if (!readEnvironment(ifs, environment, version, num_obstacles))
       return false;
     if (!readRobots(ifs, robots, num_robots, environment))
       return false;
@@ -178,8 +180,38 @@ bool Storage::load_state(const std::string &filename, Environment &environment,
   }
 }
 
-bool Storage::readHeader(std::ifstream &ifs, uint16_t &num_robots,
-                         uint16_t &num_tasks, uint16_t &num_obstacles) {
+bool Storage::read_dimensions(const std::string &filename, int &width,
+                              int &height) {
+  std::ifstream ifs(filename, std::ios::binary);
+  if (!ifs.is_open()) {
+    std::cerr << "[Storage] Error: No se pudo abrir el archivo: " << filename
+              << std::endl;
+    return false;
+  }
+
+  uint16_t version, num_robots, num_tasks, num_obstacles;
+  if (!readHeader(ifs, version, num_robots, num_tasks, num_obstacles)) {
+    return false;
+  }
+
+  // Las dimensiones son lo primero de la sección de entorno
+  int32_t w, h;
+  ifs.read(reinterpret_cast<char *>(&w), sizeof(w));
+  ifs.read(reinterpret_cast<char *>(&h), sizeof(h));
+  if (!ifs || w <= 0 || h <= 0) {
+    std::cerr << "[Storage] Error: Dimensiones inválidas en: " << filename
+              << std::endl;
+    return false;
+  }
+
+  width = w;
+  height = h;
+  return true;
+}
+
+bool Storage::readHeader(std::ifstream &ifs, uint16_t &version,
+                         uint16_t &num_robots, uint16_t &num_tasks,
+                         uint16_t &num_obstacles) {
   // Leer magic number
   uint32_t magic;
   ifs.read(reinterpret_cast<char *>(&magic), sizeof(magic));
@@ -190,9 +222,8 @@ bool Storage::readHeader(std::ifstream &ifs, uint16_t &num_robots,
   }
 
   // Leer versión
-  uint16_t version;
   ifs.read(reinterpret_cast<char *>(&version), sizeof(version));
-  if (version != VERSION) {
+  if (version < MIN_VERSION || version > VERSION) {
     std::cerr << "[Storage] Versión incompatible: " << version << std::endl;
     return false;
   }
@@ -216,7 +247,8 @@ Point Storage::readPoint(std::ifstream &ifs) {
   return p;
 }
 
-bool Storage::readEnvironment(std::ifstream &ifs, Environment &env, uint16_t num_obstacles) {
+bool Storage::readEnvironment(std::ifstream &ifs, Environment &env,
+                              uint16_t version, uint16_t num_obstacles) {
   // Leer dimensiones
   int32_t width, height;
   ifs.read(reinterpret_cast<char *>(&width), sizeof(width));
@@ -231,8 +263,39 @@ bool Storage::readEnvironment(std::ifstream &ifs, Environment &env, uint16_t num
 
   // Limpiar obstáculos actuales
   env.clearAllObstacles();
-  
-  // Leer obstáculos y marcarlos
+
+  if (version >= 2) {
+    // v2: bitmap de GridCodec
+    uint32_t packed_size = 0;
+    ifs.read(reinterpret_cast<char *>(&packed_size), sizeof(packed_size));
+    if (!ifs || width <= 0 || height <= 0 ||
+        packed_size != GridCodec::packedSize(width, height)) {
+      std::cerr << "[Storage] Error: Sección de grid inválida" << std::endl;
+      return false;
+    }
+
+    std::vector<uint8_t> packed(packed_size);
+    ifs.read(reinterpret_cast<char *>(packed.data()), packed_size);
+    std::vector<uint8_t> mask;
+    if (!ifs || !GridCodec::unpack(packed.data(), packed.size(), width, height,
+                                   mask)) {
+      std::cerr << "[Storage] Error: Grid truncado" << std::endl;
+      return false;
+    }
+
+    // Como limpiamos todo antes, toggle agregará (los bordes no se tocan)
+    int common_width = std::min<int>(width, env.getWidth());
+    int common_height = std::min<int>(height, env.getHeight());
+    for (int y = 0; y < common_height; ++y) {
+      for (int x = 0; x < common_width; ++x) {
+        if (mask[static_cast<size_t>(y) * width + x])
+          env.toggleObstacle(Point(x, y));
+      }
+    }
+    return true;
+  }
+
+  // v1: leer obstáculos y marcarlos
   for (uint16_t i = 0; i < num_obstacles; ++i) {
       Point p = readPoint(ifs);
       // toggleObstacle agrega si no existe, o quita si existe.
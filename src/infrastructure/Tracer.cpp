@@ -0,0 +1,181 @@
+#include "infrastructure/Tracer.h"
+#include "infrastructure/JsonWriter.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace OSBot {
+
+std::atomic<bool> Tracer::enabled_{false};
+std::atomic<bool> Tracer::dumpRequested_{false};
+
+Tracer::Tracer()
+    : epoch_(std::chrono::steady_clock::now()), nextThreadId_(1) {}
+
+// Crear el Tracer durante la inicialización estática para fijar la época
+// antes de que cualquier hilo abra un span
+static Tracer &g_tracer = Tracer::instance();
+
+Tracer &Tracer::instance() {
+  static Tracer tracer;
+  return tracer;
+}
+
+struct Tracer::LocalBuffer {
+  std::shared_ptr<ThreadBuffer> buffer;
+
+  ~LocalBuffer() {
+    if (buffer)
+      Tracer::instance().releaseBuffer(buffer);
+  }
+};
+
+Tracer::ThreadBuffer &Tracer::localBuffer() {
+  thread_local LocalBuffer local;
+  if (!local.buffer) {
+    local.buffer = std::make_shared<ThreadBuffer>();
+    local.buffer->events.resize(EVENTS_PER_THREAD);
+
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    local.buffer->threadId = nextThreadId_++;
+    buffers_.push_back(local.buffer);
+  }
+  return *local.buffer;
+}
+
+void Tracer::releaseBuffer(const std::shared_ptr<ThreadBuffer> &buffer) {
+  bool empty;
+  {
+    std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+    empty = buffer->next == 0 && !buffer->wrapped;
+  }
+
+  std::lock_guard<std::mutex> lock(registryMutex_);
+  buffer->exited = true;
+
+  // Sin eventos no hay nada que volcar: liberar ya
+  size_t exited = 0;
+  for (const auto &registered : buffers_)
+    exited += registered->exited ? 1 : 0;
+  for (auto it = buffers_.begin(); it != buffers_.end();) {
+    bool drop = (*it)->exited && ((*it == buffer && empty) ||
+                                  exited > MAX_EXITED_BUFFERS);
+    if (drop) {
+      // Por encima del límite se descartan los más antiguos (primeros)
+      exited--;
+      it = buffers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void Tracer::record(const char *name, const char *category,
+                    std::chrono::steady_clock::time_point start,
+                    std::chrono::steady_clock::time_point end) {
+  ThreadBuffer &buffer = localBuffer();
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+
+  TraceEvent &event = buffer.events[buffer.next];
+  std::strncpy(event.name, name, TraceEvent::NAME_CAPACITY - 1);
+  event.name[TraceEvent::NAME_CAPACITY - 1] = '\0';
+  event.category = category;
+  // Un span puede empezar antes de que se cree el Tracer: acotar a 0
+  event.startNs = start > epoch_
+                      ? static_cast<uint64_t>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                start - epoch_)
+                                .count())
+                      : 0;
+  event.durationNs = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+          .count());
+
+  buffer.next++;
+  if (buffer.next == buffer.events.size()) {
+    buffer.next = 0;
+    buffer.wrapped = true;
+  }
+}
+
+std::string Tracer::toChromeJSON() const {
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffers = buffers_;
+  }
+
+  std::string out;
+  {
+    JsonWriter json(out);
+    json.beginObject();
+    json.field("displayTimeUnit", "ms");
+    json.key("traceEvents");
+    json.beginArray();
+
+    for (const auto &buffer : buffers) {
+      std::lock_guard<std::mutex> lock(buffer->mutex);
+
+      // Recorrer en orden cronológico: [next, end) + [0, next) si dio la
+      // vuelta
+      size_t count = buffer->wrapped ? buffer->events.size() : buffer->next;
+      size_t begin = buffer->wrapped ? buffer->next : 0;
+
+      for (size_t i = 0; i < count; ++i) {
+        const TraceEvent &e =
+            buffer->events[(begin + i) % buffer->events.size()];
+        // El nombre puede venir de la petición (método + ruta HTTP):
+        // JsonWriter escapa también los caracteres de control
+        json.beginObject();
+        json.field("name", e.name);
+        json.field("cat", e.category);
+        json.field("ph", "X");
+        json.field("ts", static_cast<double>(e.startNs) / 1000.0, 1);
+        json.field("dur", static_cast<double>(e.durationNs) / 1000.0, 1);
+        json.field("pid", 1);
+        json.field("tid", buffer->threadId);
+        json.endObject();
+      }
+    }
+
+    json.endArray();
+    json.endObject();
+  }
+  return out;
+}
+
+bool Tracer::dumpToFile(const std::string &filename) const {
+  std::ofstream ofs(filename);
+  if (!ofs.is_open()) {
+    std::cerr << "[Tracer] Error: No se pudo crear el archivo: " << filename
+              << std::endl;
+    return false;
+  }
+
+  ofs << toChromeJSON();
+  std::cout << "[Tracer] Traza guardada en: " << filename << std::endl;
+  return true;
+}
+
+size_t Tracer::bufferCount() const {
+  std::lock_guard<std::mutex> lock(registryMutex_);
+  return buffers_.size();
+}
+
+void Tracer::clear() {
+  std::lock_guard<std::mutex> lock(registryMutex_);
+  // Los de hilos terminados quedarían vacíos para siempre: liberarlos
+  buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                [](const std::shared_ptr<ThreadBuffer> &b) {
+                                  return b->exited;
+                                }),
+                 buffers_.end());
+  for (auto &buffer : buffers_) {
+    std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+    buffer->next = 0;
+    buffer->wrapped = false;
+  }
+}
+
+} // namespace OSBot
@@ -2,15 +2,248 @@
 #include "application/Kernel.h"
 #include "domain/Environment.h"
 #include "domain/Global.h"
+#include "infrastructure/Gzip.h"
+#include "infrastructure/JsonReader.h"
+#include "infrastructure/JsonWriter.h"
+#include "infrastructure/Metrics.h"
+#include "infrastructure/Tracer.h"
 #include "infrastructure/httplib.h"
-#include <fstream>
+#include <charconv>
 #include <iostream>
-#include <sstream>
+#include <string_view>
+#include <vector>
 
 namespace OSBot {
 
+namespace {
+
+// Límites de los cuerpos de petición
+constexpr size_t MAX_BATCH = 1024;    // Elementos por petición de lote
+constexpr size_t MAX_WAYPOINTS = 256; // Waypoints por tarea
+constexpr int MAX_TICK_MS = 10000;
+
+// Por debajo de este tamaño gzip no compensa la latencia de comprimir
+constexpr size_t GZIP_MIN_BYTES = 1024;
+
+/**
+ * @brief Tarea leída de un cuerpo JSON, aún sin encolar
+ */
+struct TaskRequest {
+  std::vector<Point> waypoints;
+  TaskPriority priority = TaskPriority::NORMAL;
+  int deadlineMs = 0; // Plazo relativo (0 = sin plazo)
+};
+
+// La petición en curso modificó el mundo (cada petición se atiende entera
+// en un hilo del pool de httplib)
+thread_local bool worldChanged = false;
+
+/**
+ * @brief Marca que la petición cambió el mundo: al terminar se publica una
+ * foto nueva. Las rechazadas o sin efecto no pagan la captura.
+ */
+void markWorldChanged() { worldChanged = true; }
+
+void sendJSON(httplib::Response &res, const std::string &content) {
+  res.set_content(content, "application/json");
+  res.set_header("Access-Control-Allow-Origin", "*");
+}
+
+/**
+ * @brief 400 con el primer error del parser y su posición en el cuerpo
+ * NOTA: Los mensajes de JsonReader son constantes sin comillas ni '\'
+ */
+void sendParseError(httplib::Response &res, const JsonReader &json) {
+  res.status = 400;
+  sendJSON(res, std::string("{\"success\":false,\"error\":\"") +
+                    json.error() + "\",\"offset\":" +
+                    std::to_string(json.errorOffset()) + "}");
+}
+
+bool isInside(const Environment &env, const Point &p) {
+  return p.x >= 0 && p.x < env.getWidth() && p.y >= 0 && p.y < env.getHeight();
+}
+
+/**
+ * @brief Lee {"x":N,"y":N} y valida que la celda esté dentro del mapa
+ */
+bool readCell(JsonReader &json, const Environment &env, Point &cell) {
+  bool hasX = false, hasY = false;
+  bool ok = json.readObject([&](std::string_view key) {
+    if (key == "x") {
+      hasX = true;
+      return json.readInt(cell.x);
+    }
+    if (key == "y") {
+      hasY = true;
+      return json.readInt(cell.y);
+    }
+    return json.skipValue();
+  });
+  if (!ok)
+    return false;
+  if (!hasX || !hasY)
+    return json.fail("faltan los campos x/y");
+  if (!isInside(env, cell))
+    return json.fail("celda fuera del mapa");
+  return true;
+}
+
+/**
+ * @brief Lee {"<field>":bool} o un booleano suelto
+ */
+bool readFlag(JsonReader &json, std::string_view field, bool &value) {
+  if (json.peek() != '{')
+    return json.readBool(value);
+
+  bool found = false;
+  bool ok = json.readObject([&](std::string_view key) {
+    if (key == field) {
+      found = true;
+      return json.readBool(value);
+    }
+    return json.skipValue();
+  });
+  if (ok && !found)
+    return json.fail("falta el campo booleano");
+  return ok;
+}
+
+/**
+ * @brief Lee {"waypoints":[{"x":N,"y":N},...],"priority":0-3,"deadlineMs":N}
+ */
+bool readTask(JsonReader &json, const Environment &env, TaskRequest &task) {
+  bool ok = json.readObject([&](std::string_view key) {
+    if (key == "waypoints") {
+      return json.readArray([&](size_t index) {
+        if (index >= MAX_WAYPOINTS)
+          return json.fail("demasiados waypoints");
+        Point waypoint;
+        if (!readCell(json, env, waypoint))
+          return false;
+        task.waypoints.push_back(waypoint);
+        return true;
+      });
+    }
+    if (key == "priority") {
+      int priority = 0;
+      if (!json.readInt(priority))
+        return false;
+      if (priority < 0 || priority > 3)
+        return json.fail("prioridad fuera de rango (0-3)");
+      task.priority = static_cast<TaskPriority>(priority);
+      return true;
+    }
+    if (key == "deadlineMs") {
+      if (!json.readInt(task.deadlineMs))
+        return false;
+      if (task.deadlineMs < 0)
+        return json.fail("plazo negativo");
+      return true;
+    }
+    return json.skipValue();
+  });
+  if (ok && task.waypoints.empty())
+    return json.fail("tarea sin waypoints");
+  return ok;
+}
+
+/**
+ * @brief true si la lista de If-None-Match contiene 'etag' (o es "*")
+ * Compara en modo débil: W/"x" equivale a "x"
+ */
+bool matchesETag(std::string_view header, std::string_view etag) {
+  if (etag.substr(0, 2) == "W/")
+    etag.remove_prefix(2);
+  while (!header.empty()) {
+    size_t comma = header.find(',');
+    std::string_view token = header.substr(0, comma);
+    header = comma == std::string_view::npos ? std::string_view()
+                                             : header.substr(comma + 1);
+
+    while (!token.empty() && token.front() == ' ')
+      token.remove_prefix(1);
+    while (!token.empty() && token.back() == ' ')
+      token.remove_suffix(1);
+    if (token.substr(0, 2) == "W/")
+      token.remove_prefix(2);
+    if (token == etag || token == "*")
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Etiqueta la respuesta y la convierte en 304 si el cliente ya la tiene
+ * Se llama antes de serializar o leer nada: en el 304 no hay cuerpo.
+ * "no-cache" obliga al navegador a revalidar siempre con If-None-Match.
+ * @return true si ya se respondió 304
+ */
+bool notModified(const httplib::Request &req, httplib::Response &res,
+                 const std::string &etag) {
+  res.set_header("ETag", etag);
+  res.set_header("Cache-Control", "no-cache");
+  if (!req.has_header("If-None-Match") ||
+      !matchesETag(req.get_header_value("If-None-Match"), etag))
+    return false;
+
+  res.status = 304;
+  res.set_header("Access-Control-Allow-Origin", "*");
+  return true;
+}
+
+/**
+ * @brief ETag de una forma de la foto: prefijo de la forma + arranque +
+ * versión
+ * Débil (W/): la misma versión vale con o sin gzip, así el 304 se decide
+ * sin saber aún qué codificación se enviaría. La versión reinicia en cada
+ * arranque: sin el epoch un ETag de la ejecución anterior podría coincidir.
+ */
+std::string snapshotETag(char kind, uint64_t version) {
+  return "W/\"" + std::string(1, kind) +
+         std::to_string(WorldSnapshot::bootEpoch()) + "-" +
+         std::to_string(version) + '"';
+}
+
+/**
+ * @brief Resumen de una tarea archivada como objeto JSON
+ */
+void writeTaskRecord(JsonWriter &json, const TaskRecord &record) {
+  static const char *STATUS_NAMES[] = {"pending",   "assigned", "in_progress",
+                                       "completed", "failed",   "cancelled"};
+  json.beginObject();
+  json.field("id", record.id);
+  json.field("status", STATUS_NAMES[static_cast<int>(record.status)]);
+  json.field("priority", static_cast<int>(record.priority));
+  json.field("robot", record.robotId);
+  json.field("visited", record.waypointsVisited);
+  json.field("waypoints", record.waypointCount);
+  json.field("createdMs", record.createdMs);
+  json.field("startMs", record.startMs);
+  json.field("finishedMs", record.finishedMs);
+  json.endObject();
+}
+
+/**
+ * @brief Sirve un cuerpo inmutable sin copiarlo a la respuesta
+ * 'owner' (la foto o el asset dueño de 'body') sigue vivo hasta que httplib
+ * termina de escribir.
+ */
+void sendShared(httplib::Response &res, std::shared_ptr<const void> owner,
+                const std::string &body, const std::string &contentType) {
+  res.set_content_provider(
+      body.size(), contentType,
+      [owner = std::move(owner), &body](size_t offset, size_t length,
+                                        httplib::DataSink &sink) {
+        return sink.write(body.data() + offset, length);
+      });
+  res.set_header("Access-Control-Allow-Origin", "*");
+}
+
+} // namespace
+
 WebServer::WebServer(Kernel &kernel, int port)
-    : kernel_(kernel), port_(port), running_(false) {}
+    : kernel_(kernel), port_(port), running_(false), assets_("web") {}
 
 WebServer::~WebServer() { stop(); }
 
@@ -18,7 +251,13 @@ void WebServer::start() {
   if (running_)
     return;
 
+  assets_.load();
+
   running_ = true;
+  server_ = std::make_unique<httplib::Server>();
+  // Sin TCP_NODELAY, con keep-alive cada respuesta (cabeceras y cuerpo en
+  // escrituras separadas) espera el ACK retardado del cliente: ~40 ms
+  server_->set_tcp_nodelay(true);
   serverThread_ = std::make_unique<std::thread>(&WebServer::serverLoop, this);
   std::cout << "[WebServer] Iniciado en http://localhost:" << port_
             << std::endl;
@@ -29,219 +268,355 @@ void WebServer::stop() {
     return;
 
   running_ = false;
+  // Desbloquear listen() para que el hilo pueda terminar
+  if (server_) {
+    server_->stop();
+  }
   if (serverThread_ && serverThread_->joinable()) {
     serverThread_->join();
   }
   std::cout << "[WebServer] Detenido" << std::endl;
 }
 
-void WebServer::serverLoop() {
-  httplib::Server server;
+void WebServer::serviceAssetReload() {
+  if (StaticAssetCache::consumeReloadRequest()) {
+    std::cout << "[WebServer] Recargando " << assets_.getRoot() << "/..."
+              << std::endl;
+    assets_.load();
+  }
+}
 
-  // Endpoint: Página principal
-  server.Get("/", [this](const httplib::Request &, httplib::Response &res) {
-    res.set_content(serveStaticFile("index.html"), "text/html");
+void WebServer::serverLoop() {
+  httplib::Server &server = *server_;
+
+  // Trazas: un span por petición HTTP (pre-routing → respuesta escrita)
+  // Ambos callbacks corren en el mismo hilo del pool de httplib
+  static thread_local std::chrono::steady_clock::time_point requestStart;
+  server.set_pre_routing_handler(
+      [](const httplib::Request &, httplib::Response &) {
+        worldChanged = false;
+        if (Tracer::isEnabled())
+          requestStart = std::chrono::steady_clock::now();
+        return httplib::Server::HandlerResponse::Unhandled;
+      });
+  server.set_logger([](const httplib::Request &req, const httplib::Response &) {
+    if (Tracer::isEnabled() &&
+        requestStart != std::chrono::steady_clock::time_point{}) {
+      std::string name = req.method + " " + req.path;
+      Tracer::instance().record(name.c_str(), "http", requestStart,
+                                std::chrono::steady_clock::now());
+      requestStart = {};
+    }
   });
 
-  // Endpoint: CSS
-  server.Get("/styles.css",
-             [this](const httplib::Request &, httplib::Response &res) {
-               res.set_content(serveStaticFile("styles.css"), "text/css");
-             });
-
-  // Endpoint: JavaScript
-  server.Get("/app.js",
-             [this](const httplib::Request &, httplib::Response &res) {
-               res.set_content(serveStaticFile("app.js"),
-                               "application/javascript");
-             });
+  // Tras una modificación se publica una foto nueva: el siguiente GET la ve
+  // sin esperar al tick (importante en pausa o con ticks largos). Solo si
+  // el handler cambió algo (markWorldChanged)
+  server.set_post_routing_handler(
+      [this](const httplib::Request &, httplib::Response &) {
+        if (worldChanged) {
+          worldChanged = false;
+          kernel_.publishSnapshot();
+        }
+      });
 
   // API: Obtener estado completo
   server.Get("/api/state",
-             [this](const httplib::Request &, httplib::Response &res) {
-               res.set_content(getStateJSON(), "application/json");
+             [this](const httplib::Request &req, httplib::Response &res) {
+               // Serializado una vez por foto, compartido entre peticiones
+               // Vary también en los 304: la respuesta depende de la
+               // codificación negociada
+               res.set_header("Vary", "Accept-Encoding");
+               auto snapshot = kernel_.getSnapshot();
+               if (notModified(req, res, snapshotETag('w', snapshot->getVersion())))
+                 return;
+               const std::string &body = snapshot->stateJSON();
+
+               // gzip negociado: una compresión por versión del mundo
+               int level = kernel_.getConfig().gzipLevel;
+               if (level > 0 && body.size() >= GZIP_MIN_BYTES &&
+                   Gzip::isAccepted(req.get_header_value("Accept-Encoding"))) {
+                 const std::string &gzip = snapshot->stateJSONGzip(level);
+                 if (!gzip.empty()) {
+                   res.set_header("Content-Encoding", "gzip");
+                   sendShared(res, std::move(snapshot), gzip, "application/json");
+                   return;
+                 }
+               }
+               sendShared(res, std::move(snapshot), body, "application/json");
+             });
+
+  // API: Estado en binario compacto (clientes de alta frecuencia)
+  // ?since=<versión del mapa>&epoch=<arranque> permite recibir solo el
+  // delta del grid; sin 'epoch' o de otro arranque llega el grid completo
+  server.Get("/api/state.bin",
+             [this](const httplib::Request &req, httplib::Response &res) {
+               auto readParam = [&](const char *name, uint64_t &out) {
+                 if (!req.has_param(name))
+                   return true;
+                 std::string value = req.get_param_value(name);
+                 auto result = std::from_chars(
+                     value.data(), value.data() + value.size(), out);
+                 return result.ec == std::errc() &&
+                        result.ptr == value.data() + value.size();
+               };
+               uint64_t since = 0;
+               uint64_t epoch = 0;
+               if (!readParam("since", since) || !readParam("epoch", epoch)) {
+                 res.status = 400;
+                 sendJSON(res, "{\"success\":false,\"error\":\"since/epoch inválido\"}");
+                 return;
+               }
+               // Versiones de otro arranque no corresponden a este historial
+               if (epoch != WorldSnapshot::bootEpoch())
+                 since = 0;
+               auto snapshot = kernel_.getSnapshot();
+               // El cuerpo depende de 'since' y 'epoch', que forman parte
+               // de la URL, y
+               // del tick de la cabecera, que no entra en la versión
+               std::string etag = snapshotETag('b', snapshot->getVersion());
+               etag.insert(etag.size() - 1,
+                           "-" + std::to_string(snapshot->getTick()));
+               if (notModified(req, res, etag))
+                 return;
+               if (since == 0 || since == snapshot->getMapVersion()) {
+                 // Casos habituales: memoizados en la foto
+                 const std::string &body = since == 0
+                                               ? snapshot->frame()
+                                               : snapshot->unchangedFrame();
+                 sendShared(res, std::move(snapshot), body,
+                            "application/octet-stream");
+                 return;
+               }
+               thread_local std::string buffer;
+               snapshot->writeFrame(buffer, epoch, since,
+                                    &kernel_.getGridHistory());
+               res.set_content(buffer, "application/octet-stream");
                res.set_header("Access-Control-Allow-Origin", "*");
              });
 
   // API: Cambiar objetivo
   server.Post("/api/goal",
               [this](const httplib::Request &req, httplib::Response &res) {
-                // Parse manual de JSON simple: {"x":10,"y":20}
-                std::string body = req.body;
-                size_t xPos = body.find("\"x\":");
-                size_t yPos = body.find("\"y\":");
-
-                if (xPos != std::string::npos && yPos != std::string::npos) {
-                  int x = std::stoi(
-                      body.substr(xPos + 4, body.find(",", xPos) - xPos - 4));
-                  int y = std::stoi(
-                      body.substr(yPos + 4, body.find("}", yPos) - yPos - 4));
-
-                  // Limpiar todos los objetivos personales primero
-                  kernel_.getRobotManager().clearAllPersonalGoals();
-                  
-                  kernel_.getEnvironment().setGoal(Point(x, y));
-                  res.set_content("{\"success\":true}", "application/json");
-                } else {
-                  res.set_content("{\"success\":false,\"error\":\"Invalid JSON\"}",
-                                  "application/json");
+                // {"x":10,"y":20}
+                auto &env = kernel_.getEnvironment();
+                JsonReader json(req.body);
+                Point goal;
+                if (!readCell(json, env, goal) || !json.finish()) {
+                  sendParseError(res, json);
+                  return;
                 }
-                res.set_header("Access-Control-Allow-Origin", "*");
+
+                // Limpiar todos los objetivos personales primero
+                kernel_.getRobotManager().clearAllPersonalGoals();
+
+                env.setGoal(goal);
+                markWorldChanged();
+                sendJSON(res, "{\"success\":true}");
               });
 
   // API: Pausar/reanudar
   server.Post("/api/pause",
               [this](const httplib::Request &req, httplib::Response &res) {
-                std::string body = req.body;
-                bool paused = body.find("true") != std::string::npos;
+                // {"paused":true} o simplemente true
+                JsonReader json(req.body);
+                bool paused = false;
+                if (!readFlag(json, "paused", paused) || !json.finish()) {
+                  sendParseError(res, json);
+                  return;
+                }
                 kernel_.setPaused(paused);
-                res.set_content("{\"success\":true}", "application/json");
-                res.set_header("Access-Control-Allow-Origin", "*");
+                markWorldChanged();
+                sendJSON(res, "{\"success\":true}");
               });
 
   // API: Cambiar velocidad
   server.Post("/api/speed",
               [this](const httplib::Request &req, httplib::Response &res) {
-                std::string body = req.body;
-                size_t pos = body.find("\"speed\":");
-                if (pos != std::string::npos) {
-                  int speed = std::stoi(
-                      body.substr(pos + 8, body.find("}", pos) - pos - 8));
-                  kernel_.setSimulationSpeed(speed);
-                  res.set_content("{\"success\":true}", "application/json");
-                } else {
-                  res.set_content("{\"success\":false}", "application/json");
+                // {"speed":50} (ms por tick)
+                JsonReader json(req.body);
+                int speed = 0;
+                bool hasSpeed = false;
+                bool ok = json.readObject([&](std::string_view key) {
+                  if (key == "speed") {
+                    hasSpeed = true;
+                    return json.readInt(speed);
+                  }
+                  return json.skipValue();
+                });
+                if (ok && !hasSpeed)
+                  ok = json.fail("falta el campo speed");
+                if (ok && (speed < 1 || speed > MAX_TICK_MS))
+                  ok = json.fail("speed fuera de rango");
+                if (!ok || !json.finish()) {
+                  sendParseError(res, json);
+                  return;
                 }
-                res.set_header("Access-Control-Allow-Origin", "*");
+                kernel_.setSimulationSpeed(speed);
+                markWorldChanged();
+                sendJSON(res, "{\"success\":true}");
               });
 
   // API: Toggle obstáculo (agregar/eliminar)
   server.Post("/api/obstacle",
               [this](const httplib::Request &req, httplib::Response &res) {
-                std::string body = req.body;
-                size_t xPos = body.find("\"x\":");
-                size_t yPos = body.find("\"y\":");
-
-                if (xPos != std::string::npos && yPos != std::string::npos) {
-                  int x = std::stoi(
-                      body.substr(xPos + 4, body.find(",", xPos) - xPos - 4));
-                  int y = std::stoi(
-                      body.substr(yPos + 4, body.find("}", yPos) - yPos - 4));
-
-                  bool added = kernel_.getEnvironment().toggleObstacle(Point(x, y));
-                  std::string result = added ? "\"added\"" : "\"removed\"";
-                  res.set_content("{\"success\":true,\"action\":" + result + "}", 
-                                  "application/json");
-                } else {
-                  res.set_content("{\"success\":false}", "application/json");
+                auto &env = kernel_.getEnvironment();
+                JsonReader json(req.body);
+                Point cell;
+                if (!readCell(json, env, cell) || !json.finish()) {
+                  sendParseError(res, json);
+                  return;
                 }
-                res.set_header("Access-Control-Allow-Origin", "*");
+
+                bool added = env.toggleObstacle(cell);
+                markWorldChanged();
+                std::string result = added ? "\"added\"" : "\"removed\"";
+                sendJSON(res, "{\"success\":true,\"action\":" + result + "}");
+              });
+
+  // API: Toggle de varios obstáculos: [{"x":1,"y":2},...]
+  server.Post("/api/obstacles",
+              [this](const httplib::Request &req, httplib::Response &res) {
+                auto &env = kernel_.getEnvironment();
+                JsonReader json(req.body);
+                // Se valida el lote completo antes de aplicar nada
+                std::vector<Point> cells;
+                bool ok = json.readArray([&](size_t index) {
+                  if (index >= MAX_BATCH)
+                    return json.fail("lote demasiado grande");
+                  Point cell;
+                  if (!readCell(json, env, cell))
+                    return false;
+                  cells.push_back(cell);
+                  return true;
+                });
+                if (!ok || !json.finish()) {
+                  sendParseError(res, json);
+                  return;
+                }
+
+                int added = 0;
+                for (const Point &cell : cells) {
+                  if (env.toggleObstacle(cell))
+                    added++;
+                }
+                int removed = static_cast<int>(cells.size()) - added;
+                if (!cells.empty())
+                  markWorldChanged();
+                sendJSON(res, "{\"success\":true,\"added\":" +
+                                  std::to_string(added) + ",\"removed\":" +
+                                  std::to_string(removed) + "}");
               });
 
   // API: Limpiar todos los obstáculos
   server.Post("/api/clear-obstacles",
               [this](const httplib::Request &, httplib::Response &res) {
                 kernel_.getEnvironment().clearAllObstacles();
-                res.set_content("{\"success\":true}", "application/json");
-                res.set_header("Access-Control-Allow-Origin", "*");
+                markWorldChanged();
+                sendJSON(res, "{\"success\":true}");
               });
 
   // API: Generar obstáculos aleatorios
   server.Post("/api/random-obstacles",
               [this](const httplib::Request &req, httplib::Response &res) {
-                std::string body = req.body;
-                int percentage = 25; // default
-                
-                size_t pos = body.find("\"percentage\":");
-                if (pos != std::string::npos) {
-                  percentage = std::stoi(
-                      body.substr(pos + 13, body.find("}", pos) - pos - 13));
+                // {"percentage":25}; cuerpo vacío usa el valor por defecto
+                JsonReader json(req.body);
+                int percentage = 25;
+                bool ok = json.peek() == '\0' ||
+                          (json.readObject([&](std::string_view key) {
+                            if (key == "percentage")
+                              return json.readInt(percentage);
+                            return json.skipValue();
+                          }) && json.finish());
+                if (ok && (percentage < 0 || percentage > 100))
+                  ok = json.fail("percentage fuera de rango (0-100)");
+                // Robot y objetivo nunca se cubren: 100% (o casi, en mapas
+                // pequeños) no cabe y se rechaza sin tocar el mapa
+                if (ok && !kernel_.getEnvironment().generateRandomObstacles(percentage))
+                  ok = json.fail("percentage demasiado alto para el mapa");
+                if (!ok) {
+                  sendParseError(res, json);
+                  return;
                 }
-                
-                kernel_.getEnvironment().generateRandomObstacles(percentage);
-                res.set_content("{\"success\":true}", "application/json");
-                res.set_header("Access-Control-Allow-Origin", "*");
+
+                markWorldChanged();
+                sendJSON(res, "{\"success\":true}");
               });
 
   // API: Reiniciar - reposicionar robot aleatoriamente
   server.Post("/api/reset",
               [this](const httplib::Request &, httplib::Response &res) {
                 kernel_.getRobotManager().resetRobotPosition();
-                res.set_content("{\"success\":true}", "application/json");
-                res.set_header("Access-Control-Allow-Origin", "*");
+                markWorldChanged();
+                sendJSON(res, "{\"success\":true}");
               });
 
   // API: Agregar nuevo robot
   server.Post("/api/robot",
               [this](const httplib::Request &req, httplib::Response &res) {
-                std::string body = req.body;
+                // {"x":3,"y":4}; sin coordenadas (o negativas) -> aleatoria
+                auto &env = kernel_.getEnvironment();
+                JsonReader json(req.body);
                 int x = -1, y = -1;
-                
-                size_t xPos = body.find("\"x\":");
-                size_t yPos = body.find("\"y\":");
-
-                if (xPos != std::string::npos && yPos != std::string::npos) {
-                  x = std::stoi(body.substr(xPos + 4, body.find(",", xPos) - xPos - 4));
-                  y = std::stoi(body.substr(yPos + 4, body.find("}", yPos) - yPos - 4));
+                bool ok = json.peek() == '\0' ||
+                          (json.readObject([&](std::string_view key) {
+                            if (key == "x")
+                              return json.readInt(x);
+                            if (key == "y")
+                              return json.readInt(y);
+                            return json.skipValue();
+                          }) && json.finish());
+                if (ok && (x >= env.getWidth() || y >= env.getHeight()))
+                  ok = json.fail("celda fuera del mapa");
+                if (!ok) {
+                  sendParseError(res, json);
+                  return;
                 }
 
                 // Si no se especifican coordenadas o son inválidas, usar posición aleatoria
                 if (x < 0 || y < 0) {
-                   // Usar lógica simple para posición aleatoria segura
-                   auto& env = kernel_.getEnvironment();
-                   int width = env.getWidth();
-                   int height = env.getHeight();
-                   
-                   // Intentar encontrar una posición libre (máx 50 intentos)
-                   bool found = false;
-                   for(int i=0; i<50; ++i) {
-                       int tx = 5 + (rand() % (width - 10));
-                       int ty = 5 + (rand() % (height - 10));
-                       if(env.isPositionFree(Point(tx, ty))) {
-                           x = tx;
-                           y = ty;
-                           found = true;
-                           break;
-                       }
-                   }
-                   // Fallback si no encuentra (aunque improbable con 50 intentos en mapa vacío)
-                   if(!found) { x = 5; y = 5; }
+                   Point pos = env.randomFreePosition();
+                   x = pos.x;
+                   y = pos.y;
                 }
 
                 // *** LÍMITE DE ESTABILIDAD: Máximo 2 robots ***
                 const int MAX_ROBOTS = 2;
                 auto currentRobotIds = kernel_.getRobotManager().getRobotIds();
                 if (currentRobotIds.size() >= MAX_ROBOTS) {
-                    std::string response = "{\"success\":false,\"error\":\"Maximum robot limit reached\"}";
-                    res.set_content(response, "application/json");
-                    res.set_header("Access-Control-Allow-Origin", "*");
+                    sendJSON(res, "{\"success\":false,\"error\":\"Maximum robot limit reached\"}");
                     return;
                 }
 
                 int id = kernel_.getRobotManager().addRobot(Point(x, y));
-                
+
                 // Si el robot se creó exitosamente, inciarlo si el sistema no está pausado
                 if (id > 0) {
                     auto info = kernel_.getRobotManager().getRobotInfo(id);
                     if (info && info->robot) {
                          info->robot->start();
                     }
+                    markWorldChanged();
                 }
 
-                std::string response = "{\"success\":true,\"id\":" + std::to_string(id) + "}";
-                res.set_content(response, "application/json");
-                res.set_header("Access-Control-Allow-Origin", "*");
+                sendJSON(res, "{\"success\":true,\"id\":" + std::to_string(id) + "}");
               });
 
   // API: Eliminar robot
   server.Post("/api/robot/delete",
               [this](const httplib::Request &req, httplib::Response &res) {
-                std::string body = req.body;
+                // {"id":2}; sin ID se borra el último
+                JsonReader json(req.body);
                 int id = -1;
-                
-                size_t idPos = body.find("\"id\":");
-                if (idPos != std::string::npos) {
-                   id = std::stoi(body.substr(idPos + 5, body.find("}", idPos) - idPos - 5));
+                bool ok = json.peek() == '\0' ||
+                          (json.readObject([&](std::string_view key) {
+                            if (key == "id")
+                              return json.readInt(id);
+                            return json.skipValue();
+                          }) && json.finish());
+                if (!ok) {
+                  sendParseError(res, json);
+                  return;
                 }
 
                 bool success = false;
@@ -260,189 +635,277 @@ void WebServer::serverLoop() {
                     }
                 }
 
-                std::string response = "{\"success\":" + std::string(success ? "true" : "false") + "}";
-                res.set_content(response, "application/json");
-                res.set_header("Access-Control-Allow-Origin", "*");
+                if (success)
+                  markWorldChanged();
+                sendJSON(res, "{\"success\":" + std::string(success ? "true" : "false") + "}");
               });
 
   // API: Establecer objetivo específico para un robot
   server.Post("/api/robot/goal",
               [this](const httplib::Request &req, httplib::Response &res) {
-                std::string body = req.body;
-                int id = -1, x = -1, y = -1;
-                
-                size_t idPos = body.find("\"id\":");
-                size_t xPos = body.find("\"x\":");
-                size_t yPos = body.find("\"y\":");
-
-                if (idPos != std::string::npos && xPos != std::string::npos && yPos != std::string::npos) {
-                  id = std::stoi(body.substr(idPos + 5, body.find(",", idPos) - idPos - 5));
-                  x = std::stoi(body.substr(xPos + 4, body.find(",", xPos) - xPos - 4));
-                  y = std::stoi(body.substr(yPos + 4, body.find("}", yPos) - yPos - 4));
+                // {"id":1,"x":10,"y":20}
+                auto &env = kernel_.getEnvironment();
+                JsonReader json(req.body);
+                int id = -1;
+                Point goal;
+                bool hasId = false, hasX = false, hasY = false;
+                bool ok = json.readObject([&](std::string_view key) {
+                  if (key == "id") {
+                    hasId = true;
+                    return json.readInt(id);
+                  }
+                  if (key == "x") {
+                    hasX = true;
+                    return json.readInt(goal.x);
+                  }
+                  if (key == "y") {
+                    hasY = true;
+                    return json.readInt(goal.y);
+                  }
+                  return json.skipValue();
+                });
+                if (ok && !(hasId && hasX && hasY))
+                  ok = json.fail("faltan los campos id/x/y");
+                if (ok && !isInside(env, goal))
+                  ok = json.fail("celda fuera del mapa");
+                if (!ok || !json.finish()) {
+                  sendParseError(res, json);
+                  return;
                 }
 
-                bool success = false;
-                if (id > 0 && x >= 0 && y >= 0) {
-                     success = kernel_.getRobotManager().setRobotGoal(id, Point(x, y));
+                bool success = kernel_.getRobotManager().setRobotGoal(id, goal);
+                if (success)
+                  markWorldChanged();
+                sendJSON(res, "{\"success\":" + std::string(success ? "true" : "false") + "}");
+              });
+
+  // API: Crear tarea: {"waypoints":[{"x":1,"y":2},...],"priority":0-3}
+  server.Post("/api/task",
+              [this](const httplib::Request &req, httplib::Response &res) {
+                JsonReader json(req.body);
+                TaskRequest task;
+                if (!readTask(json, kernel_.getEnvironment(), task) ||
+                    !json.finish()) {
+                  sendParseError(res, json);
+                  return;
+                }
+
+                int id = kernel_.getTaskManager().createTask(
+                    task.waypoints, task.priority, task.deadlineMs);
+                markWorldChanged();
+                sendJSON(res, "{\"success\":true,\"id\":" + std::to_string(id) + "}");
+              });
+
+  // API: Crear varias tareas: [{"waypoints":[...],"priority":N},...]
+  server.Post("/api/tasks",
+              [this](const httplib::Request &req, httplib::Response &res) {
+                auto &env = kernel_.getEnvironment();
+                JsonReader json(req.body);
+                // Se valida el lote completo antes de encolar nada
+                std::vector<TaskRequest> tasks;
+                bool ok = json.readArray([&](size_t index) {
+                  if (index >= MAX_BATCH)
+                    return json.fail("lote demasiado grande");
+                  tasks.emplace_back();
+                  return readTask(json, env, tasks.back());
+                });
+                if (!ok || !json.finish()) {
+                  sendParseError(res, json);
+                  return;
+                }
+
+                std::string response = "{\"success\":true,\"ids\":[";
+                for (size_t i = 0; i < tasks.size(); ++i) {
+                  int id = kernel_.getTaskManager().createTask(
+                      tasks[i].waypoints, tasks[i].priority,
+                      tasks[i].deadlineMs);
+                  if (i > 0)
+                    response += ",";
+                  response += std::to_string(id);
+                }
+                response += "]}";
+                if (!tasks.empty())
+                  markWorldChanged();
+                sendJSON(res, response);
+              });
+
+  // API: Cancelar una tarea pendiente o en curso: {"id":N}
+  server.Post("/api/task/cancel",
+              [this](const httplib::Request &req, httplib::Response &res) {
+                JsonReader json(req.body);
+                int id = -1;
+                bool ok = json.readObject([&](std::string_view key) {
+                  if (key == "id")
+                    return json.readInt(id);
+                  return json.skipValue();
+                });
+                if (ok && id <= 0)
+                  ok = json.fail("falta el campo id");
+                if (!ok || !json.finish()) {
+                  sendParseError(res, json);
+                  return;
+                }
+
+                bool success = kernel_.getTaskManager().cancelTask(id);
+                if (success)
+                  markWorldChanged();
+                sendJSON(res, "{\"success\":" + std::string(success ? "true" : "false") + "}");
+              });
+
+  // API: Cambiar la prioridad de una tarea pendiente: {"id":N,"priority":0-3}
+  server.Post("/api/task/priority",
+              [this](const httplib::Request &req, httplib::Response &res) {
+                JsonReader json(req.body);
+                int id = -1;
+                int priority = -1;
+                bool ok = json.readObject([&](std::string_view key) {
+                  if (key == "id")
+                    return json.readInt(id);
+                  if (key == "priority")
+                    return json.readInt(priority);
+                  return json.skipValue();
+                });
+                if (ok && id <= 0)
+                  ok = json.fail("falta el campo id");
+                if (ok && (priority < 0 || priority > 3))
+                  ok = json.fail("prioridad fuera de rango (0-3)");
+                if (!ok || !json.finish()) {
+                  sendParseError(res, json);
+                  return;
                 }
 
-                std::string response = "{\"success\":" + std::string(success ? "true" : "false") + "}";
-                res.set_content(response, "application/json");
-                res.set_header("Access-Control-Allow-Origin", "*");
+                bool success = kernel_.getTaskManager().setTaskPriority(
+                    id, static_cast<TaskPriority>(priority));
+                if (success)
+                  markWorldChanged();
+                sendJSON(res, "{\"success\":" + std::string(success ? "true" : "false") + "}");
               });
 
+  // API: Últimas tareas terminadas, de la más nueva a la más antigua:
+  // /api/tasks/history?limit=N (por defecto 100)
+  server.Get("/api/tasks/history",
+             [this](const httplib::Request &req, httplib::Response &res) {
+               size_t limit = 100;
+               if (req.has_param("limit")) {
+                 std::string value = req.get_param_value("limit");
+                 auto result = std::from_chars(
+                     value.data(), value.data() + value.size(), limit);
+                 if (result.ec != std::errc() ||
+                     result.ptr != value.data() + value.size()) {
+                   res.status = 400;
+                   sendJSON(res, "{\"success\":false,\"error\":\"limit inválido\"}");
+                   return;
+                 }
+               }
+
+               auto records = kernel_.getTaskManager().getRecentHistory(limit);
+               std::string response;
+               {
+                 JsonWriter json(response);
+                 json.beginArray();
+                 for (const TaskRecord &record : records)
+                   writeTaskRecord(json, record);
+                 json.endArray();
+               }
+               sendJSON(res, response);
+             });
+
   // API: Obtener estadísticas del sistema
   server.Get("/api/stats",
-             [this](const httplib::Request &, httplib::Response &res) {
-               res.set_content(getStatsJSON(), "application/json");
+             [this](const httplib::Request &req, httplib::Response &res) {
+               auto snapshot = kernel_.getSnapshot();
+               // El uptime cambia cada segundo aunque el mundo esté quieto
+               std::string etag = snapshotETag('s', snapshot->getVersion());
+               etag.insert(etag.size() - 1,
+                           "-" + std::to_string(snapshot->getStats().uptimeSeconds));
+               if (notModified(req, res, etag))
+                 return;
+               const std::string &body = snapshot->statsJSON();
+               sendShared(res, std::move(snapshot), body, "application/json");
+             });
+
+  // API: Métricas de instrumentación (p50/p99/max por fase)
+  server.Get("/api/metrics",
+             [](const httplib::Request &, httplib::Response &res) {
+               res.set_content(Metrics::instance().toJSON(),
+                               "application/json");
+               res.set_header("Access-Control-Allow-Origin", "*");
+             });
+
+  // API: Traza en formato Chrome/Perfetto (chrome://tracing)
+  server.Get("/api/trace",
+             [](const httplib::Request &, httplib::Response &res) {
+               res.set_content(Tracer::instance().toChromeJSON(),
+                               "application/json");
+               res.set_header("Content-Disposition",
+                              "attachment; filename=\"osbot_trace.json\"");
                res.set_header("Access-Control-Allow-Origin", "*");
              });
 
+  // API: Activar/desactivar trazas
+  server.Post("/api/trace",
+              [](const httplib::Request &req, httplib::Response &res) {
+                // {"enabled":true} o simplemente true
+                JsonReader json(req.body);
+                bool enabled = false;
+                if (!readFlag(json, "enabled", enabled) || !json.finish()) {
+                  sendParseError(res, json);
+                  return;
+                }
+                Tracer::setEnabled(enabled);
+                sendJSON(res, "{\"success\":true}");
+              });
+
+  // Archivos estáticos (web/): desde memoria, con gzip si el cliente lo
+  // acepta y 304 por ETag. Solo nombres planos: nada fuera de web/
+  server.Get(R"(/([A-Za-z0-9_.-]*))",
+             [this](const httplib::Request &req, httplib::Response &res) {
+               std::string name = req.matches[1];
+               if (name.empty())
+                 name = "index.html";
+               auto asset = assets_.find(name);
+               if (!asset) {
+                 res.status = 404;
+                 res.set_content("<!DOCTYPE html><html><body><h1>404 - File "
+                                 "Not Found</h1><p>File: " +
+                                     name + "</p></body></html>",
+                                 "text/html");
+                 return;
+               }
+
+               bool gzip = !asset->gzipBody.empty() &&
+                           Gzip::isAccepted(
+                               req.get_header_value("Accept-Encoding"));
+               res.set_header("Vary", "Accept-Encoding");
+               if (notModified(req, res, gzip ? asset->gzipETag : asset->etag))
+                 return;
+               if (gzip)
+                 res.set_header("Content-Encoding", "gzip");
+               const std::string &body = gzip ? asset->gzipBody : asset->body;
+               sendShared(res, asset, body, asset->contentType);
+             });
+
   std::cout << "[WebServer] Escuchando en puerto " << port_ << "..."
             << std::endl;
   server.listen("0.0.0.0", port_);
 }
 
 std::string WebServer::getStateJSON() {
-  auto &env = kernel_.getEnvironment();
-  auto &robotMgr = kernel_.getRobotManager();
-
-  int width = env.getWidth();
-  int height = env.getHeight();
-  Point goal = env.getGoal();
-
-  std::ostringstream json;
-  json << "{";
-  json << "\"grid\":{";
-  json << "\"width\":" << width << ",";
-  json << "\"height\":" << height << ",";
-  json << "\"cells\":[";
-
-  // *** FIX DEFINITIVO: Usar getGridSnapshot() - UN SOLO LOCK ***
-  auto gridSnapshot = env.getGridSnapshot();
-  
-  for (size_t y = 0; y < gridSnapshot.size(); y++) {
-    json << "[";
-    for (size_t x = 0; x < gridSnapshot[y].size(); x++) {
-      json << gridSnapshot[y][x];
-      if (x < gridSnapshot[y].size() - 1)
-        json << ",";
-    }
-    json << "]";
-    if (y < gridSnapshot.size() - 1)
-      json << ",";
-  }
-
-  json << "]},";
-
-  // Robots
-  json << "\"robots\":[";
-  auto robots = robotMgr.getAllRobots();
-  for (size_t i = 0; i < robots.size(); i++) {
-    if (robots[i] && robots[i]->robot) {
-      auto info = robots[i]; // Use a more convenient name
-      json << "{";
-      json << "\"id\":" << info->id << ",";
-      json << "\"x\":" << info->robot->getPosition().x << ",";
-      json << "\"y\":" << info->robot->getPosition().y << ",";
-      json << "\"state\":\"" << static_cast<int>(info->currentState) << "\",";
-      json << "\"obstaclesAvoided\":" << info->obstaclesAvoided << ",";
-      json << "\"active\":" << (info->isActive ? "true" : "false") << ",";
-      // Incluir info del objetivo
-      json << "\"goalX\":" << info->currentGoal.x << ",";
-      json << "\"goalY\":" << info->currentGoal.y << ",";
-      json << "\"hasPersonalGoal\":" << (info->hasPersonalGoal ? "true" : "false");
-      json << "}";
-      if (i < robots.size() - 1)
-        json << ",";
-    }
-  }
-  json << "],";
-
-  // Goal
-  json << "\"goal\":{\"x\":" << goal.x << ",\"y\":" << goal.y << "},";
-
-  // Estado de pausa y velocidad
-  json << "\"paused\":" << (kernel_.isPaused() ? "true" : "false") << ",";
-  json << "\"speed\":" << kernel_.getSimulationSpeed();
-
-  json << "}";
-  return json.str();
+  return kernel_.getSnapshot()->stateJSON();
 }
 
-std::string WebServer::getStatsJSON() {
-  auto &robotMgr = kernel_.getRobotManager();
-  
-  // Obtener todos los robots
-  auto robots = robotMgr.getAllRobots();
-  
-  // Calcular métricas
-  int totalRobots = robots.size();
-  int activeRobots = 0;
-  int idleRobots = 0;
-  double totalDistance = 0.0;
-  int completedTasks = 0;
-  int failedTasks = 0;
-  int totalCellsTraveled = 0;
-  
-  for (const auto* robotInfo : robots) {
-    if (robotInfo && robotInfo->robot) {
-      // Contar robots por estado
-      State state = robotInfo->robot->getState();
-      if (state == State::NAVIGATING) {
-        activeRobots++;
-      } else if (state == State::IDLE || state == State::REACHED_GOAL) {
-        idleRobots++;
-      }
-      
-      // Acumular estadísticas
-      totalDistance += robotInfo->totalDistanceTraveled;
-      completedTasks += robotInfo->tasksCompleted;
-      failedTasks += robotInfo->tasksFailed;
-      totalCellsTraveled += robotInfo->cellsTraveled;
-    }
-  }
-  
-  // Calcular eficiencia
-  int totalTasks = completedTasks + failedTasks;
-  double efficiency = (totalTasks > 0) ? 
-    (static_cast<double>(completedTasks) / totalTasks * 100.0) : 0.0;
-  
-  // Uptime (simulado - podría ser tiempo desde el inicio)
-  static auto startTime = std::chrono::steady_clock::now();
-  auto now = std::chrono::steady_clock::now();
-  auto uptime = std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count();
-  
-  // Construir JSON
-  std::ostringstream json;
-  json << "{";
-  json << "\"totalTasks\":" << totalTasks << ",";
-  json << "\"completedTasks\":" << completedTasks << ",";
-  json << "\"failedTasks\":" << failedTasks << ",";
-  json << "\"cellsTraveled\":" << totalCellsTraveled << ",";
-  json << "\"totalDistance\":" << std::fixed << std::setprecision(2) << totalDistance << ",";
-  json << "\"robotsActive\":" << activeRobots << ",";
-  json << "\"robotsIdle\":" << idleRobots << ",";
-  json << "\"totalRobots\":" << totalRobots << ",";
-  json << "\"efficiency\":" << std::fixed << std::setprecision(1) << efficiency << ",";
-  json << "\"uptime\":" << uptime;
-  json << "}";
-  
-  return json.str();
+void WebServer::writeStateJSON(std::string &out) {
+  kernel_.getSnapshot()->writeStateJSON(out);
 }
 
-std::string WebServer::serveStaticFile(const std::string &filename) {
-  std::string path = "web/" + filename;
-  std::ifstream file(path);
-
-  if (!file.is_open()) {
-    return "<!DOCTYPE html><html><body><h1>404 - File Not Found</h1><p>File: "
-           + filename + "</p></body></html>";
-  }
+void WebServer::writeStateFrame(std::string &out, uint64_t sinceEpoch,
+                                uint64_t sinceVersion) {
+  kernel_.getSnapshot()->writeFrame(out, sinceEpoch, sinceVersion,
+                                    &kernel_.getGridHistory());
+}
 
-  std::ostringstream content;
-  content << file.rdbuf();
-  return content.str();
+std::string WebServer::getStatsJSON() {
+  return kernel_.getSnapshot()->statsJSON();
 }
 
 } // namespace OSBot
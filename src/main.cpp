@@ -1,11 +1,16 @@
 #include "application/Kernel.h"
+#include "application/ScenarioRunner.h"
 #include "domain/Robot.h"
+#include "infrastructure/StaticAssetCache.h"
+#include "infrastructure/Tracer.h"
 #include <csignal>
 #include <iostream>
 #include <memory>
 #include <atomic> // Added for std::atomic
 #include <thread> // Added for std::thread
 #include <chrono> // Added for std::chrono
+#include <cstdlib>
+#include <string>
 
 // Global para manejo// Kernel global
 std::unique_ptr<OSBot::Kernel> g_kernel;
@@ -30,6 +35,16 @@ void signalHandler(int signal) {
   exit(0);
 }
 
+/**
+ * @brief SIGUSR1: solicitar volcado de traza (lo atiende el Kernel)
+ */
+void traceDumpHandler(int) { OSBot::Tracer::requestDump(); }
+
+/**
+ * @brief SIGHUP: recargar los archivos de web/ (lo atiende el Kernel)
+ */
+void assetReloadHandler(int) { OSBot::StaticAssetCache::requestReload(); }
+
 bool getGoalCoordinates(int &x, int &y, int maxX, int maxY) {
   std::cout << "\n╔══════════════════════════════════════════════════╗\n";
   std::cout << "║      Ingrese las coordenadas del objetivo       ║\n";
@@ -61,10 +76,178 @@ bool getGoalCoordinates(int &x, int &y, int maxX, int maxY) {
   return true;
 }
 
-int main() {
+void printUsage(const char *program) {
+  std::cout << "Uso: " << program << " [opciones]\n\n"
+            << "  --headless        Simulación sin web ni render, tiempo virtual\n"
+            << "  --seed N          Semilla maestra (resultados reproducibles)\n"
+            << "  --ticks N         Ticks a simular en modo headless\n"
+            << "  --tick-ms N       Paso del reloj virtual en ms\n"
+            << "  --robots N        Robots a crear en modo headless\n"
+            << "  --width N         Ancho del grid\n"
+            << "  --height N        Alto del grid\n"
+            << "  --no-profiling    Desactivar histogramas de latencia\n"
+            << "  --trace           Registrar trazas (volcado con SIGUSR1)\n"
+            << "  --gzip-level N    Compresión de /api/state, 1-9 (0 = no)\n"
+            << "  --assignment M    Asignación de tareas: greedy o batch\n"
+            << "  --scheduling P    Orden de la cola: priority, edf, aging o fair\n"
+            << "  --optimize-routes Reordenar los waypoints de cada tarea\n"
+            << "  --route-fix-last  Al reordenar, el último waypoint no se mueve\n"
+            << "\n  Escenarios (implican --headless):\n"
+            << "  --map FILE        Cargar mapa, robots y tareas de un .osbot\n"
+            << "  --scenario FILE   Reproducir un flujo de eventos grabado\n"
+            << "  --replay-speed X  Acelerar el flujo grabado (2 = doble)\n"
+            << "  --task-rate R     Tareas sintéticas por tick (p. ej. 0.5)\n"
+            << "  --obstacle-rate R Ediciones de obstáculos por tick\n"
+            << "  --help            Mostrar esta ayuda\n";
+}
+
+/**
+ * @brief Procesa los argumentos de línea de comandos
+ * @return false si hay un argumento inválido o se pidió ayuda
+ */
+bool parseArguments(int argc, char *argv[], OSBot::SimulationConfig &config,
+                    int &robots, OSBot::ScenarioConfig &scenario) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+
+    if (arg == "--headless") {
+      config.headless = true;
+    } else if (arg == "--seed" && hasValue) {
+      config.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--ticks" && hasValue) {
+      config.maxTicks = std::strtoull(argv[++i], nullptr, 10);
+    } else if (arg == "--tick-ms" && hasValue) {
+      config.tickMs = std::atoi(argv[++i]);
+    } else if (arg == "--robots" && hasValue) {
+      robots = std::atoi(argv[++i]);
+    } else if (arg == "--width" && hasValue) {
+      config.gridWidth = std::atoi(argv[++i]);
+    } else if (arg == "--height" && hasValue) {
+      config.gridHeight = std::atoi(argv[++i]);
+    } else if (arg == "--no-profiling") {
+      config.profiling = false;
+    } else if (arg == "--trace") {
+      config.tracing = true;
+    } else if (arg == "--gzip-level" && hasValue) {
+      config.gzipLevel = std::atoi(argv[++i]);
+    } else if (arg == "--assignment" && hasValue) {
+      std::string mode = argv[++i];
+      if (mode == "greedy") {
+        config.assignment = OSBot::AssignmentMode::GREEDY;
+      } else if (mode == "batch") {
+        config.assignment = OSBot::AssignmentMode::BATCH;
+      } else {
+        std::cerr << "Modo de asignación desconocido: " << mode << "\n";
+        return false;
+      }
+    } else if (arg == "--optimize-routes") {
+      config.optimizeRoutes = true;
+    } else if (arg == "--route-fix-last") {
+      config.routeFixLast = true;
+    } else if (arg == "--scheduling" && hasValue) {
+      std::string policy = argv[++i];
+      if (policy == "priority") {
+        config.scheduling = OSBot::SchedulingPolicy::PRIORITY;
+      } else if (policy == "edf") {
+        config.scheduling = OSBot::SchedulingPolicy::DEADLINE;
+      } else if (policy == "aging") {
+        config.scheduling = OSBot::SchedulingPolicy::AGING;
+      } else if (policy == "fair") {
+        config.scheduling = OSBot::SchedulingPolicy::FAIR;
+      } else {
+        std::cerr << "Política de planificación desconocida: " << policy << "\n";
+        return false;
+      }
+    } else if (arg == "--map" && hasValue) {
+      scenario.mapFile = argv[++i];
+    } else if (arg == "--scenario" && hasValue) {
+      scenario.eventsFile = argv[++i];
+    } else if (arg == "--replay-speed" && hasValue) {
+      scenario.replaySpeed = std::atof(argv[++i]);
+    } else if (arg == "--task-rate" && hasValue) {
+      scenario.taskRate = std::atof(argv[++i]);
+    } else if (arg == "--obstacle-rate" && hasValue) {
+      scenario.obstacleRate = std::atof(argv[++i]);
+    } else {
+      printUsage(argv[0]);
+      return false;
+    }
+  }
+
+  if (config.tickMs <= 0 || config.gridWidth < 10 || config.gridHeight < 10 ||
+      config.gzipLevel < 0 || config.gzipLevel > 9 || robots < 0 || scenario.replaySpeed <= 0.0 || scenario.taskRate < 0.0 ||
+      scenario.obstacleRate < 0.0) {
+    std::cerr << "Argumentos fuera de rango\n";
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Modo headless: simulación fast-forward determinista
+ */
+int runHeadless(const OSBot::SimulationConfig &config, int robots) {
+  OSBot::Kernel kernel(config);
+
+  if (!kernel.initialize()) {
+    std::cerr << "Error al inicializar el kernel\n";
+    return 1;
+  }
+
+  kernel.spawnRobots(robots);
+  kernel.start();
+  kernel.run(0);
+  kernel.shutdown();
+  return 0;
+}
+
+/**
+ * @brief Modo escenario: mapa + flujo de carga en fast-forward
+ */
+int runScenario(OSBot::ScenarioConfig scenario) {
+  OSBot::ScenarioRunner runner(scenario);
+  OSBot::ScenarioReport report;
+
+  if (!runner.run(report)) {
+    std::cerr << "Error al ejecutar el escenario\n";
+    return 1;
+  }
+
+  OSBot::ScenarioRunner::printReport(report, std::cout);
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  OSBot::SimulationConfig config;
+  OSBot::ScenarioConfig scenario;
+  int headlessRobots = 1;
+  if (!parseArguments(argc, argv, config, headlessRobots, scenario)) {
+    return 1;
+  }
+
+  signal(SIGUSR1, traceDumpHandler);
+
+  if (scenario.isEnabled()) {
+    if (config.maxTicks == 0) {
+      config.maxTicks = 1000;
+    }
+    scenario.simulation = config;
+    scenario.robots = headlessRobots;
+    return runScenario(scenario);
+  }
+
+  if (config.headless) {
+    if (config.maxTicks == 0) {
+      config.maxTicks = 1000;
+    }
+    return runHeadless(config, headlessRobots);
+  }
+
   // Configurar señales para shutdown limpio
   signal(SIGINT, signalHandler);
   signal(SIGTERM, signalHandler);
+  signal(SIGHUP, assetReloadHandler);
 
   std::cout << "╔══════════════════════════════════════════════════╗\n";
   std::cout << "║         OS-BOT - Simulación de Navegación       ║\n";
@@ -72,7 +255,7 @@ int main() {
   std::cout << "╚══════════════════════════════════════════════════╝\n";
 
   // Inicializar kernel
-  g_kernel = std::make_unique<OSBot::Kernel>();
+  g_kernel = std::make_unique<OSBot::Kernel>(config);
 
   if (!g_kernel->initialize()) {
     std::cerr << "Error al inicializar el kernel\n";
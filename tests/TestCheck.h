@@ -0,0 +1,24 @@
+#ifndef OSBOT_TEST_CHECK_H
+#define OSBOT_TEST_CHECK_H
+
+#include <iostream>
+
+// Arnés mínimo compartido por los binarios de test: cada check() imprime
+// [PASS]/[FAIL] y main() devuelve testExitCode()
+
+inline int failures = 0;
+
+inline void check(bool condition, const char *name) {
+    if (condition) {
+        std::cout << "[PASS] " << name << "\n";
+    } else {
+        std::cerr << "[FAIL] " << name << "\n";
+        failures++;
+    }
+}
+
+inline int testExitCode() {
+    return failures == 0 ? 0 : 1;
+}
+
+#endif // OSBOT_TEST_CHECK_H
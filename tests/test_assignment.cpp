@@ -0,0 +1,130 @@
+#include "application/AssignmentSolver.h"
+#include "domain/Random.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+using OSBot::AssignmentResult;
+using OSBot::AssignmentSolver;
+
+static std::vector<double> randomCosts(OSBot::Xoshiro256 &rng, size_t rows, size_t cols) {
+    std::vector<double> cost(rows * cols);
+    for (double &c : cost) {
+        c = rng.uniformInt(0, 100);
+    }
+    return cost;
+}
+
+// Óptimo por fuerza bruta: permutaciones de las columnas (rows <= cols)
+static double bruteForce(const std::vector<double> &cost, size_t rows, size_t cols) {
+    std::vector<size_t> perm(cols);
+    std::iota(perm.begin(), perm.end(), 0);
+    double best = std::numeric_limits<double>::max();
+    do {
+        double total = 0.0;
+        for (size_t r = 0; r < rows; ++r) {
+            total += cost[r * cols + perm[r]];
+        }
+        best = std::min(best, total);
+    } while (std::next_permutation(perm.begin(), perm.end()));
+    return best;
+}
+
+// Cada fila con columna distinta y min(rows, cols) pares asignados
+static bool isValid(const AssignmentResult &result, size_t rows, size_t cols) {
+    if (result.rowToCol.size() != rows) return false;
+    std::vector<bool> used(cols, false);
+    size_t pairs = 0;
+    for (int c : result.rowToCol) {
+        if (c < 0) continue;
+        if (static_cast<size_t>(c) >= cols || used[c]) return false;
+        used[c] = true;
+        pairs++;
+    }
+    return pairs == std::min(rows, cols);
+}
+
+void test_hungarian() {
+    std::cout << "Running Hungarian tests...\n";
+    OSBot::Xoshiro256 rng(7);
+
+    bool allOptimal = true;
+    for (int round = 0; round < 50; ++round) {
+        size_t n = static_cast<size_t>(rng.uniformInt(1, 6));
+        auto cost = randomCosts(rng, n, n);
+        auto result = AssignmentSolver::solveHungarian(cost, n, n);
+        allOptimal = allOptimal && isValid(result, n, n) &&
+                     result.totalCost == bruteForce(cost, n, n);
+    }
+    check(allOptimal, "Square matrices match brute force");
+
+    // Más tareas que robots y al revés (se resuelve la transpuesta)
+    bool rectangular = true;
+    for (int round = 0; round < 30; ++round) {
+        size_t rows = static_cast<size_t>(rng.uniformInt(1, 4));
+        size_t cols = rows + static_cast<size_t>(rng.uniformInt(1, 3));
+        auto cost = randomCosts(rng, rows, cols);
+        auto wide = AssignmentSolver::solveHungarian(cost, rows, cols);
+
+        std::vector<double> transposed(cost.size());
+        for (size_t r = 0; r < rows; ++r)
+            for (size_t c = 0; c < cols; ++c)
+                transposed[c * rows + r] = cost[r * cols + c];
+        auto tall = AssignmentSolver::solveHungarian(transposed, cols, rows);
+
+        double optimum = bruteForce(cost, rows, cols);
+        rectangular = rectangular && isValid(wide, rows, cols) &&
+                      isValid(tall, cols, rows) && wide.totalCost == optimum &&
+                      tall.totalCost == optimum;
+    }
+    check(rectangular, "Rectangular matrices in both orientations");
+
+    auto empty = AssignmentSolver::solve({}, 0, 5);
+    check(empty.rowToCol.empty() && empty.totalCost == 0.0, "Empty problem");
+
+    // Greedy asignaría la fila 0 a la columna 0 (costo 1 + 100)
+    std::vector<double> trap = {1, 2,
+                                2, 100};
+    auto result = AssignmentSolver::solve(trap, 2, 2);
+    check(result.totalCost == 4.0 && result.rowToCol[0] == 1, "Beats greedy on a trap matrix");
+}
+
+void test_auction() {
+    std::cout << "Running auction tests...\n";
+    OSBot::Xoshiro256 rng(11);
+
+    // Costos enteros: la subasta con epsilon < 1/n es exacta
+    bool matches = true;
+    for (int round = 0; round < 20; ++round) {
+        size_t rows = static_cast<size_t>(rng.uniformInt(1, 40));
+        size_t cols = static_cast<size_t>(rng.uniformInt(1, 40));
+        auto cost = randomCosts(rng, rows, cols);
+        auto auction = AssignmentSolver::solveAuction(cost, rows, cols);
+        auto hungarian = AssignmentSolver::solveHungarian(cost, rows, cols);
+        matches = matches && isValid(auction, rows, cols) &&
+                  auction.totalCost == hungarian.totalCost;
+    }
+    check(matches, "Auction matches Hungarian on integer costs");
+
+    size_t rows = AssignmentSolver::HUNGARIAN_MAX_SIZE + 72;
+    size_t cols = rows + 10;
+    auto cost = randomCosts(rng, rows, cols);
+    auto large = AssignmentSolver::solve(cost, rows, cols);
+    auto exact = AssignmentSolver::solveHungarian(cost, rows, cols);
+    check(large.method == AssignmentResult::Method::AUCTION && isValid(large, rows, cols) &&
+          large.totalCost == exact.totalCost, "Large problems use the auction and stay optimal");
+
+    // Muy rectangular: el relleno de la subasta no compensa
+    auto wide = AssignmentSolver::solve(randomCosts(rng, rows, 3 * rows), rows, 3 * rows);
+    check(wide.method == AssignmentResult::Method::HUNGARIAN && isValid(wide, rows, 3 * rows),
+          "Wide problems stay on the Hungarian method");
+}
+
+int main() {
+    test_hungarian();
+    test_auction();
+    return testExitCode();
+}
@@ -0,0 +1,30 @@
+#include "domain/Environment.h"
+#include "TestCheck.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+void test_random_obstacles() {
+    std::cout << "Running random obstacles tests...\n";
+
+    // Interior de 4x4: robot y objetivo nunca se cubren, así que el 100%
+    // no cabe y debe rechazarse sin tocar el mapa (antes no terminaba)
+    OSBot::Environment env(6, 6);
+    std::vector<uint8_t> before, after;
+    env.copyObstacleMask(before);
+    bool rejected = !env.generateRandomObstacles(100);
+    env.copyObstacleMask(after);
+    check(rejected && before == after, "Unsatisfiable percentage rejected");
+
+    bool placed = env.generateRandomObstacles(50);
+    env.copyObstacleMask(after);
+    int inner = 0;
+    for (int y = 1; y < 5; ++y)
+        for (int x = 1; x < 5; ++x) inner += after[y * 6 + x];
+    check(placed && inner == 8, "Random obstacles fill the requested share");
+}
+
+int main() {
+    test_random_obstacles();
+    return testExitCode();
+}
@@ -0,0 +1,42 @@
+#include "infrastructure/GridCodec.h"
+#include "TestCheck.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void test_grid_codec() {
+    std::cout << "Running GridCodec tests...\n";
+
+    // Tamaño impar: el último byte lleva bits de relleno
+    const int width = 13, height = 7;
+    std::vector<uint8_t> mask(width * height, 0);
+    for (size_t i = 0; i < mask.size(); i += 3) mask[i] = 1;
+
+    std::string packed;
+    OSBot::GridCodec::pack(mask, width, height, packed);
+    std::vector<uint8_t> decoded;
+    bool ok = packed.size() == OSBot::GridCodec::packedSize(width, height) &&
+              OSBot::GridCodec::unpack(reinterpret_cast<const uint8_t *>(packed.data()),
+                                       packed.size(), width, height, decoded) &&
+              decoded == mask;
+    check(ok, "Bitmap round trip");
+
+    // Delta: alternar celdas sobre la máscara base reproduce la nueva
+    std::vector<uint8_t> changed = mask;
+    changed[0] ^= 1;
+    changed[50] ^= 1;
+    changed[width * height - 1] ^= 1;
+    std::string changedPacked, delta;
+    OSBot::GridCodec::pack(changed, width, height, changedPacked);
+    uint32_t count = OSBot::GridCodec::appendDelta(packed, changedPacked, delta);
+    std::vector<uint8_t> patched = mask;
+    size_t used = OSBot::GridCodec::applyDelta(
+        reinterpret_cast<const uint8_t *>(delta.data()), delta.size(), patched);
+    check(count == 3 && used == delta.size() && patched == changed, "Grid delta");
+}
+
+int main() {
+    test_grid_codec();
+    return testExitCode();
+}
@@ -0,0 +1,76 @@
+#include "application/IdleRobotIndex.h"
+#include "domain/Random.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using OSBot::AvailableRobot;
+using OSBot::IdleRobotIndex;
+using OSBot::Point;
+
+static std::vector<int> idsOf(const std::vector<AvailableRobot> &robots) {
+    std::vector<int> ids;
+    for (const auto &robot : robots) ids.push_back(robot.id);
+    return ids;
+}
+
+void test_idle_robot_index() {
+    std::cout << "Running IdleRobotIndex tests...\n";
+    OSBot::Xoshiro256 rng(3);
+
+    // Flota aleatoria con movimientos y cambios de disponibilidad
+    const int width = 100, height = 70, robots = 400;
+    IdleRobotIndex index(width, height);
+    std::vector<AvailableRobot> fleet(robots + 1);
+    std::vector<bool> available(robots + 1, false);
+    for (int round = 0; round < 3000; ++round) {
+        int id = rng.uniformInt(1, robots);
+        fleet[id] = {id, Point(rng.uniformInt(0, width - 1), rng.uniformInt(0, height - 1))};
+        available[id] = rng.uniformInt(0, 3) != 0;
+        index.update(id, fleet[id].position, available[id]);
+    }
+
+    std::vector<AvailableRobot> all;
+    for (int id = 1; id <= robots; ++id) {
+        if (available[id]) all.push_back(fleet[id]);
+    }
+    check(index.size() == all.size(), "Size tracks incremental updates");
+
+    // kNN y radio contra fuerza bruta (mismo orden: distancia, ID)
+    bool knnOk = true, radiusOk = true;
+    std::vector<AvailableRobot> result;
+    for (int query = 0; query < 200; ++query) {
+        Point target(rng.uniformInt(0, width - 1), rng.uniformInt(0, height - 1));
+        auto expected = all;
+        std::sort(expected.begin(), expected.end(), [&](const AvailableRobot &a, const AvailableRobot &b) {
+            int da = IdleRobotIndex::distance(a.position, target);
+            int db = IdleRobotIndex::distance(b.position, target);
+            return da != db ? da < db : a.id < b.id;
+        });
+
+        size_t k = static_cast<size_t>(rng.uniformInt(1, 20));
+        index.nearest(target, k, result);
+        std::vector<AvailableRobot> firstK(expected.begin(), expected.begin() + std::min(k, expected.size()));
+        knnOk = knnOk && idsOf(result) == idsOf(firstK);
+
+        int radius = rng.uniformInt(0, 25);
+        index.withinRadius(target, radius, result);
+        std::vector<AvailableRobot> inside;
+        for (const auto &robot : expected) {
+            if (IdleRobotIndex::distance(robot.position, target) <= radius) inside.push_back(robot);
+        }
+        radiusOk = radiusOk && idsOf(result) == idsOf(inside);
+    }
+    check(knnOk, "k-nearest matches brute force");
+    check(radiusOk, "Radius query matches brute force");
+
+    index.clear();
+    index.nearest(Point(5, 5), 3, result);
+    check(index.size() == 0 && result.empty(), "Clear empties the index");
+}
+
+int main() {
+    test_idle_robot_index();
+    return testExitCode();
+}
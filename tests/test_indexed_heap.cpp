@@ -0,0 +1,69 @@
+#include "infrastructure/IndexedDaryHeap.h"
+#include "domain/Random.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+void test_indexed_heap() {
+    std::cout << "Running IndexedDaryHeap tests...\n";
+    OSBot::Xoshiro256 rng(5);
+
+    // Mayor prioridad primero; a igualdad, menor clave (orden de llegada)
+    struct Item { int priority; int key; };
+    struct ItemBefore {
+        bool operator()(const Item &a, const Item &b) const {
+            return a.priority != b.priority ? a.priority > b.priority : a.key < b.key;
+        }
+    };
+    OSBot::IndexedDaryHeap<Item, ItemBefore> heap;
+    std::map<int, int> reference; // clave -> prioridad
+
+    // Inserciones, borrados y cambios de prioridad aleatorios contra un mapa
+    bool orderOk = true;
+    int nextKey = 1;
+    for (int round = 0; round < 5000; ++round) {
+        int op = rng.uniformInt(0, 3);
+        if (op <= 1 || reference.empty()) {
+            int priority = rng.uniformInt(0, 3);
+            heap.push(nextKey, {priority, nextKey});
+            reference[nextKey] = priority;
+            nextKey++;
+        } else {
+            auto it = reference.begin();
+            std::advance(it, rng.uniformInt(0, static_cast<int>(reference.size()) - 1));
+            if (op == 2) {
+                heap.erase(it->first);
+                reference.erase(it);
+            } else {
+                it->second = rng.uniformInt(0, 3);
+                heap.update(it->first, {it->second, it->first});
+            }
+        }
+
+        auto best = std::min_element(reference.begin(), reference.end(), [](const auto &a, const auto &b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        orderOk = orderOk && heap.size() == reference.size() &&
+                  (reference.empty() || heap.top().key == best->first);
+    }
+    check(orderOk, "Top matches reference after push/erase/update");
+
+    bool popOk = true;
+    int lastPriority = 4, lastKey = 0;
+    while (!heap.empty()) {
+        const Item &item = heap.top().value;
+        popOk = popOk && (item.priority < lastPriority || (item.priority == lastPriority && item.key > lastKey));
+        lastPriority = item.priority;
+        lastKey = item.key;
+        heap.pop();
+    }
+    check(popOk, "Pop order is priority then FIFO");
+    check(!heap.push(1, {0, 1}) || !heap.push(1, {3, 1}), "Duplicate key is rejected");
+    check(!heap.erase(999999) && !heap.update(999999, {0, 0}), "Unknown key is reported");
+}
+
+int main() {
+    test_indexed_heap();
+    return testExitCode();
+}
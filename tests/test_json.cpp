@@ -0,0 +1,117 @@
+#include "infrastructure/JsonReader.h"
+#include "TestCheck.h"
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+using OSBot::JsonReader;
+
+struct Cell {
+    int x = -1, y = -1;
+};
+
+static bool readCell(JsonReader &json, Cell &cell) {
+    return json.readObject([&](std::string_view key) {
+        if (key == "x") return json.readInt(cell.x);
+        if (key == "y") return json.readInt(cell.y);
+        return json.skipValue();
+    });
+}
+
+void test_objects() {
+    std::cout << "Running JsonReader object tests...\n";
+
+    // Espacios, orden de campos y campos desconocidos
+    {
+        JsonReader json(" { \"y\" : 20 ,\n\"extra\":{\"a\":[1,2,{\"b\":null}]}, \"x\":-7 } ");
+        Cell cell;
+        bool ok = readCell(json, cell) && json.finish();
+        check(ok && cell.x == -7 && cell.y == 20, "Object with whitespace, reordering and unknown fields");
+    }
+
+    // Booleanos y dobles
+    {
+        JsonReader json("{\"paused\":true,\"rate\":2.5e-1}");
+        bool paused = false;
+        double rate = 0.0;
+        bool ok = json.readObject([&](std::string_view key) {
+            if (key == "paused") return json.readBool(paused);
+            if (key == "rate") return json.readDouble(rate);
+            return json.skipValue();
+        }) && json.finish();
+        check(ok && paused && rate == 0.25, "Bool and double fields");
+    }
+
+    // Cadenas con escapes (vista cruda, sin decodificar)
+    {
+        JsonReader json("{\"name\":\"a\\\"b\\u00e9\"}");
+        std::string_view name;
+        bool ok = json.readObject([&](std::string_view key) {
+            if (key == "name") return json.readString(name);
+            return json.skipValue();
+        }) && json.finish();
+        check(ok && name == "a\\\"b\\u00e9", "String with escapes");
+    }
+}
+
+void test_arrays() {
+    std::cout << "Running JsonReader array tests...\n";
+
+    JsonReader json("[{\"x\":1,\"y\":2},{\"x\":3,\"y\":4}]");
+    std::vector<Cell> cells;
+    bool ok = json.readArray([&](size_t) {
+        cells.emplace_back();
+        return readCell(json, cells.back());
+    }) && json.finish();
+    check(ok && cells.size() == 2 && cells[1].x == 3 && cells[1].y == 4, "Array of objects");
+
+    JsonReader empty(" [ ] ");
+    size_t count = 0;
+    ok = empty.readArray([&](size_t) { count++; return empty.skipValue(); }) && empty.finish();
+    check(ok && count == 0, "Empty array");
+}
+
+void test_errors() {
+    std::cout << "Running JsonReader error tests...\n";
+
+    struct Case {
+        const char *body;
+        const char *name;
+    };
+    const Case cases[] = {
+        {"{\"x\":1,\"y\":}", "Missing value"},
+        {"{\"x\":1 \"y\":2}", "Missing comma"},
+        {"{\"x\":1.5,\"y\":2}", "Fraction where int expected"},
+        {"{\"x\":99999999999,\"y\":2}", "Int overflow"},
+        {"{\"x\":01,\"y\":2}", "Leading zero"},
+        {"{x:1,y:2}", "Unquoted key"},
+        {"{\"x\":1,\"y\":2", "Unterminated object"},
+        {"{\"x\":1,\"y\":2} garbage", "Trailing data"},
+        {"", "Empty body"},
+    };
+    for (const Case &c : cases) {
+        JsonReader json(c.body);
+        Cell cell;
+        bool ok = readCell(json, cell) && json.finish();
+        check(!ok && json.failed() && *json.error() != '\0', c.name);
+    }
+
+    // La posición apunta al valor problemático
+    JsonReader json("{\"x\":true}");
+    Cell cell;
+    readCell(json, cell);
+    check(json.failed() && json.errorOffset() == 5, "Error offset");
+
+    // Límite de anidamiento
+    std::string deep(100, '[');
+    deep += std::string(100, ']');
+    JsonReader nested(deep);
+    check(!nested.skipValue() && nested.failed(), "Nesting depth limit");
+}
+
+int main() {
+    test_objects();
+    test_arrays();
+    test_errors();
+    return testExitCode();
+}
@@ -0,0 +1,113 @@
+#include "infrastructure/Metrics.h"
+#include "TestCheck.h"
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using OSBot::LatencyHistogram;
+
+// Percentil 50 de 'value' junto a una muestra mayor: el límite superior
+// del bucket de 'value' (sin el recorte por el máximo)
+static uint64_t upperBoundOf(uint64_t value) {
+    LatencyHistogram histogram;
+    histogram.record(value);
+    histogram.record(UINT64_C(1) << 40);
+    return histogram.percentile(50.0);
+}
+
+void test_buckets() {
+    std::cout << "Running LatencyHistogram bucket tests...\n";
+
+    // Por debajo de 2^(SUB_BUCKET_BITS+1) los buckets son exactos
+    bool exact = true;
+    for (uint64_t v = 0; v < 2 * LatencyHistogram::SUB_BUCKETS; ++v)
+        exact = exact && upperBoundOf(v) == v;
+    check(exact, "Small values land in exact buckets");
+
+    // Primer grupo de ancho 2: 64 y 65 comparten bucket, 66 abre otro
+    check(upperBoundOf(64) == 65 && upperBoundOf(65) == 65 && upperBoundOf(66) == 67,
+          "Bucket boundaries at 2^6");
+    check(upperBoundOf(1023) == 1023 && upperBoundOf(1024) == 1055,
+          "Bucket boundaries at 2^10");
+
+    // Error relativo del límite superior <= 1/SUB_BUCKETS (~3%)
+    bool bounded = true;
+    for (uint64_t v = 100; v < (UINT64_C(1) << 39); v = v * 7 / 5 + 3) {
+        uint64_t bound = upperBoundOf(v);
+        bounded = bounded && bound >= v && bound - v <= v / LatencyHistogram::SUB_BUCKETS;
+    }
+    check(bounded, "Relative error within 1/SUB_BUCKETS");
+    check(LatencyHistogram::BUCKET_COUNT == 1184, "1184 buckets up to 2^40 ns");
+}
+
+void test_summary() {
+    std::cout << "Running LatencyHistogram summary tests...\n";
+
+    // 1..10000 us: p50 ~ 5000 us, p99 ~ 9900 us
+    LatencyHistogram histogram;
+    for (uint64_t us = 1; us <= 10000; ++us)
+        histogram.record(us * 1000);
+    OSBot::HistogramSummary s = histogram.summary();
+    check(s.count == 10000, "Count");
+    check(s.max == 10000000, "Max is exact");
+    check(s.mean == 5000500.0, "Mean is exact");
+    check(s.p50 >= 5000000 && s.p50 <= 5000000 + 5000000 / 32, "p50 within bucket error");
+    check(s.p99 >= 9900000 && s.p99 <= 9900000 + 9900000 / 32, "p99 within bucket error");
+    check(histogram.percentile(100.0) == s.max, "p100 clamps to max");
+
+    histogram.reset();
+    check(histogram.count() == 0 && histogram.percentile(99.0) == 0, "Reset empties the histogram");
+}
+
+void test_saturation() {
+    std::cout << "Running LatencyHistogram saturation tests...\n";
+
+    // Por encima de 2^(MAX_MAGNITUDE+1) ns (~36 min) todo cae en el último
+    // bucket: el percentil satura, el máximo y la media no
+    const uint64_t huge = UINT64_C(1) << 50;
+    LatencyHistogram histogram;
+    histogram.record(huge);
+    histogram.record(huge * 2);
+    OSBot::HistogramSummary s = histogram.summary();
+    uint64_t ceiling = (UINT64_C(1) << (LatencyHistogram::MAX_MAGNITUDE + 1)) - 1;
+    check(s.p50 == ceiling && s.p99 == ceiling, "Percentiles saturate at the last bucket");
+    check(s.max == huge * 2, "Max keeps the real value");
+    check(s.count == 2, "Saturated samples are counted");
+}
+
+void test_units() {
+    std::cout << "Running Metrics unit tests...\n";
+
+    auto& metrics = OSBot::Metrics::instance();
+    metrics.histogram("test.units_ms", OSBot::HistogramUnit::MILLISECONDS).record(56300);
+    metrics.histogram("test.units_ns").record(2000);
+    // Pedirlo de nuevo sin unidad no cambia la de creación
+    check(metrics.histogram("test.units_ms").unit() == OSBot::HistogramUnit::MILLISECONDS,
+          "Unit is fixed at creation");
+
+    std::string json = metrics.toJSON();
+    check(json.find("\"test.units_ms\":{\"count\":1,\"p50_ms\":") != std::string::npos &&
+          json.find("\"max_ms\":56300") != std::string::npos,
+          "Millisecond histograms export *_ms keys");
+    check(json.find("\"test.units_ns\":{\"count\":1,\"p50_ns\":") != std::string::npos,
+          "Nanosecond histograms keep *_ns keys");
+
+    std::ostringstream report;
+    metrics.printReport(report);
+    std::string text = report.str();
+    size_t msTable = text.find("max(ms)");
+    size_t msRow = text.find("test.units_ms");
+    check(text.find("max(us)") < text.find("test.units_ns") &&
+          msTable != std::string::npos && msTable < msRow &&
+          text.find("56300.0", msRow) != std::string::npos,
+          "Report prints ms histograms in their own table");
+}
+
+int main() {
+    test_buckets();
+    test_summary();
+    test_saturation();
+    test_units();
+    return testExitCode();
+}
@@ -2,9 +2,11 @@
 #include "domain/Environment.h"
 #include "domain/Robot.h"
 #include "application/TaskScheduler.h"
+#include "TestCheck.h"
 #include <cassert>
 #include <iostream>
 #include <filesystem>
+#include <fstream>
 #include <vector>
 
 void test_storage() {
@@ -45,12 +47,9 @@ void test_storage() {
     std::vector<const OSBot::Robot*> const_robots;
     for(auto* r : robots) const_robots.push_back(r);
 
-    if (OSBot::Storage::save_state(filename, env, const_robots, scheduler)) {
-        std::cout << "[PASS] Save successful.\n";
-    } else {
-        std::cerr << "[FAIL] Save failed.\n";
-        exit(1);
-    }
+    bool saved = OSBot::Storage::save_state(filename, env, const_robots, scheduler);
+    check(saved, "Save successful.");
+    if (!saved) exit(1);
 
     // 5. Clear everything
     env.clearAllObstacles();
@@ -60,23 +59,18 @@ void test_storage() {
     scheduler.clear();
 
     // 6. Load
-    if (OSBot::Storage::load_state(filename, env, robots, scheduler)) {
-        std::cout << "[PASS] Load successful.\n";
-    } else {
-        std::cerr << "[FAIL] Load failed.\n";
-        exit(1);
-    }
+    bool loaded = OSBot::Storage::load_state(filename, env, robots, scheduler);
+    check(loaded, "Load successful.");
+    if (!loaded) exit(1);
 
     // 7. Verify
     // Verify Obstacles
-    if (!env.isPositionFree(OSBot::Point(5, 5)) && !env.isPositionFree(OSBot::Point(10, 10))) {
-        std::cout << "[PASS] Obstacles verified.\n";
-    } else {
-        std::cerr << "[FAIL] Obstacles verification failed.\n";
-    }
+    check(!env.isPositionFree(OSBot::Point(5, 5)) && !env.isPositionFree(OSBot::Point(10, 10)) &&
+          env.isPositionFree(OSBot::Point(6, 6)), "Obstacles verified.");
 
     // Verify Robots
-    if (robots.size() == 2) {
+    check(robots.size() == 2, "Robot count verified.");
+    {
         bool r1Found = false, r2Found = false;
         for(auto* r : robots) {
             if (r->getId() == 1) {
@@ -85,30 +79,65 @@ void test_storage() {
                 if(r->getPosition().x == 2 && r->getPosition().y == 2 && r->getBatteryLevel() == 42.0f) r2Found = true;
             }
         }
-        if (r1Found && r2Found) std::cout << "[PASS] Robots verified.\n";
-        else std::cerr << "[FAIL] Robot data mismatch.\n";
-    } else {
-        std::cerr << "[FAIL] Robot count mismatch: " << robots.size() << "\n";
+        check(r1Found && r2Found, "Robots verified.");
     }
 
     // Verify Tasks
-    if (scheduler.getAllTasks().size() == 1) {
-        OSBot::Task t = scheduler.getAllTasks()[0];
-        if (t.getId() == 100 && t.getPriority() == OSBot::TaskPriority::HIGH) {
-            std::cout << "[PASS] Tasks verified.\n";
-        } else {
-            std::cerr << "[FAIL] Task data mismatch.\n";
-        }
-    } else {
-         std::cerr << "[FAIL] Task count mismatch.\n";
-    }
+    auto tasks = scheduler.getAllTasks();
+    check(tasks.size() == 1 && tasks[0].getId() == 100 &&
+          tasks[0].getPriority() == OSBot::TaskPriority::HIGH, "Tasks verified.");
 
     // Cleanup
     for(auto* r : robots) delete r;
     std::remove(filename.c_str());
 }
 
+template <typename T>
+static void writeRaw(std::ofstream &ofs, T value) {
+    ofs.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void test_storage_v1() {
+    std::cout << "Running Storage v1 Compatibility Test...\n";
+
+    // Archivo v1 escrito a mano: obstáculos como lista de puntos
+    std::string filename = "test_save_v1.osbt";
+    {
+        std::ofstream ofs(filename, std::ios::binary);
+        writeRaw<uint32_t>(ofs, OSBot::Storage::MAGIC_NUMBER);
+        writeRaw<uint16_t>(ofs, 1);          // Versión
+        writeRaw<uint64_t>(ofs, 0);          // Timestamp
+        writeRaw<uint16_t>(ofs, 1);          // Robots
+        writeRaw<uint16_t>(ofs, 0);          // Tareas
+        writeRaw<uint16_t>(ofs, 2);          // Obstáculos
+        writeRaw<int32_t>(ofs, 20);          // Ancho
+        writeRaw<int32_t>(ofs, 15);          // Alto
+        writeRaw<int32_t>(ofs, 7); writeRaw<int32_t>(ofs, 3);
+        writeRaw<int32_t>(ofs, 12); writeRaw<int32_t>(ofs, 8);
+        writeRaw<int32_t>(ofs, 9);           // Robot: id
+        writeRaw<int32_t>(ofs, 4); writeRaw<int32_t>(ofs, 4);
+        writeRaw<uint8_t>(ofs, 0);           // Estado
+        writeRaw<float>(ofs, 50.0f);         // Batería
+    }
+
+    OSBot::Environment env(20, 15);
+    env.initialize();
+    std::vector<OSBot::Robot*> robots;
+    OSBot::TaskScheduler scheduler;
+
+    check(OSBot::Storage::load_state(filename, env, robots, scheduler) &&
+          !env.isPositionFree(OSBot::Point(7, 3)) &&
+          !env.isPositionFree(OSBot::Point(12, 8)) &&
+          env.isPositionFree(OSBot::Point(5, 5)) &&
+          robots.size() == 1 && robots[0]->getId() == 9,
+          "v1 file loaded.");
+
+    for(auto* r : robots) delete r;
+    std::remove(filename.c_str());
+}
+
 int main() {
     test_storage();
-    return 0;
+    test_storage_v1();
+    return testExitCode();
 }
@@ -0,0 +1,58 @@
+#include "application/TaskHistory.h"
+#include "application/TaskManager.h"
+#include "domain/Environment.h"
+#include "TestCheck.h"
+#include <iostream>
+#include <vector>
+
+using OSBot::Point;
+
+void test_task_history() {
+    std::cout << "Running TaskHistory tests...\n";
+    using OSBot::TaskRecord;
+    using OSBot::TaskStatus;
+
+    // Anillo de 3: el cuarto archivado descarta el primero
+    OSBot::TaskHistory history(3);
+    for (int id = 1; id <= 4; ++id) {
+        OSBot::Task task(id, {Point(1, 1), Point(2, 2)});
+        task.setStatus(id == 2 ? TaskStatus::FAILED : TaskStatus::COMPLETED);
+        history.record(task);
+    }
+    TaskRecord record;
+    std::vector<TaskRecord> recent;
+    history.recent(10, recent);
+    check(history.size() == 3 && history.totalRecorded() == 4 && !history.find(1, record),
+          "Full ring evicts the oldest record");
+    check(history.find(2, record) && record.status == TaskStatus::FAILED && record.waypointCount == 2,
+          "Archived record is found by id");
+    check(recent.size() == 3 && recent[0].id == 4 && recent[2].id == 2, "Recent is newest first");
+
+    // TaskManager: las tareas terminadas salen del conjunto vivo
+    OSBot::Environment env(20, 20);
+    OSBot::RobotManager robots(env);
+    robots.addRobot(Point(1, 1));
+    OSBot::TaskManager tasks(robots, 2);
+    for (int i = 0; i < 5; ++i) tasks.createTask({Point(10, 10)});
+    tasks.scheduleNextTasks();
+    for (int id = 1; id <= 4; ++id) tasks.cancelTask(id);
+    check(tasks.getAllTasks().size() == 1 && !tasks.getTask(4) && tasks.getTaskRecord(4, record) &&
+          record.status == TaskStatus::CANCELLED, "Cancelled tasks move to the history");
+    check(!tasks.getTaskRecord(1, record) && tasks.getTaskCount(TaskStatus::CANCELLED) == 4,
+          "Counters keep evicted tasks");
+
+    // Tarea en la celda del robot: update() la completa y la archiva, y la
+    // cancelada que seguía en la lista de activas se descarta sin efecto
+    tasks.cancelTask(5);
+    int here = tasks.createTask({Point(1, 1)});
+    tasks.scheduleNextTasks();
+    tasks.update();
+    check(tasks.getActiveTaskCount() == 0 && tasks.getTaskRecord(here, record) &&
+          record.status == TaskStatus::COMPLETED && tasks.getAllTasks().empty(),
+          "Update completes active tasks only");
+}
+
+int main() {
+    test_task_history();
+    return testExitCode();
+}
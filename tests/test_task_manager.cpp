@@ -0,0 +1,184 @@
+#include "application/TaskManager.h"
+#include "domain/Environment.h"
+#include "domain/SimulationClock.h"
+#include "TestCheck.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using OSBot::Point;
+
+// Orden en que un único robot recibe las tareas pendientes (cancelar cada
+// una lo deja libre para la siguiente)
+static std::vector<int> dispatchOrder(OSBot::TaskManager &tasks) {
+    std::vector<int> order;
+    while (tasks.getPendingTaskCount() > 0) {
+        tasks.scheduleNextTasks();
+        auto running = tasks.getTasksByStatus(OSBot::TaskStatus::IN_PROGRESS);
+        if (running.size() != 1) break;
+        order.push_back(running.front()->getId());
+        tasks.cancelTask(running.front()->getId());
+    }
+    return order;
+}
+
+void test_scheduling_policies() {
+    std::cout << "Running SchedulingPolicy tests...\n";
+    using OSBot::SchedulingPolicy;
+    using OSBot::TaskPriority;
+    OSBot::SimulationClock::useVirtualTime(true);
+    OSBot::Environment env(20, 20);
+    OSBot::RobotManager robots(env);
+    robots.addRobot(Point(1, 1));
+    const std::vector<Point> waypoints = {Point(10, 10)};
+
+    {
+        OSBot::TaskManager tasks(robots);
+        tasks.createTask(waypoints, TaskPriority::LOW);
+        tasks.createTask(waypoints, TaskPriority::HIGH);
+        tasks.createTask(waypoints, TaskPriority::HIGH);
+        tasks.createTask(waypoints, TaskPriority::NORMAL);
+        check(dispatchOrder(tasks) == std::vector<int>({2, 3, 4, 1}), "Priority: by level, FIFO within level");
+    }
+    {
+        OSBot::TaskManager tasks(robots);
+        tasks.setSchedulingPolicy(SchedulingPolicy::DEADLINE);
+        tasks.createTask(waypoints, TaskPriority::URGENT);
+        tasks.createTask(waypoints, TaskPriority::LOW, 5000);
+        tasks.createTask(waypoints, TaskPriority::NORMAL, 1000);
+        check(dispatchOrder(tasks) == std::vector<int>({3, 2, 1}), "EDF: earliest deadline first, no deadline last");
+    }
+    {
+        // Un paso de envejecimiento vale un nivel: tras 2.5 pasos la tarea
+        // LOW adelanta a una HIGH nueva, pero no tras 1.5
+        OSBot::TaskManager tasks(robots);
+        tasks.setSchedulingPolicy(SchedulingPolicy::AGING);
+        const auto step = std::chrono::milliseconds(OSBot::TaskManager::AGING_STEP_MS);
+        tasks.createTask(waypoints, TaskPriority::LOW);
+        OSBot::SimulationClock::advance(step + step / 2);
+        tasks.createTask(waypoints, TaskPriority::HIGH);
+        OSBot::SimulationClock::advance(step);
+        tasks.createTask(waypoints, TaskPriority::HIGH);
+        check(dispatchOrder(tasks) == std::vector<int>({2, 1, 3}), "Aging: waiting LOW overtakes newer HIGH");
+    }
+    {
+        // Cola creada con PRIORITY y reordenada al cambiar a FAIR: con pesos
+        // 1:8 la clase LOW recibe 1 de cada 9 asignaciones
+        OSBot::TaskManager tasks(robots);
+        for (int i = 0; i < 16; ++i) tasks.createTask(waypoints, TaskPriority::LOW);
+        for (int i = 0; i < 16; ++i) tasks.createTask(waypoints, TaskPriority::URGENT);
+        tasks.setSchedulingPolicy(SchedulingPolicy::FAIR);
+        auto order = dispatchOrder(tasks);
+        size_t lowInFirst18 = static_cast<size_t>(std::count_if(order.begin(), order.begin() + std::min<size_t>(18, order.size()),
+                                                               [](int id) { return id <= 16; }));
+        check(order.size() == 32 && lowInFirst18 == 2, "Fair: LOW gets its weighted share");
+        check(order.size() == 32 && order[0] == 17 && order[8] == 1, "Fair: FIFO within class");
+    }
+    {
+        // Cambiar de clase una y otra vez no debe adelantar para siempre las
+        // etiquetas de las clases: el orden final es el de no haberla movido
+        OSBot::TaskManager moved(robots);
+        OSBot::TaskManager untouched(robots);
+        for (OSBot::TaskManager* tasks : {&moved, &untouched}) {
+            tasks->setSchedulingPolicy(SchedulingPolicy::FAIR);
+            for (int i = 0; i < 4; ++i) tasks->createTask(waypoints, TaskPriority::LOW);
+            for (int i = 0; i < 2; ++i) tasks->createTask(waypoints, TaskPriority::NORMAL);
+        }
+        for (int i = 0; i < 50; ++i) {
+            moved.setTaskPriority(6, TaskPriority::HIGH);
+            moved.setTaskPriority(6, TaskPriority::NORMAL);
+        }
+        moved.setTaskPriority(6, TaskPriority::NORMAL); // Misma clase: sin efecto
+        // Las NORMAL nuevas deben seguir intercalándose con las LOW
+        for (OSBot::TaskManager* tasks : {&moved, &untouched}) {
+            for (int i = 0; i < 2; ++i) tasks->createTask(waypoints, TaskPriority::NORMAL);
+        }
+        check(dispatchOrder(moved) == dispatchOrder(untouched), "Fair: reprioritising does not drift class tags");
+    }
+    {
+        // Las que nunca arrancan: la cancelación registra su espera y la
+        // más antigua en cola se informa aparte
+        auto& lowWait = OSBot::TaskManager::waitHistogram(TaskPriority::LOW);
+        lowWait.reset();
+        OSBot::TaskManager tasks(robots);
+        tasks.createTask(waypoints, TaskPriority::HIGH);
+        tasks.createTask(waypoints, TaskPriority::LOW);
+        tasks.createTask(waypoints, TaskPriority::LOW);
+        tasks.scheduleNextTasks(); // El único robot se lleva la HIGH
+        OSBot::SimulationClock::advance(std::chrono::seconds(90));
+        int64_t oldest[4];
+        tasks.getOldestPendingWaitMs(oldest);
+        check(oldest[0] == 90000 && oldest[2] == 0, "Oldest queued wait per class");
+        tasks.cancelTask(2);
+        check(lowWait.count() == 1 && lowWait.summary().max == 90000, "Cancelled queued task records its wait in ms");
+        tasks.cancelTask(1);
+    }
+    OSBot::SimulationClock::useVirtualTime(false);
+}
+
+void test_task_stats() {
+    std::cout << "Running TaskStats tests...\n";
+    using OSBot::TaskStatus;
+    OSBot::Environment env(20, 20);
+    OSBot::RobotManager robots(env);
+    for (int i = 0; i < 4; ++i) robots.addRobot(Point(1 + i, 1));
+    OSBot::TaskManager tasks(robots);
+
+    for (int i = 0; i < 10; ++i) tasks.createTask({Point(10, 10)});
+    tasks.scheduleNextTasks(); // 4 en curso, 6 pendientes
+    tasks.cancelTask(1);
+    tasks.cancelTask(9);
+    tasks.getTask(2)->setStatus(TaskStatus::COMPLETED);
+    tasks.getTask(3)->setStatus(TaskStatus::COMPLETED);
+    tasks.getTask(4)->setStatus(TaskStatus::FAILED);
+
+    // Los contadores incrementales deben coincidir con un recorrido completo
+    check(tasks.getActiveTaskCount() == 0 && tasks.getTasksByStatus(TaskStatus::IN_PROGRESS).empty(),
+          "Active count follows transitions");
+    check(tasks.getCompletedTaskCount() == tasks.getTasksByStatus(TaskStatus::COMPLETED).size() &&
+          tasks.getCompletedTaskCount() == 2, "Completed count follows transitions");
+    check(std::fabs(tasks.getSuccessRate() - 200.0 / 3.0) < 1e-9, "Success rate from counters");
+    check(tasks.getPendingTaskCount() == tasks.getTasksByStatus(TaskStatus::PENDING).size(),
+          "Pending count matches queue");
+}
+
+void test_active_tasks() {
+    std::cout << "Running active task tests...\n";
+    using OSBot::TaskRecord;
+    using OSBot::TaskStatus;
+
+    // activeTasks_: canceladas, completadas y huérfanas salen en update()
+    OSBot::Environment wide(20, 20);
+    wide.clearAllObstacles();
+    OSBot::RobotManager fleet(wide);
+    int first = fleet.addRobot(Point(1, 1));
+    fleet.addRobot(Point(3, 1));
+    fleet.addRobot(Point(5, 1));
+    OSBot::TaskManager live(fleet);
+    TaskRecord record;
+    int done = live.createTask({Point(1, 1)});
+    int cancelled = live.createTask({Point(10, 10)});
+    int orphan = live.createTask({Point(10, 10)});
+    live.scheduleNextTasks();
+    int orphanRobot = live.getTask(orphan)->getAssignedRobotId();
+    check(live.getActiveTaskCount() == 3 && live.getTask(done)->getAssignedRobotId() == first &&
+          orphanRobot != -1, "Three tasks in progress");
+    live.cancelTask(cancelled);
+    fleet.removeRobot(orphanRobot);
+    live.update();
+    check(live.getActiveTaskCount() == 0 && live.getAllTasks().empty(),
+          "Cancelled, finished and orphaned tasks leave the active set");
+    check(live.getTaskRecord(done, record) && record.status == TaskStatus::COMPLETED &&
+          live.getTaskRecord(orphan, record) && record.status == TaskStatus::FAILED,
+          "Task whose robot was removed fails instead of staying active");
+    live.update();
+    check(live.getActiveTaskCount() == 0 && live.getTaskCount(TaskStatus::FAILED) == 1,
+          "A second update finds nothing left to do");
+}
+
+int main() {
+    test_scheduling_policies();
+    test_task_stats();
+    test_active_tasks();
+    return testExitCode();
+}
@@ -0,0 +1,71 @@
+#include "infrastructure/JsonReader.h"
+#include "infrastructure/Tracer.h"
+#include "TestCheck.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using OSBot::JsonReader;
+
+void test_trace_export() {
+    std::cout << "Running Tracer export tests...\n";
+
+    // Los spans HTTP se nombran con método + ruta: la ruta puede traer
+    // caracteres de control
+    OSBot::Tracer &tracer = OSBot::Tracer::instance();
+    tracer.clear();
+    auto now = std::chrono::steady_clock::now();
+    tracer.record("GET /a\x01\n\"b\\", "http", now, now + std::chrono::microseconds(5));
+    std::string trace = tracer.toChromeJSON();
+    tracer.clear();
+
+    JsonReader json(trace);
+    bool ok = json.skipValue() && json.finish();
+    check(ok, "Trace with control characters is valid JSON");
+    check(trace.find("GET /a\\u0001\\u000a\\\"b\\\\") != std::string::npos,
+          "Control characters escaped as \\u00XX");
+}
+
+void test_trace_thread_exit() {
+    std::cout << "Running Tracer thread exit tests...\n";
+
+    // Cada robot creado y eliminado es un hilo: su buffer no debe quedarse
+    // en el registro para siempre
+    OSBot::Tracer &tracer = OSBot::Tracer::instance();
+    size_t baseline = tracer.bufferCount();
+    auto recordOnThread = [&](const char *name) {
+        std::thread worker([&]() {
+            auto now = std::chrono::steady_clock::now();
+            tracer.record(name, "robot", now, now + std::chrono::microseconds(1));
+        });
+        worker.join();
+    };
+
+    recordOnThread("exited-span");
+    check(tracer.bufferCount() == baseline + 1, "Exited thread buffer kept");
+    std::string trace = tracer.toChromeJSON();
+    check(trace.find("exited-span") != std::string::npos, "Exited thread events are exported");
+    // Volcar es solo lectura: /api/trace dos veces o SIGUSR1 después no
+    // pierden los eventos
+    check(tracer.bufferCount() == baseline + 1 && tracer.toChromeJSON() == trace,
+          "Export does not consume exited threads");
+
+    for (size_t i = 0; i < 2 * OSBot::Tracer::MAX_EXITED_BUFFERS; ++i)
+        recordOnThread("churn");
+    trace = tracer.toChromeJSON();
+    check(tracer.bufferCount() == baseline + OSBot::Tracer::MAX_EXITED_BUFFERS &&
+          trace.find("exited-span") == std::string::npos,
+          "Exited buffers capped, oldest discarded first");
+
+    std::thread idle([]() {}); // Sin spans no reserva buffer
+    idle.join();
+    tracer.clear();
+    check(tracer.bufferCount() == baseline, "Registry back to live threads");
+}
+
+int main() {
+    test_trace_export();
+    test_trace_thread_exit();
+    return testExitCode();
+}
@@ -0,0 +1,51 @@
+#include "application/RobotManager.h"
+#include "application/WorldSnapshot.h"
+#include "domain/Environment.h"
+#include "TestCheck.h"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+void test_snapshot_version() {
+    std::cout << "Running WorldSnapshot version tests...\n";
+
+    OSBot::Environment env(8, 8);
+    OSBot::RobotManager robots(env);
+    auto first = OSBot::WorldSnapshot::capture(env, robots, 1, false, 100, nullptr);
+    auto idle = OSBot::WorldSnapshot::capture(env, robots, 2, false, 100, first.get());
+
+    // Un tick sin cambios no mueve la versión ni vuelve a serializar el JSON
+    check(idle->getVersion() == first->getVersion() &&
+          &idle->stateJSON() == &first->stateJSON(),
+          "Idle tick keeps the world version");
+
+    // El frame binario sí lleva el tick (u64 en el byte 8 de la cabecera)
+    const std::string &a = first->frame();
+    const std::string &b = idle->frame();
+    check(&a != &b && a.size() == b.size() && a.size() > 16 &&
+          static_cast<uint8_t>(a[8]) == 1 && static_cast<uint8_t>(b[8]) == 2,
+          "Binary frame carries its own tick");
+
+    // Un 'since' de otro arranque nombra otro bitmap: grid completo (byte 6
+    // = 0) aunque la versión coincida; del arranque actual, delta vacío
+    uint64_t epoch = OSBot::WorldSnapshot::bootEpoch();
+    std::string stale, current;
+    idle->writeFrame(stale, epoch + 1, idle->getMapVersion(), nullptr);
+    idle->writeFrame(current, epoch, idle->getMapVersion(), nullptr);
+    uint64_t headerEpoch = 0;
+    std::memcpy(&headerEpoch, b.data() + 56, sizeof(headerEpoch));
+    check(headerEpoch == epoch &&
+          stale[6] == 0 && stale.size() == b.size() && current[6] == 1 &&
+          current.size() < stale.size(),
+          "Delta only within the same boot epoch");
+
+    auto paused = OSBot::WorldSnapshot::capture(env, robots, 3, true, 100, idle.get());
+    check(paused->getVersion() == idle->getVersion() + 1,
+          "Visible change bumps the world version");
+}
+
+int main() {
+    test_snapshot_version();
+    return testExitCode();
+}